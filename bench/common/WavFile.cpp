@@ -0,0 +1,103 @@
+/*
+  WavFile.cpp - minimal RIFF/WAVE reader and writer for the host harnesses
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "WavFile.h"
+
+#define WAVE_FORMAT_PCM         0x0001
+#define WAVE_FORMAT_EXTENSIBLE  0xFFFE
+
+static uint16_t le16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t le32(const uint8_t *p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static void put16(std::vector<uint8_t> &v, uint16_t x) {
+  v.push_back(x & 0xFF);
+  v.push_back(x >> 8);
+}
+
+static void put32(std::vector<uint8_t> &v, uint32_t x) {
+  put16(v, x & 0xFFFF);
+  put16(v, x >> 16);
+}
+
+bool wavRead(const char *path, WavData &wav, std::string &error) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    error = std::string("cannot open ") + path;
+    return false;
+  }
+  std::vector<uint8_t> file;
+  uint8_t buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) file.insert(file.end(), buf, buf + n);
+  fclose(f);
+
+  if (file.size() < 12 || memcmp(file.data(), "RIFF", 4) != 0 || memcmp(file.data() + 8, "WAVE", 4) != 0) {
+    error = "not a RIFF/WAVE file";
+    return false;
+  }
+
+  bool haveFormat = false;
+  uint16_t bits = 0;
+  size_t pos = 12;
+  while (pos + 8 <= file.size()) {
+    const uint8_t *chunk = file.data() + pos;
+    uint32_t size = le32(chunk + 4);
+    size_t body = pos + 8;
+    if (size > file.size() - body) size = (uint32_t)(file.size() - body);     // tolerate truncated files
+
+    if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      uint16_t format = le16(chunk + 8);
+      wav.channels = le16(chunk + 10);
+      wav.sampleRate = le32(chunk + 12);
+      bits = le16(chunk + 22);
+      if (format == WAVE_FORMAT_EXTENSIBLE && size >= 40) format = le16(chunk + 32);
+      if (format != WAVE_FORMAT_PCM || bits != 16 || wav.channels == 0) {
+        error = "only 16 bit integer PCM is supported";
+        return false;
+      }
+      haveFormat = true;
+    } else if (memcmp(chunk, "data", 4) == 0) {
+      if (!haveFormat) {
+        error = "data chunk before fmt chunk";
+        return false;
+      }
+      size_t count = size / 2;
+      count -= count % wav.channels;
+      wav.samples.resize(count);
+      for (size_t i = 0; i < count; i++) wav.samples[i] = (int16_t)le16(file.data() + body + 2 * i);
+      return true;
+    }
+    pos = body + size + (size & 1);
+  }
+  error = "no data chunk";
+  return false;
+}
+
+bool wavWrite(const char *path, const WavData &wav) {
+  uint32_t dataBytes = (uint32_t)(wav.samples.size() * 2);
+  std::vector<uint8_t> out;
+  out.insert(out.end(), {'R', 'I', 'F', 'F'});
+  put32(out, 36 + dataBytes);
+  out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+  put32(out, 16);
+  put16(out, WAVE_FORMAT_PCM);
+  put16(out, wav.channels);
+  put32(out, wav.sampleRate);
+  put32(out, wav.sampleRate * wav.channels * 2);
+  put16(out, wav.channels * 2);
+  put16(out, 16);
+  out.insert(out.end(), {'d', 'a', 't', 'a'});
+  put32(out, dataBytes);
+
+  out.reserve(out.size() + dataBytes);
+  for (int16_t s : wav.samples) put16(out, (uint16_t)s);
+
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+  return (fclose(f) == 0) && ok;
+}
@@ -0,0 +1,26 @@
+/*
+  WavFile.h - minimal RIFF/WAVE reader and writer for the host harnesses
+
+  Reads 16 bit integer PCM (plain or WAVE_FORMAT_EXTENSIBLE), any channel
+  count, and writes the same.  Samples are kept interleaved.
+*/
+
+#ifndef WAVFILE_H_
+#define WAVFILE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct WavData {
+  uint32_t sampleRate = 44100;
+  uint16_t channels = 2;
+  std::vector<int16_t> samples;         // interleaved
+
+  size_t frames() const { return channels ? samples.size() / channels : 0; }
+};
+
+bool wavRead(const char *path, WavData &wav, std::string &error);
+bool wavWrite(const char *path, const WavData &wav);
+
+#endif
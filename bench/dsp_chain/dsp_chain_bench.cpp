@@ -0,0 +1,208 @@
+/*
+  DSP chain harness
+
+  Plays a WAV file into the A2DP sink the way the Bluetooth stack does (one
+  decoded SBC frame per stream-reader call), lets src/AudioPath.cpp queue it
+  and run it through the firmware's processing chain on the I2S writer task,
+  and captures what reaches I2S.  Reports cycles per sample for every stage,
+  for the writer task and for the stream-reader callback, and the output
+  peak, and optionally writes the captured output as a WAV file.  Exits
+  non-zero if any output sample is above the limiter's ceiling.  The host I2S does not block,
+  so the harness only feeds as fast as the ring has room.  Like any stream
+  the capture fades in over its first AUDIO_FADE_MS and out over its last.
+
+  Built with -DAUDIO_OUTPUT_RATE=<Hz> the output is resampled and the WAV is
+  written at that rate; the last few frames still in the resampler's
+  history are not flushed.  With -DAUDIO_OUTPUT_BITS=24 or 32 the WAV
+  keeps the top 16 bits of each I2S word.
+
+  Without an input file (or with "-") a 10 s stereo test signal is used (log
+  sweep on the left, 1 kHz tone on the right).  Mono input is duplicated to
+  both channels since A2DP always delivers stereo.
+
+  eq is a comma separated list of band gains in dB, e.g. 6,0,-3,0,4.
+
+  pio run -e bench_dsp_chain && .pio/build/bench_dsp_chain/program [in.wav [out.wav [volume [eq]]]]
+*/
+
+#include <Arduino.h>
+#include <BluetoothA2DPSink.h>
+#include <AudioPipeline.h>
+#include <AudioPath.h>
+
+#include <chrono>
+#include <math.h>
+
+#include "../common/WavFile.h"
+
+#define SBC_FRAME_BYTES     (AUDIO_BLOCK_FRAMES * 2 * sizeof(int16_t))
+
+static std::vector<int16_t> captured;
+
+static WavData testSignal(uint32_t rate, float seconds) {
+  WavData wav;
+  wav.sampleRate = rate;
+  wav.channels = 2;
+  size_t frames = (size_t)(rate * seconds);
+  wav.samples.resize(frames * 2);
+  const double f0 = 20.0, f1 = 20000.0, k = log(f1 / f0);
+  for (size_t i = 0; i < frames; i++) {
+    double t = (double)i / rate;
+    double sweepPhase = 2.0 * M_PI * f0 * seconds / k * (exp(k * t / seconds) - 1.0);
+    wav.samples[2 * i] = (int16_t)lrint(0.5 * 32767.0 * sin(sweepPhase));
+    wav.samples[2 * i + 1] = (int16_t)lrint(0.5 * 32767.0 * sin(2.0 * M_PI * 1000.0 * t));
+  }
+  return wav;
+}
+
+// the cycle counter is the TSC on the host; time it against the monotonic clock
+static double cycleNs() {
+  auto t0 = std::chrono::steady_clock::now();
+  uint32_t c0 = ESP.getCycleCount();
+  delay(50);
+  uint32_t c1 = ESP.getCycleCount();
+  auto t1 = std::chrono::steady_clock::now();
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / (uint32_t)(c1 - c0);
+}
+
+int main(int argc, char **argv) {
+  const char *inPath = (argc > 1 && strcmp(argv[1], "-") != 0) ? argv[1] : NULL;
+  const char *outPath = argc > 2 ? argv[2] : NULL;
+  uint8_t volume = argc > 3 ? (uint8_t)atoi(argv[3]) : 100;
+  const char *eqGains = argc > 4 ? argv[4] : "";
+
+  WavData in;
+  if (inPath) {
+    std::string error;
+    if (!wavRead(inPath, in, error)) {
+      fprintf(stderr, "%s: %s\n", inPath, error.c_str());
+      return 1;
+    }
+  } else {
+    in = testSignal(44100, 10.0f);
+  }
+  if (in.channels > 2) {
+    fprintf(stderr, "%u channels: only mono and stereo files can be streamed over A2DP\n", in.channels);
+    return 1;
+  }
+
+  // a2dp hands the reader interleaved 16 bit stereo
+  std::vector<int16_t> stream(in.frames() * 2);
+  for (size_t i = 0; i < in.frames(); i++) {
+    stream[2 * i] = in.samples[i * in.channels];
+    stream[2 * i + 1] = in.samples[i * in.channels + in.channels - 1];
+  }
+
+  BluetoothA2DPSink sink;
+  i2s_pin_config_t pins = { I2S_PIN_NO_CHANGE, 4, 15, 2, I2S_PIN_NO_CHANGE };
+  sink.set_pin_config(pins);
+  audioPathBegin(sink, pins);
+  sink.start("ESP-Music");
+  sink.set_volume(volume);
+  audioPathSetVolume(volume);
+  for (uint8_t i = 0; i < EQ_MAX_BANDS && *eqGains; i++) {
+    EqBand band = audioPathEqualizer().band(i);
+    band.gainDb = strtof(eqGains, (char **)&eqGains);
+    audioPathEqualizer().setBand(i, band);
+    if (*eqGains == ',') eqGains++;
+  }
+
+  // what should reach I2S: every input frame, or its resampled equivalent
+  const uint32_t outRate = AUDIO_OUTPUT_RATE ? AUDIO_OUTPUT_RATE : in.sampleRate;
+  const size_t expected = (size_t)((uint64_t)in.frames() * outRate / in.sampleRate) * 2;
+  const size_t needed = outRate != in.sampleRate ? expected - RESAMPLER_MAX_TAPS * 2 : expected;
+  captured.reserve(expected + RESAMPLER_MAX_OUT * 2);
+  i2s_native_set_realtime(false);
+  i2s_native_set_observer([](i2s_port_t port, const uint8_t *data, size_t len) {
+    (void)port;
+    if (AUDIO_OUTPUT_BITS == 16) {
+      const int16_t *s = (const int16_t *)data;
+      captured.insert(captured.end(), s, s + len / 2);
+    } else {
+      const int32_t *s = (const int32_t *)data;
+      for (size_t i = 0; i < len / 4; i++) captured.push_back((int16_t)(s[i] >> 16));
+    }
+  });
+  sink.native_connect((uint16_t)in.sampleRate);
+  audioPathResetStats();
+
+  const uint8_t *bytes = (const uint8_t *)stream.data();
+  size_t total = stream.size() * sizeof(int16_t);
+  uint64_t callbackCycles = 0;
+  for (size_t off = 0; off < total; off += SBC_FRAME_BYTES) {
+    uint32_t len = (uint32_t)(total - off < SBC_FRAME_BYTES ? total - off : SBC_FRAME_BYTES);
+    AudioPathStats now;
+    while (now = audioPathStats(), now.ring.capacity - now.ring.fill < len / 4) yield();
+    audioPathUpdate();              // what loop() does on the board
+    uint32_t c0 = ESP.getCycleCount();
+    sink.native_write_data(bytes + off, len);
+    callbackCycles += (uint32_t)(ESP.getCycleCount() - c0);
+  }
+  sink.native_disconnect();         // the writer plays out what is left in the ring
+  for (uint32_t waited = 0; captured.size() < needed && waited < 5000; waited++) delay(1);
+
+  const AudioPipeline &pipeline = audioPathPipeline();
+  const AudioPipelineStats &stats = pipeline.stats();
+  AudioPathStats path = audioPathStats();
+  double samples = (double)stats.frames * 2;
+  double nsPerCycle = cycleNs();
+  double busyNs = (double)(path.writerCycles + callbackCycles) * nsPerCycle;
+
+  printf("%s: %zu frames at %u Hz, volume %u%s%s\n", inPath ? inPath : "test signal", in.frames(), in.sampleRate, volume,
+         argc > 4 ? ", eq " : "", argc > 4 ? argv[4] : "");
+  printf("%-16s %14s %10s\n", "stage", "cycles/sample", "ns/sample");
+  for (uint8_t i = 0; i < pipeline.stages(); i++) {
+    AudioStage *s = pipeline.stage(i);
+    double cycles = samples ? stats.stageCycles[i] / samples : 0;
+    printf("%-16s %14.2f %10.3f%s\n", s->name(), cycles, cycles * nsPerCycle, s->bypassed() ? "  (bypassed)" : "");
+  }
+  // the output chain runs at the I2S rate; its cycles are per sample in, like the rest
+  const AudioPipeline &outputChain = audioPathOutputChain();
+  for (uint8_t i = 0; i < outputChain.stages(); i++) {
+    AudioStage *s = outputChain.stage(i);
+    double cycles = samples ? outputChain.stats().stageCycles[i] / samples : 0;
+    printf("%-16s %14.2f %10.3f%s\n", s->name(), cycles, cycles * nsPerCycle, s->bypassed() ? "  (bypassed)" : "");
+  }
+  double cycles = samples ? path.writerCycles / samples : 0;
+  printf("%-16s %14.2f %10.3f\n", "i2s writer", cycles, cycles * nsPerCycle);
+  cycles = samples ? callbackCycles / samples : 0;
+  printf("%-16s %14.2f %10.3f\n", "stream reader", cycles, cycles * nsPerCycle);
+  printf("ring %u frames, peak %u, %u overruns\n", path.ring.capacity, path.ring.highWater, path.ring.overruns);
+  printf("%.1fx real time\n", busyNs ? (double)in.frames() / in.sampleRate * 1e9 / busyNs : 0.0);
+
+  // the last block is padded to a whole block with silence
+  if (captured.size() < needed || path.ring.overruns) {
+    fprintf(stderr, "I2S received %zu samples, expected %zu\n", captured.size(), expected);
+    return 1;
+  }
+  if (captured.size() > expected) captured.resize(expected);
+
+  // every sample went through the limiter at the I2S rate: none may be above its ceiling, give or take
+  // the LSB the dither adds
+  const int32_t limit = ((audioPathLimiter().ceilingSample() + (1 << (AUDIO_SAMPLE_SHIFT - 1))) >> AUDIO_SAMPLE_SHIFT) + 1;
+  int32_t peak = 0;
+  size_t over = 0;
+  for (int16_t s : captured) {
+    const int32_t a = s < 0 ? -(int32_t)s : s;
+    if (a > peak) peak = a;
+    if (a > limit) over++;
+  }
+  printf("output peak %.2f dBFS, limiter ceiling %.2f dBFS\n", peak ? 20.0 * log10(peak / 32768.0) : -999.0,
+         audioPathLimiter().ceiling());
+  if (over) {
+    fprintf(stderr, "%zu samples above the limiter ceiling\n", over);
+    return 1;
+  }
+
+  if (outPath) {
+    WavData out;
+    out.sampleRate = outRate;
+    out.channels = 2;
+    out.samples.swap(captured);
+    if (!wavWrite(outPath, out)) {
+      fprintf(stderr, "cannot write %s\n", outPath);
+      return 1;
+    }
+  }
+  return 0;
+}
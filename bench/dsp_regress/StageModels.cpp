@@ -0,0 +1,646 @@
+/*
+  StageModels.cpp - the stages bench/dsp_regress can put in a chain
+*/
+
+#include <Convolver.h>
+#include <GainStage.h>
+#include <Limiter.h>
+#include <Loudness.h>
+#include <LoudnessMeter.h>
+#include <MixMatrix.h>
+#include <OutputFormat.h>
+#include <ParametricEQ.h>
+#include <PcmMonitor.h>
+#include <SpectrumAnalyzer.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StageModels.h"
+
+// ----------------------------------------------------------------
+//                      -reference building blocks
+// ----------------------------------------------------------------
+
+struct Biquad {
+  double b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+  double s1[AUDIO_MAX_CHANNELS] = {}, s2[AUDIO_MAX_CHANNELS] = {};
+
+  void clear() {
+    memset(s1, 0, sizeof(s1));
+    memset(s2, 0, sizeof(s2));
+  }
+  // transposed direct form II, like the fixed point ones
+  void process(double *x, size_t frames, uint8_t channels) {
+    for (size_t i = 0; i < frames; i++) {
+      for (uint8_t c = 0; c < channels; c++) {
+        const double in = x[i * channels + c], out = b0 * in + s1[c];
+        s1[c] = b1 * in - a1 * out + s2[c];
+        s2[c] = b2 * in - a2 * out;
+        x[i * channels + c] = out;
+      }
+    }
+  }
+};
+
+// RBJ cookbook, as ParametricEQ::design() and tools/loudness_table.py have it
+static Biquad rbj(EqBandType type, double freq, double gainDb, double q, uint32_t rate) {
+  Biquad f;
+  if (freq < 10.0) freq = 10.0;
+  if (freq > 0.45 * rate) freq = 0.45 * rate;
+  const double w0 = 2.0 * M_PI * freq / rate, cw = cos(w0), alpha = sin(w0) / (2.0 * q);
+  const double A = pow(10.0, gainDb / 40.0), sqA2a = 2.0 * sqrt(A) * alpha;
+  double b0, b1, b2, a0, a1, a2;
+  switch (type) {
+    case EQ_LOW_SHELF:
+      b0 = A * ((A + 1) - (A - 1) * cw + sqA2a);
+      b1 = 2 * A * ((A - 1) - (A + 1) * cw);
+      b2 = A * ((A + 1) - (A - 1) * cw - sqA2a);
+      a0 = (A + 1) + (A - 1) * cw + sqA2a;
+      a1 = -2 * ((A - 1) + (A + 1) * cw);
+      a2 = (A + 1) + (A - 1) * cw - sqA2a;
+      break;
+    case EQ_HIGH_SHELF:
+      b0 = A * ((A + 1) + (A - 1) * cw + sqA2a);
+      b1 = -2 * A * ((A - 1) + (A + 1) * cw);
+      b2 = A * ((A + 1) + (A - 1) * cw - sqA2a);
+      a0 = (A + 1) - (A - 1) * cw + sqA2a;
+      a1 = 2 * ((A - 1) - (A + 1) * cw);
+      a2 = (A + 1) - (A - 1) * cw - sqA2a;
+      break;
+    case EQ_LOW_PASS:
+      b0 = b2 = (1 - cw) / 2;
+      b1 = 1 - cw;
+      a0 = 1 + alpha;
+      a1 = -2 * cw;
+      a2 = 1 - alpha;
+      break;
+    case EQ_HIGH_PASS:
+      b0 = b2 = (1 + cw) / 2;
+      b1 = -(1 + cw);
+      a0 = 1 + alpha;
+      a1 = -2 * cw;
+      a2 = 1 - alpha;
+      break;
+    case EQ_PEAK:
+    default:
+      b0 = 1 + alpha * A;
+      b1 = -2 * cw;
+      b2 = 1 - alpha * A;
+      a0 = 1 + alpha / A;
+      a1 = -2 * cw;
+      a2 = 1 - alpha / A;
+      break;
+  }
+  f.b0 = b0 / a0;
+  f.b1 = b1 / a0;
+  f.b2 = b2 / a0;
+  f.a1 = a1 / a0;
+  f.a2 = a2 / a0;
+  return f;
+}
+
+class IdentityReference : public Reference {
+  public:
+    void begin(uint32_t sampleRate) override { (void)sampleRate; }
+    void process(double *samples, size_t frames, uint8_t channels) override {
+      (void)samples;
+      (void)frames;
+      (void)channels;
+    }
+};
+
+class GainReference : public Reference {
+  public:
+    explicit GainReference(double gain) : _gain(gain) {}
+    void begin(uint32_t sampleRate) override { (void)sampleRate; }
+    void process(double *samples, size_t frames, uint8_t channels) override {
+      for (size_t i = 0; i < frames * channels; i++) samples[i] *= _gain;
+    }
+  private:
+    double _gain;
+};
+
+class BiquadReference : public Reference {
+  public:
+    typedef std::vector<Biquad> (*Design)(const std::vector<double> &args, uint32_t rate);
+    BiquadReference(Design design, const std::vector<double> &args) : _design(design), _args(args) {}
+    void begin(uint32_t sampleRate) override { _filters = _design(_args, sampleRate); }
+    void process(double *samples, size_t frames, uint8_t channels) override {
+      for (Biquad &f : _filters) f.process(samples, frames, channels);
+    }
+  private:
+    Design _design;
+    std::vector<double> _args;
+    std::vector<Biquad> _filters;
+};
+
+
+// ----------------------------------------------------------------
+//                          -models
+// ----------------------------------------------------------------
+
+// the bands audioPathBegin() sets up
+static const EqBand defaultBands[EQ_MAX_BANDS] = {
+  { EQ_LOW_SHELF, true, 100.0f, 0.0f, 0.707f },
+  { EQ_PEAK, true, 400.0f, 0.0f, 1.0f },
+  { EQ_PEAK, true, 1000.0f, 0.0f, 1.0f },
+  { EQ_PEAK, true, 3000.0f, 0.0f, 1.0f },
+  { EQ_HIGH_SHELF, true, 8000.0f, 0.0f, 0.707f },
+};
+
+static EqBand eqBand(const std::vector<double> &args, uint8_t i) {
+  EqBand band = defaultBands[i];
+  if (i < args.size()) band.gainDb = (float)args[i];
+  if (band.gainDb < EQ_GAIN_MIN_DB) band.gainDb = EQ_GAIN_MIN_DB;
+  if (band.gainDb > EQ_GAIN_MAX_DB) band.gainDb = EQ_GAIN_MAX_DB;
+  return band;
+}
+
+static std::vector<Biquad> eqDesign(const std::vector<double> &args, uint32_t rate) {
+  std::vector<Biquad> filters;
+  for (uint8_t i = 0; i < EQ_MAX_BANDS; i++) {
+    EqBand band = eqBand(args, i);
+    filters.push_back(rbj(band.type, band.freq, band.gainDb, band.q, rate));
+  }
+  return filters;
+}
+
+static bool makeEq(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if (args.size() > EQ_MAX_BANDS) {
+    error = "at most 5 band gains";
+    return false;
+  }
+  ParametricEQ *eq = new ParametricEQ();
+  for (uint8_t i = 0; i < EQ_MAX_BANDS; i++) eq->setBand(i, eqBand(args, i));
+  out.stage.reset(eq);
+  out.reference.reset(new BiquadReference(eqDesign, args));
+  out.prepare = [](AudioStage *stage) { static_cast<ParametricEQ *>(stage)->update(); };
+  return true;
+}
+
+static bool makeGain(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if (args.size() != 1 || args[0] > 24.0) {
+    error = "one gain in dB, at most +24";
+    return false;
+  }
+  const double gain = pow(10.0, args[0] / 20.0);
+  out.stage.reset(new GainStage("gain", (int32_t)lrint(GAIN_UNITY * gain)));
+  out.reference.reset(new GainReference(gain));
+  return true;
+}
+
+// the a2dp volume law of audioPathSetVolume(): 0 mutes, 1..127 in equal dB steps over 60 dB
+static double volumeDb(int volume) {
+  return -60.0 * (127 - volume) / 126.0;
+}
+
+static bool volumeArg(const std::vector<double> &args, std::string &error) {
+  if (args.empty() || args[0] < 0 || args[0] > 127) {
+    error = "one a2dp volume, 0..127";
+    return false;
+  }
+  return true;
+}
+
+static bool makeVolume(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if (!volumeArg(args, error)) return false;
+  if (args.size() > 1) {
+    error = "one a2dp volume, 0..127";
+    return false;
+  }
+  const int volume = (int)args[0];
+  const double gain = volume ? pow(10.0, volumeDb(volume) / 20.0) : 0.0;
+  out.stage.reset(new GainStage("volume", (int32_t)lrint(GAIN_UNITY * gain)));
+  out.reference.reset(new GainReference(gain));
+  return true;
+}
+
+// the boost tools/loudness_table.py puts in the table, designed here afresh; flat where the stage passes through
+static std::vector<Biquad> loudnessDesign(const std::vector<double> &args, uint32_t rate) {
+  const int volume = (int)args[0];
+  if (volume == 0 || volume == 127 || (rate != 44100 && rate != 48000)) return std::vector<Biquad>();
+  const double attenuation = -volumeDb(volume);
+  return { rbj(EQ_LOW_SHELF, 120.0, fmin(0.35 * attenuation, 15.0), 0.707, rate),
+           rbj(EQ_HIGH_SHELF, 8000.0, fmin(0.1 * attenuation, 5.0), 0.707, rate) };
+}
+
+// switched off from the menu once ms have gone through, which takes effect at the next block
+class SwitchedLoudness : public Loudness {
+  public:
+    explicit SwitchedLoudness(double ms) : _ms(ms), _off(0), _frames(0) {}
+    void begin(uint32_t sampleRate, uint8_t channels) override {
+      _off = (size_t)(_ms * sampleRate / 1000.0);
+      Loudness::begin(sampleRate, channels);
+    }
+    void reset() override {
+      Loudness::reset();
+      _frames = 0;
+    }
+    void process(AudioBlock &block) override {
+      if (_frames >= _off) setEnabled(false);
+      _frames += block.frames;
+      Loudness::process(block);
+    }
+  private:
+    double _ms;
+    size_t _off, _frames;
+};
+
+// the shelves up to the block the stage is switched off in, then over that block the linear cross-fade of
+// audioBlockCrossfade() to the dry signal, dry after it; a stage that has not run yet has nothing to fade from
+class SwitchedReference : public Reference {
+  public:
+    SwitchedReference(Reference *filter, double ms) : _filter(filter), _ms(ms), _off(0), _done(0) {}
+    void begin(uint32_t sampleRate) override {
+      _filter->begin(sampleRate);
+      _off = (size_t)(_ms * sampleRate / 1000.0);
+      _done = 0;
+    }
+    void process(double *x, size_t frames, uint8_t channels) override {
+      const std::vector<double> dry(x, x + frames * channels);
+      _filter->process(x, frames, channels);
+      const size_t start = (_off + AUDIO_BLOCK_FRAMES - 1) / AUDIO_BLOCK_FRAMES * AUDIO_BLOCK_FRAMES;
+      for (size_t i = 0; i < frames; i++) {
+        const size_t at = _done + i;
+        if (at < start) continue;
+        const size_t fade = start ? AUDIO_BLOCK_FRAMES : 0;
+        const double w = at - start < fade ? (double)(at - start + 1) / (fade + 1) : 1.0;
+        for (uint8_t c = 0; c < channels; c++) {
+          double &y = x[i * channels + c];
+          y += (dry[i * channels + c] - y) * w;
+        }
+      }
+      _done += frames;
+    }
+  private:
+    std::unique_ptr<Reference> _filter;
+    double _ms;
+    size_t _off, _done;
+};
+
+static bool makeLoudness(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if (!volumeArg(args, error)) return false;
+  if (args.size() > 2 || (args.size() > 1 && args[1] < 0)) {
+    error = "a2dp volume 0..127, ms until it is switched off";
+    return false;
+  }
+  const std::vector<double> volume(1, args[0]);
+  if (args.size() == 1) {
+    Loudness *loudness = new Loudness();
+    loudness->setVolume((uint8_t)args[0]);
+    loudness->setEnabled(true);
+    out.stage.reset(loudness);
+    out.reference.reset(new BiquadReference(loudnessDesign, volume));
+    return true;
+  }
+
+  Loudness *loudness = new SwitchedLoudness(args[1]);
+  loudness->setVolume((uint8_t)args[0]);
+  out.stage.reset(loudness);
+  out.reference.reset(new SwitchedReference(new BiquadReference(loudnessDesign, volume), args[1]));
+  out.prepare = [](AudioStage *stage) { static_cast<Loudness *>(stage)->setEnabled(true); };    // on again for each signal
+  return true;
+}
+
+// the presets as MixMatrix::setPreset() has them, and for MIX_CUSTOM a matrix no preset is
+static void mixGains(MixPreset preset, float g[4]) {
+  const float cross = powf(10.0f, MIX_CROSSFEED_DB / 20.0f) / (1.0f + powf(10.0f, MIX_CROSSFEED_DB / 20.0f));
+  const float gains[MIX_CUSTOM + 1][4] = {
+    { 1.0f, 0.0f, 0.0f, 1.0f },
+    { 0.5f, 0.5f, 0.5f, 0.5f },
+    { 0.0f, 1.0f, 1.0f, 0.0f },
+    { 1.0f - cross, cross, cross, 1.0f - cross },
+    { 0.8f, -0.3f, 0.45f, 1.1f },
+  };
+  memcpy(g, gains[preset], sizeof(gains[preset]));
+}
+
+// generic: every matrix through MixMatrix::generic, the presets as the custom matrices they are
+static void setMix(MixMatrix &mix, MixPreset preset, bool generic) {
+  if (preset < MIX_CUSTOM && !generic) {
+    mix.setPreset(preset);
+    return;
+  }
+  float g[4];
+  mixGains(preset, g);
+  mix.setMatrix(2, 2, g, generic);
+}
+
+// from one matrix to another once ms have gone through, which takes effect at the next block
+class SwitchedMix : public MixMatrix {
+  public:
+    SwitchedMix(MixPreset from, MixPreset to, double ms, bool generic)
+      : _from(from), _to(to), _ms(ms), _generic(generic), _off(0), _frames(0), _switched(false) {}
+    void begin(uint32_t sampleRate, uint8_t channels) override {
+      _off = _ms < 0 ? SIZE_MAX : (size_t)(_ms * sampleRate / 1000.0);
+      MixMatrix::begin(sampleRate, channels);
+    }
+    void reset() override {
+      MixMatrix::reset();
+      _frames = 0;
+      _switched = false;
+    }
+    void restart() { setMix(*this, _from, _generic); }
+    void process(AudioBlock &block) override {
+      if (_frames >= _off && !_switched) {
+        setMix(*this, _to, _generic);
+        _switched = true;
+      }
+      _frames += block.frames;
+      MixMatrix::process(block);
+    }
+  private:
+    MixPreset _from, _to;
+    double _ms;
+    bool _generic;
+    size_t _off, _frames;
+    bool _switched;
+};
+
+// what is under test is the choice of kernel, so the reference is the same stage with MixMatrix::generic for
+// every matrix, block by block on the signal in Q8.23; it must match to the bit, cross-fades included
+class MixReference : public Reference {
+  public:
+    MixReference(MixPreset from, MixPreset to, double ms) : _mix(from, to, ms, true), _rate(0), _started(false) {}
+    void begin(uint32_t sampleRate) override {
+      _rate = sampleRate;
+      _started = false;
+    }
+    void process(double *x, size_t frames, uint8_t channels) override {
+      if (!_started) {
+        _mix.begin(_rate, channels);
+        _mix.restart();
+        _started = true;
+      }
+      for (size_t done = 0; done < frames; done += AUDIO_BLOCK_FRAMES) {
+        const size_t n = (frames - done < AUDIO_BLOCK_FRAMES ? frames - done : AUDIO_BLOCK_FRAMES) * channels;
+        double *p = x + done * channels;
+        _block.frames = (uint16_t)(n / channels);
+        _block.channels = channels;
+        for (size_t i = 0; i < n; i++) _block.samples[i] = (int32_t)lrint(p[i] * AUDIO_FULL_SCALE);
+        _mix.process(_block);
+        for (size_t i = 0; i < n; i++) p[i] = (double)_block.samples[i] / AUDIO_FULL_SCALE;
+      }
+    }
+  private:
+    SwitchedMix _mix;
+    uint32_t _rate;
+    bool _started;
+    AudioBlock _block;
+};
+
+static bool makeMix(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if ((args.size() != 1 && args.size() != 3) || args[0] < 0 || args[0] > MIX_CUSTOM ||
+      (args.size() == 3 && (args[1] < 0 || args[1] > MIX_CUSTOM || args[2] < 0))) {
+    error = "matrix (0 stereo, 1 mono, 2 swap, 3 crossfeed, 4 custom), then the one it switches to and after how many ms";
+    return false;
+  }
+  const MixPreset from = (MixPreset)args[0], to = args.size() == 3 ? (MixPreset)args[1] : from;
+  const double ms = args.size() == 3 ? args[2] : -1.0;
+  out.stage.reset(new SwitchedMix(from, to, ms, false));
+  out.reference.reset(new MixReference(from, to, ms));
+  out.prepare = [](AudioStage *stage) { static_cast<SwitchedMix *>(stage)->restart(); };    // back to the first matrix
+  return true;
+}
+// the Limiter algorithm in dB and doubles: running minimum, one-pole release and moving average attack over
+// the look-ahead window, the input delayed by the window less one frame
+class LimiterReference : public Reference {
+  public:
+    LimiterReference(double threshold, double ratio, double knee, double ceiling, double release)
+      : _threshold(threshold), _slope(1.0 / ratio - 1.0), _knee(knee), _ceiling(ceiling), _releaseMs(release) {}
+
+    void begin(uint32_t sampleRate) override {
+      _release = 1.0 - exp(-1000.0 / (_releaseMs * sampleRate));
+      _gains.assign(LIMITER_LOOKAHEAD, 0.0);
+      _released.assign(LIMITER_LOOKAHEAD, 0.0);
+      _delay.assign(LIMITER_LOOKAHEAD * AUDIO_MAX_CHANNELS, 0.0);
+      _last = 0.0;
+      _pos = 0;
+    }
+
+    void process(double *x, size_t frames, uint8_t channels) override {
+      const double limit = floor(AUDIO_FULL_SCALE * pow(10.0, _ceiling / 20.0)) / AUDIO_FULL_SCALE;
+      for (size_t i = 0; i < frames; i++, x += channels) {
+        double peak = 0.0;
+        for (uint8_t c = 0; c < channels; c++) peak = fmax(peak, fabs(x[c]));
+        const double level = peak > 0.0 ? 20.0 * log10(peak) : -400.0;
+        double gain = fmin(kneeGain(level, _threshold, _slope), kneeGain(level, _ceiling, -1.0));
+        gain = fmin(fmin(gain, _ceiling - level), 0.0);
+
+        _gains[_pos] = gain;
+        double target = 0.0;
+        for (double g : _gains) target = fmin(target, g);
+        _last = target < _last ? target : _last + (target - _last) * _release;
+        _released[_pos] = _last;
+        double average = 0.0;
+        for (double g : _released) average += g;
+        const double linear = pow(10.0, average / LIMITER_LOOKAHEAD / 20.0);
+
+        double *slot = &_delay[_pos * channels];
+        const double *oldest = &_delay[((_pos + 1) % LIMITER_LOOKAHEAD) * channels];
+        for (uint8_t c = 0; c < channels; c++) slot[c] = x[c];
+        for (uint8_t c = 0; c < channels; c++) x[c] = fmax(-limit, fmin(limit, oldest[c] * linear));
+        _pos = (_pos + 1) % LIMITER_LOOKAHEAD;
+      }
+    }
+
+  private:
+    double kneeGain(double level, double threshold, double slope) const {
+      const double over = level - threshold, half = _knee / 2.0;
+      if (over <= -half) return 0.0;
+      if (over >= half) return slope * over;
+      return slope * (over + half) * (over + half) / (2.0 * _knee);
+    }
+
+    double _threshold, _slope, _knee, _ceiling, _releaseMs, _release;
+    std::vector<double> _gains, _released, _delay;
+    double _last;
+    size_t _pos;
+};
+
+static bool makeLimiter(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if (args.size() > 5) {
+    error = "threshold, ratio, knee, ceiling, release";
+    return false;
+  }
+  Limiter *limiter = new Limiter();
+  if (args.size() > 0) limiter->setThreshold((float)args[0]);
+  if (args.size() > 1) limiter->setRatio((float)args[1]);
+  if (args.size() > 2) limiter->setKnee((float)args[2]);
+  if (args.size() > 3) limiter->setCeiling((float)args[3]);
+  if (args.size() > 4) limiter->setRelease((float)args[4]);
+  out.stage.reset(limiter);
+  // the setters clamp; the reference takes what the stage ended up with
+  out.reference.reset(new LimiterReference(limiter->threshold(), limiter->ratio(), limiter->knee(), limiter->ceiling(),
+                                           limiter->release()));
+  return true;
+}
+
+// OutputFormat is not a stage: pack the block the way the writer does and unpack it again to see what I2S gets
+class OutputStage : public AudioStage {
+  public:
+    OutputStage(uint8_t bits, OutputDither dither) {
+      _format.setBits(bits);
+      _format.setDither(dither);
+    }
+    const char *name() const override { return "output"; }
+    void reset() override { _format.reset(); }
+    void process(AudioBlock &block) override {
+      const size_t count = (size_t)block.frames * block.channels;
+      _format.pack(block.samples, block.frames, block.channels, _packed);
+      if (_format.bits() == 16) {
+        const int16_t *s = (const int16_t *)_packed;
+        for (size_t i = 0; i < count; i++) block.samples[i] = (int32_t)s[i] << AUDIO_SAMPLE_SHIFT;
+      } else {
+        for (size_t i = 0; i < count; i++) block.samples[i] = _packed[i] >> 8;
+      }
+    }
+  private:
+    OutputFormat _format;
+    int32_t _packed[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];
+};
+
+static bool makeOutput(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  const int bits = args.empty() ? 16 : (int)args[0];
+  const int dither = args.size() > 1 ? (int)args[1] : OUTPUT_DITHER_TPDF;
+  if (args.size() > 2 || (bits != 16 && bits != 24 && bits != 32) || dither < 0 || dither > OUTPUT_DITHER_SHAPED) {
+    error = "bits (16, 24, 32), dither (0 none, 1 tpdf, 2 shaped)";
+    return false;
+  }
+  out.stage.reset(new OutputStage((uint8_t)bits, (OutputDither)dither));
+  out.reference.reset(new IdentityReference());
+  return true;
+}
+
+// direct form convolution, delayed by the block the worker takes
+class FirReference : public Reference {
+  public:
+    explicit FirReference(const std::vector<std::vector<float>> &ir) : _ir(ir) {}
+    void begin(uint32_t sampleRate) override {
+      (void)sampleRate;
+      _input.clear();
+    }
+    void process(double *x, size_t frames, uint8_t channels) override {
+      const size_t taps = _ir[0].size(), base = _input.size() / channels;
+      _input.insert(_input.end(), x, x + frames * channels);
+      for (size_t i = 0; i < frames; i++) {
+        const long now = (long)(base + i) - CONVOLVER_PARTITION;
+        for (uint8_t c = 0; c < channels; c++) {
+          const std::vector<float> &h = _ir[_ir.size() == 1 ? 0 : c];
+          double sum = 0.0;
+          for (size_t t = 0; t < taps && (long)t <= now; t++) sum += h[t] * _input[(now - t) * channels + c];
+          x[i * channels + c] = sum;
+        }
+      }
+    }
+  private:
+    std::vector<std::vector<float>> _ir;
+    std::vector<double> _input;
+};
+
+// a made-up room: the direct sound, then reflections as noise decaying by 60 dB over the response
+static bool makeRoom(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  const size_t taps = args.empty() ? 2048 : (size_t)args[0];
+  const int channels = args.size() > 1 ? (int)args[1] : 1;
+  if (args.size() > 2 || taps < 1 || taps > CONVOLVER_MAX_TAPS || channels < 1 || channels > 2) {
+    error = "taps (up to 4096), impulse responses (1 or 2)";
+    return false;
+  }
+  std::vector<std::vector<float>> ir(channels, std::vector<float>(taps));
+  uint32_t seed = 1;
+  for (int c = 0; c < channels; c++) {
+    for (size_t t = 0; t < taps; t++) {
+      seed = seed * 1664525u + 1013904223u;
+      const double noise = ((seed >> 8) / 8388608.0 - 1.0) * 0.2;
+      ir[c][t] = (float)(t == 0 ? 0.7 : noise * pow(10.0, -3.0 * t / taps));
+    }
+  }
+  const float *rows[2] = { ir[0].data(), ir[channels - 1].data() };
+  Convolver *convolver = new Convolver();
+  convolver->startWorker(0, 1, 4096);
+  convolver->setFilter(rows, (uint8_t)channels, taps, 44100);
+  out.stage.reset(convolver);
+  out.reference.reset(new FirReference(ir));
+  return true;
+}
+
+// taps: the audio passes untouched, only their cost is of interest
+static bool makeSpectrum(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  (void)error;
+  (void)args;
+  out.stage.reset(new SpectrumAnalyzer());
+  out.stage->setBypass(false);
+  out.reference.reset(new IdentityReference());
+  return true;
+}
+
+static bool makeMeter(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  (void)error;
+  (void)args;
+  out.stage.reset(new LoudnessMeter());
+  out.reference.reset(new IdentityReference());
+  return true;
+}
+
+static bool makeMonitor(const std::vector<double> &args, StageUnderTest &out, std::string &error) {
+  if (args.size() > 2) {
+    error = "decimation, mono";
+    return false;
+  }
+  PcmMonitor *monitor = new PcmMonitor();
+  if (args.size() > 0) monitor->setDecimation((uint8_t)args[0]);
+  if (args.size() > 1) monitor->setMono(args[1] != 0);
+  monitor->setBypass(false);
+  out.stage.reset(monitor);
+  out.reference.reset(new IdentityReference());
+  return true;
+}
+
+const std::vector<StageModel> &stageModels() {
+  static const std::vector<StageModel> models = {
+    { "eq", "eq[:g1,..,g5]        ParametricEQ with the firmware's five bands, gains in dB", makeEq },
+    { "gain", "gain:dB              GainStage", makeGain },
+    { "volume", "volume:v             GainStage at a2dp volume v (0..127)", makeVolume },
+    { "loudness", "loudness:v[,ms]      Loudness at a2dp volume v, switched off after ms", makeLoudness },
+    { "mix", "mix:m[,to,ms]        MixMatrix kernels against the generic one: 0 stereo 1 mono 2 swap 3 crossfeed 4 custom",
+      makeMix },
+    { "limiter", "limiter[:thr,ratio,knee,ceiling,release]   Limiter (dB, ms)", makeLimiter },
+    { "output", "output[:bits,dither] OutputFormat packing: 16/24/32 bit, dither 0 none 1 tpdf 2 shaped", makeOutput },
+    { "room", "room[:taps,irs]      Convolver with a made-up room response (1 or 2 impulse responses), 44.1 kHz", makeRoom },
+    { "spectrum", "spectrum             SpectrumAnalyzer tap", makeSpectrum },
+    { "meter", "meter                LoudnessMeter tap", makeMeter },
+    { "monitor", "monitor[:dec,mono]   PcmMonitor tap", makeMonitor },
+  };
+  return models;
+}
+
+bool makeStage(const std::string &spec, StageUnderTest &out, std::string &error) {
+  const size_t colon = spec.find(':');
+  const std::string name = spec.substr(0, colon);
+  std::vector<double> args;
+  if (colon != std::string::npos) {
+    const char *p = spec.c_str() + colon + 1;
+    while (*p) {
+      char *end;
+      args.push_back(strtod(p, &end));
+      if (end == p || (*end && *end != ',')) {
+        error = "bad number in " + spec;
+        return false;
+      }
+      p = *end ? end + 1 : end;
+    }
+  }
+  for (const StageModel &model : stageModels()) {
+    if (name != model.name) continue;
+    out.spec = spec;
+    if (!model.make(args, out, error)) {
+      error = spec + ": " + error;
+      return false;
+    }
+    return true;
+  }
+  error = "unknown stage " + name;
+  return false;
+}
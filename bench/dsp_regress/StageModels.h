@@ -0,0 +1,47 @@
+/*
+  StageModels.h - the stages bench/dsp_regress can put in a chain
+
+  Each model builds one lib/AudioDSP stage from a "name:arg,arg" chain
+  entry together with a double precision Reference of what the stage is
+  meant to do: the same design formulas and the same algorithm, with no
+  fixed point anywhere.  A reference includes the stage's designed
+  latency (the limiter's look-ahead), so the harness compares them sample
+  for sample.
+
+  A new stage in the A2DP path gets a StageModel here, and then it is
+  measured like every other stage.
+*/
+
+#ifndef STAGEMODELS_H_
+#define STAGEMODELS_H_
+
+#include <AudioStage.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Reference {
+  public:
+    virtual ~Reference() {}
+    virtual void begin(uint32_t sampleRate) = 0;            // also clears the state
+    virtual void process(double *samples, size_t frames, uint8_t channels) = 0;    // in place, full scale 1.0
+};
+
+struct StageUnderTest {
+  std::string spec;                                         // as given, for the report
+  std::unique_ptr<AudioStage> stage;
+  std::unique_ptr<Reference> reference;
+  void (*prepare)(AudioStage *stage) = nullptr;             // after begin(): what loop() would do (EQ design)
+};
+
+struct StageModel {
+  const char *name;
+  const char *usage;
+  bool (*make)(const std::vector<double> &args, StageUnderTest &out, std::string &error);
+};
+
+const std::vector<StageModel> &stageModels();
+bool makeStage(const std::string &spec, StageUnderTest &out, std::string &error);
+
+#endif
@@ -0,0 +1,352 @@
+/*
+  DSP regression harness
+
+  Runs a chain of lib/AudioDSP stages over WAV files (or generated test
+  signals) exactly as the I2S writer would, block by block in Q8.23, and
+  runs the same chain in double precision next to it (StageModels.cpp).
+  For every signal it reports the largest difference between the two in
+  16 bit LSB and the RMS difference in dBFS; for the chain it reports
+  cycles per sample for each stage, THD+N of a 997 Hz tone at -6 dBFS and
+  the latency of an impulse, each for the fixed point chain and for the
+  reference.  What the chain produced and what the reference produced are
+  written to <dir>/<signal>.wav and <dir>/<signal>.ref.wav for listening.
+
+  A chain is a list of stages, each "name" or "name:arg,arg,..." (run the
+  harness with -h for the list), e.g.
+
+    eq:6,0,-3,0,4 loudness:80 volume:80 limiter:-12,4 output:16,2
+
+  A stage can be switched during the run as well: loudness:40,500 switches
+  loudness off after 500 ms, and the reference fades the shelves out over
+  one block from there.  mix:3,4,500 runs the crossfeed preset and, after
+  500 ms, a custom matrix through MixMatrix's specialised kernels, against
+  the generic kernel: anything but 0 LSB (-e 0.01) is a kernel bug.
+
+  Without -i the signals are a 5 s log sweep (left) against a 1 kHz tone
+  (right) and 5 s of uncorrelated white noise, both at -6 dBFS.  Mono
+  files are duplicated to both channels since A2DP always delivers stereo.
+  -e and -t set pass limits for the largest error (LSB) and the THD+N
+  (dB); the harness exits non-zero if the chain misses either.
+
+  pio run -e bench_dsp_regress && .pio/build/bench_dsp_regress/program [-i in.wav]... [-o dir] [-r rate]
+      [-e lsb] [-t db] [stage...]
+*/
+
+#include <Arduino.h>
+#include <AudioPipeline.h>
+
+#include <chrono>
+#include <errno.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common/WavFile.h"
+#include "StageModels.h"
+
+#define TONE_HZ         997.0           // not a submultiple of any common rate
+#define TONE_LEVEL      0.5             // -6 dBFS
+#define IMPULSE_LEVEL   0.25            // -12 dBFS
+#define IMPULSE_AT      1024            // frames of silence before the impulse
+
+struct Signal {
+  std::string name;
+  WavData wav;
+};
+
+struct Result {
+  std::vector<int32_t> fixed;           // Q8.23, interleaved stereo
+  std::vector<double> reference;        // full scale 1.0
+};
+
+static std::vector<StageUnderTest> chain;
+static AudioPipeline pipeline;
+
+static WavData generate(uint32_t rate, double seconds, double (*left)(double t, size_t i),
+                        double (*right)(double t, size_t i)) {
+  WavData wav;
+  wav.sampleRate = rate;
+  wav.channels = 2;
+  const size_t frames = (size_t)(rate * seconds);
+  wav.samples.resize(frames * 2);
+  for (size_t i = 0; i < frames; i++) {
+    const double t = (double)i / rate;
+    wav.samples[2 * i] = (int16_t)lrint(32767.0 * left(t, i));
+    wav.samples[2 * i + 1] = (int16_t)lrint(32767.0 * right(t, i));
+  }
+  return wav;
+}
+
+static double sweep(double t, size_t i) {
+  (void)i;
+  const double f0 = 20.0, f1 = 20000.0, seconds = 5.0, k = log(f1 / f0);
+  return TONE_LEVEL * sin(2.0 * M_PI * f0 * seconds / k * (exp(k * t / seconds) - 1.0));
+}
+
+static double tone1k(double t, size_t i) {
+  (void)i;
+  return TONE_LEVEL * sin(2.0 * M_PI * 1000.0 * t);
+}
+
+static double tone(double t, size_t i) {
+  (void)i;
+  return TONE_LEVEL * sin(2.0 * M_PI * TONE_HZ * t);
+}
+
+static double noise(double t, size_t i) {
+  (void)t;
+  (void)i;
+  static uint32_t seed = 0x12345678;
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return TONE_LEVEL * ((double)seed / 2147483648.0 - 1.0);
+}
+
+static double impulse(double t, size_t i) {
+  (void)t;
+  return i == IMPULSE_AT ? IMPULSE_LEVEL : 0.0;
+}
+
+static bool makeDirs(const std::string &path) {
+  for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1)) {
+    const std::string dir = path.substr(0, slash);
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+    if (slash == std::string::npos) return true;
+  }
+}
+
+// the fixed point chain through the pipeline, and the reference chain, from scratch for each signal
+static Result run(const WavData &wav) {
+  Result r;
+  const size_t frames = wav.frames();
+  pipeline.begin(wav.sampleRate, 2);
+  for (StageUnderTest &s : chain) {
+    s.reference->begin(wav.sampleRate);
+    if (s.prepare) s.prepare(s.stage.get());
+  }
+
+  // a2dp hands the reader interleaved stereo
+  std::vector<int16_t> stereo(frames * 2);
+  for (size_t i = 0; i < frames; i++) {
+    stereo[2 * i] = wav.samples[i * wav.channels];
+    stereo[2 * i + 1] = wav.samples[i * wav.channels + wav.channels - 1];
+  }
+
+  r.fixed.resize(frames * 2);
+  AudioBlock block;
+  for (size_t off = 0; off < frames; off += AUDIO_BLOCK_FRAMES) {
+    const size_t n = frames - off < AUDIO_BLOCK_FRAMES ? frames - off : AUDIO_BLOCK_FRAMES;
+    audioBlockFromInt16(block, &stereo[off * 2], n, 2);
+    pipeline.process(block);
+    memcpy(&r.fixed[off * 2], block.samples, n * 2 * sizeof(int32_t));
+  }
+
+  r.reference.resize(frames * 2);
+  for (size_t i = 0; i < frames * 2; i++) r.reference[i] = stereo[i] / 32768.0;
+  for (StageUnderTest &s : chain) s.reference->process(r.reference.data(), frames, 2);
+  return r;
+}
+
+static double toDouble(int32_t sample) {
+  return (double)sample / AUDIO_FULL_SCALE;
+}
+
+// residual after a least squares fit of the tone (and DC) to the second half of the left channel, relative to the tone
+static double thdn(const std::vector<double> &x, uint32_t rate) {
+  const size_t frames = x.size() / 2, start = frames / 2, n = frames - start;
+  // normal equations for [cos sin 1]
+  double m[3][4] = {};
+  for (size_t i = start; i < frames; i++) {
+    const double w = 2.0 * M_PI * TONE_HZ * i / rate, b[3] = { cos(w), sin(w), 1.0 };
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) m[r][c] += b[r] * b[c];
+      m[r][3] += b[r] * x[2 * i];
+    }
+  }
+  for (int p = 0; p < 3; p++) {
+    for (int r = 0; r < 3; r++) {
+      if (r == p) continue;
+      const double f = m[r][p] / m[p][p];
+      for (int c = p; c < 4; c++) m[r][c] -= f * m[p][c];
+    }
+  }
+  const double a = m[0][3] / m[0][0], b = m[1][3] / m[1][1], dc = m[2][3] / m[2][2];
+  double residual = 0.0;
+  for (size_t i = start; i < frames; i++) {
+    const double w = 2.0 * M_PI * TONE_HZ * i / rate;
+    const double e = x[2 * i] - a * cos(w) - b * sin(w) - dc;
+    residual += e * e;
+  }
+  const double fundamental = (a * a + b * b) / 2.0 * n;
+  return 10.0 * log10((residual + 1e-30) / fundamental);
+}
+
+// frames from the impulse to the largest magnitude of the left channel
+static long latency(const std::vector<double> &x) {
+  size_t best = 0;
+  for (size_t i = 0; i < x.size() / 2; i++) {
+    if (fabs(x[2 * i]) > fabs(x[2 * best])) best = i;
+  }
+  return (long)best - IMPULSE_AT;
+}
+
+static std::vector<double> fixedAsDouble(const Result &r) {
+  std::vector<double> x(r.fixed.size());
+  for (size_t i = 0; i < x.size(); i++) x[i] = toDouble(r.fixed[i]);
+  return x;
+}
+
+static bool writeWav(const std::string &path, uint32_t rate, const int32_t *fixed, const double *reference, size_t count) {
+  WavData out;
+  out.sampleRate = rate;
+  out.channels = 2;
+  out.samples.resize(count);
+  if (fixed) {
+    audioSamplesToInt16(fixed, out.samples.data(), count);
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      const long s = lrint(reference[i] * 32768.0);
+      out.samples[i] = (int16_t)(s > INT16_MAX ? INT16_MAX : s < INT16_MIN ? INT16_MIN : s);
+    }
+  }
+  return wavWrite(path.c_str(), out);
+}
+
+// the cycle counter is the TSC on the host; time it against the monotonic clock
+static double cycleNs() {
+  auto t0 = std::chrono::steady_clock::now();
+  uint32_t c0 = ESP.getCycleCount();
+  delay(50);
+  uint32_t c1 = ESP.getCycleCount();
+  auto t1 = std::chrono::steady_clock::now();
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / (uint32_t)(c1 - c0);
+}
+
+static void usage(const char *program) {
+  fprintf(stderr, "usage: %s [-i in.wav]... [-o dir] [-r rate] [-e max error lsb] [-t max thd+n db] [stage...]\n\n",
+          program);
+  fprintf(stderr, "stages (default: eq volume:100 limiter):\n");
+  for (const StageModel &model : stageModels()) fprintf(stderr, "  %s\n", model.usage);
+}
+
+int main(int argc, char **argv) {
+  std::vector<const char *> inputs;
+  std::string outDir = ".pio/dsp_regress";
+  uint32_t rate = 44100;
+  double maxError = 0.0, maxThdn = 0.0;
+  int opt;
+  while ((opt = getopt(argc, argv, "i:o:r:e:t:h")) != -1) {
+    switch (opt) {
+      case 'i': inputs.push_back(optarg); break;
+      case 'o': outDir = optarg; break;
+      case 'r': rate = (uint32_t)atoi(optarg); break;
+      case 'e': maxError = atof(optarg); break;
+      case 't': maxThdn = atof(optarg); break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  std::vector<std::string> specs(argv + optind, argv + argc);
+  if (specs.empty()) specs = { "eq", "volume:100", "limiter" };
+  if (specs.size() > AUDIO_PIPELINE_MAX_STAGES) {
+    fprintf(stderr, "at most %u stages\n", AUDIO_PIPELINE_MAX_STAGES);
+    return 1;
+  }
+  chain.resize(specs.size());
+  for (size_t i = 0; i < specs.size(); i++) {
+    std::string error;
+    if (!makeStage(specs[i], chain[i], error)) {
+      fprintf(stderr, "%s\n", error.c_str());
+      usage(argv[0]);
+      return 1;
+    }
+    pipeline.add(chain[i].stage.get());
+  }
+
+  std::vector<Signal> signals;
+  for (const char *path : inputs) {
+    Signal s;
+    std::string error;
+    if (!wavRead(path, s.wav, error)) {
+      fprintf(stderr, "%s: %s\n", path, error.c_str());
+      return 1;
+    }
+    if (s.wav.channels > 2) {
+      fprintf(stderr, "%s: %u channels: only mono and stereo files can be streamed over A2DP\n", path, s.wav.channels);
+      return 1;
+    }
+    s.name = path;
+    s.name = s.name.substr(s.name.rfind('/') + 1);
+    s.name = s.name.substr(0, s.name.rfind('.'));
+    signals.push_back(s);
+  }
+  if (inputs.empty()) {
+    signals.push_back({ "sweep", generate(rate, 5.0, sweep, tone1k) });
+    signals.push_back({ "noise", generate(rate, 5.0, noise, noise) });
+  }
+  if (!makeDirs(outDir)) {
+    fprintf(stderr, "cannot create %s\n", outDir.c_str());
+    return 1;
+  }
+
+  printf("chain:");
+  for (const std::string &spec : specs) printf(" %s", spec.c_str());
+  printf("\n\n%-20s %8s %10s %12s %12s\n", "signal", "rate", "frames", "max err lsb", "rms err dBFS");
+
+  bool failed = false;
+  double worst = 0.0;
+  pipeline.resetStats();
+  for (const Signal &s : signals) {
+    const Result r = run(s.wav);
+    double peak = 0.0, sum = 0.0;
+    for (size_t i = 0; i < r.fixed.size(); i++) {
+      const double e = toDouble(r.fixed[i]) - r.reference[i];
+      peak = fmax(peak, fabs(e));
+      sum += e * e;
+    }
+    const double rms = r.fixed.empty() ? 0.0 : sqrt(sum / r.fixed.size());
+    printf("%-20s %8u %10zu %12.2f %12.1f\n", s.name.c_str(), s.wav.sampleRate, s.wav.frames(), peak * 32768.0,
+           rms > 0.0 ? 20.0 * log10(rms) : -999.0);
+    worst = fmax(worst, peak * 32768.0);
+
+    const std::string base = outDir + "/" + s.name;
+    if (!writeWav(base + ".wav", s.wav.sampleRate, r.fixed.data(), NULL, r.fixed.size()) ||
+        !writeWav(base + ".ref.wav", s.wav.sampleRate, NULL, r.reference.data(), r.reference.size())) {
+      fprintf(stderr, "cannot write %s\n", base.c_str());
+      return 1;
+    }
+  }
+
+  // cycles over the signals above only; the probes below are short and start from silence
+  const AudioPipelineStats stats = pipeline.stats();
+  const double samples = (double)stats.frames * 2, nsPerCycle = cycleNs();
+  printf("\n%-20s %14s %10s\n", "stage", "cycles/sample", "ns/sample");
+  uint64_t total = 0;
+  for (uint8_t i = 0; i < pipeline.stages(); i++) {
+    const double cycles = samples ? stats.stageCycles[i] / samples : 0;
+    printf("%-20s %14.2f %10.3f\n", chain[i].spec.c_str(), cycles, cycles * nsPerCycle);
+    total += stats.stageCycles[i];
+  }
+  printf("%-20s %14.2f %10.3f\n", "chain", samples ? total / samples : 0, samples ? total / samples * nsPerCycle : 0);
+
+  const Result toneRun = run(generate(rate, 2.0, tone, tone));
+  const Result impulseRun = run(generate(rate, 0.5, impulse, impulse));
+  const double fixedThdn = thdn(fixedAsDouble(toneRun), rate), referenceThdn = thdn(toneRun.reference, rate);
+  printf("\n%-20s %14s %10s\n", "", "fixed point", "reference");
+  printf("%-20s %14.1f %10.1f\n", "thd+n 997 Hz, dB", fixedThdn, referenceThdn);
+  printf("%-20s %14ld %10ld\n", "latency, frames", latency(fixedAsDouble(impulseRun)), latency(impulseRun.reference));
+  printf("\noutput in %s\n", outDir.c_str());
+
+  if (maxError > 0.0 && worst > maxError) {
+    fprintf(stderr, "largest error %.2f LSB, limit %.2f\n", worst, maxError);
+    failed = true;
+  }
+  if (maxThdn < 0.0 && fixedThdn > maxThdn) {
+    fprintf(stderr, "thd+n %.1f dB, limit %.1f\n", fixedThdn, maxThdn);
+    failed = true;
+  }
+  return failed ? 1 : 0;
+}
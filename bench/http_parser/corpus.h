@@ -0,0 +1,113 @@
+/*
+  corpus.h - request streams for the HTTP parser benchmark
+
+  Header sets are taken from real browser captures against the player's
+  web page (host/cookie values anonymised).  Multipart bodies are generated
+  at startup so the firmware-sized upload does not bloat the source.
+*/
+
+#ifndef HTTP_PARSER_CORPUS_H
+#define HTTP_PARSER_CORPUS_H
+
+#include <string>
+#include <vector>
+
+struct CorpusEntry {
+  const char *name;
+  std::string stream;       // one complete request, exactly as received
+  int expectedHeaders;      // headers the request must end up with
+  int expectedParams;       // query, form and multipart params (an uploaded file counts too)
+  size_t expectedUpload;    // file bytes delivered to the upload handler
+};
+
+static const char chromeGet[] =
+  "GET /?volume=42 HTTP/1.1\r\n"
+  "Host: 192.168.1.50\r\n"
+  "Connection: keep-alive\r\n"
+  "Cache-Control: max-age=0\r\n"
+  "Upgrade-Insecure-Requests: 1\r\n"
+  "User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/116.0.0.0 Safari/537.36\r\n"
+  "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7\r\n"
+  "Accept-Encoding: gzip, deflate\r\n"
+  "Accept-Language: en-US,en;q=0.9,de-DE;q=0.8,de;q=0.7\r\n"
+  "Cookie: session=6b1f0c2e9d7a4e55; theme=dark; lastVolume=42\r\n"
+  "\r\n";
+
+static const char firefoxGet[] =
+  "GET /update HTTP/1.1\r\n"
+  "Host: esp-music.local\r\n"
+  "User-Agent: Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:109.0) Gecko/20100101 Firefox/117.0\r\n"
+  "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+  "Accept-Language: en-GB,en;q=0.5\r\n"
+  "Accept-Encoding: gzip, deflate\r\n"
+  "DNT: 1\r\n"
+  "Sec-GPC: 1\r\n"
+  "Connection: keep-alive\r\n"
+  "Referer: http://esp-music.local/\r\n"
+  "Upgrade-Insecure-Requests: 1\r\n"
+  "If-Modified-Since: Sat, 19 Aug 2023 10:02:11 GMT\r\n"
+  "If-None-Match: \"3e8-18a0c6a3f40\"\r\n"
+  "Pragma: no-cache\r\n"
+  "Cache-Control: no-cache\r\n"
+  "\r\n";
+
+static const char formPost[] =
+  "POST /control HTTP/1.1\r\n"
+  "Host: 192.168.1.50\r\n"
+  "Connection: keep-alive\r\n"
+  "Content-Length: 71\r\n"
+  "Cache-Control: max-age=0\r\n"
+  "Origin: http://192.168.1.50\r\n"
+  "Content-Type: application/x-www-form-urlencoded\r\n"
+  "User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/116.0.0.0 Safari/537.36\r\n"
+  "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+  "Referer: http://192.168.1.50/\r\n"
+  "Accept-Encoding: gzip, deflate\r\n"
+  "Accept-Language: en-US,en;q=0.9\r\n"
+  "\r\n"
+  "volume=42&action=play&name=Living+Room&eq=%2B3%2C0%2C-2&loudness=on&x=1";
+
+static std::string multipartUpload(size_t fileBytes) {
+  static const char boundary[] = "----WebKitFormBoundaryq3JHxY2nbcW6K8dM";
+  std::string body;
+  body += "--"; body += boundary; body += "\r\n";
+  body += "Content-Disposition: form-data; name=\"MD5\"\r\n\r\n";
+  body += "9e107d9d372bb6826bd81d3542a419d6\r\n";
+  body += "--"; body += boundary; body += "\r\n";
+  body += "Content-Disposition: form-data; name=\"firmware\"; filename=\"firmware.bin\"\r\n";
+  body += "Content-Type: application/octet-stream\r\n\r\n";
+  uint32_t x = 0x1234567;
+  for (size_t i = 0; i < fileBytes; i++) {
+    x = x * 1664525u + 1013904223u;
+    char c = (char)(x >> 24);
+    // keep "\r\n--" out of the payload so the boundary scan sees only real boundaries
+    body += (c == '\r') ? 'r' : c;
+  }
+  body += "\r\n--"; body += boundary; body += "--\r\n";
+
+  std::string req =
+    "POST /update HTTP/1.1\r\n"
+    "Host: 192.168.1.50\r\n"
+    "Connection: keep-alive\r\n"
+    "Content-Length: " + std::to_string(body.size()) + "\r\n"
+    "Origin: http://192.168.1.50\r\n"
+    "Content-Type: multipart/form-data; boundary=" + boundary + "\r\n"
+    "User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/116.0.0.0 Safari/537.36\r\n"
+    "Accept: */*\r\n"
+    "Referer: http://192.168.1.50/update\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "\r\n";
+  return req + body;
+}
+
+static std::vector<CorpusEntry> buildCorpus() {
+  std::vector<CorpusEntry> corpus;
+  corpus.push_back({ "chrome GET", chromeGet, 9, 1, 0 });
+  corpus.push_back({ "firefox GET", firefoxGet, 14, 0, 0 });
+  corpus.push_back({ "form POST", formPost, 11, 6, 0 });
+  corpus.push_back({ "multipart 16K", multipartUpload(16 * 1024), 10, 2, 16 * 1024 });
+  return corpus;
+}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+  HTTP request-parser benchmark
+
+  Feeds recorded request streams into AsyncWebServerRequest through the
+  AsyncClient onData callback, the same way the async_tcp task delivers
+  pbufs on the board.  Every corpus entry is replayed with MSS-sized
+  segments and with random segment boundaries; for each run it reports
+  parse time per byte, heap allocations made while parsing one request
+  and the heap held by one request at its peak.  Exits non-zero if a
+  request does not parse to the expected headers/params/upload.
+
+  pio run -e bench_http_parser && .pio/build/bench_http_parser/program [iterations]
+*/
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <NativeHeap.h>
+
+#include <chrono>
+
+#include "corpus.h"
+
+#define BENCH_MSS 1436
+
+// delivers data straight into the callbacks the request registered
+class BenchClient : public AsyncClient {
+  public:
+    void feed(char *data, size_t len) { _recv_cb(_recv_cb_arg, this, data, len); }
+    void disconnect() { _discard_cb(_discard_cb_arg, this); }     // deletes this
+};
+
+struct RunResult {
+  double nsPerByte;
+  double allocsPerRequest;
+  size_t peakBytes;
+  uint32_t completed;
+};
+
+static AsyncWebServer server(80);
+static uint32_t completedRequests = 0;
+static int lastHeaders = 0;
+static int lastParams = 0;
+static size_t uploadedBytes = 0;
+
+static void onRequest(AsyncWebServerRequest *request) {
+  completedRequests++;
+  lastHeaders = request->headers();
+  lastParams = request->params();
+}
+
+static void onUpload(AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final) {
+  (void)request;
+  (void)filename;
+  (void)index;
+  (void)data;
+  (void)final;
+  uploadedBytes += len;
+}
+
+static uint32_t lcg = 1;
+
+static size_t randomSegment() {
+  lcg = lcg * 1103515245u + 12345u;
+  return 1 + (lcg >> 8) % BENCH_MSS;
+}
+
+static RunResult runCorpus(const CorpusEntry &entry, bool randomSplit, uint32_t iterations) {
+  std::vector<char> work(entry.stream.size());
+  std::vector<size_t> segments;
+  uint64_t parseNs = 0;
+  uint64_t allocs = 0;
+  size_t peak = 0;
+  uint32_t completedBefore = completedRequests;
+  lcg = 1;
+
+  for (uint32_t it = 0; it < iterations; it++) {
+    // the parser writes into the pbuf payload, so every replay needs a fresh copy
+    memcpy(work.data(), entry.stream.data(), work.size());
+    segments.clear();
+    for (size_t off = 0; off < work.size();) {
+      size_t len = randomSplit ? randomSegment() : BENCH_MSS;
+      if (len > work.size() - off) len = work.size() - off;
+      segments.push_back(len);
+      off += len;
+    }
+    uploadedBytes = 0;
+
+    NativeHeapStats before = nativeHeapStats();
+    nativeHeapResetPeak();
+    BenchClient *client = new BenchClient();
+    AsyncWebServerRequest *request = new AsyncWebServerRequest(&server, client);
+    (void)request;
+    NativeHeapStats constructed = nativeHeapStats();
+
+    auto start = std::chrono::steady_clock::now();
+    size_t off = 0;
+    for (size_t len : segments) {
+      client->feed(work.data() + off, len);
+      off += len;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    NativeHeapStats parsed = nativeHeapStats();
+    parseNs += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    allocs += (parsed.allocs - constructed.allocs) + (parsed.reallocs - constructed.reallocs);
+    if (parsed.peakBytes - before.liveBytes > peak) peak = parsed.peakBytes - before.liveBytes;
+
+    client->disconnect();
+
+    if (it == 0 && (lastHeaders != entry.expectedHeaders || lastParams != entry.expectedParams ||
+                    uploadedBytes != entry.expectedUpload)) {
+      fprintf(stderr, "%s: parsed %d headers, %d params, %zu upload bytes; expected %d, %d, %zu\n",
+              entry.name, lastHeaders, lastParams, uploadedBytes,
+              entry.expectedHeaders, entry.expectedParams, entry.expectedUpload);
+      exit(1);
+    }
+  }
+
+  RunResult r;
+  r.nsPerByte = (double)parseNs / ((double)entry.stream.size() * iterations);
+  r.allocsPerRequest = (double)allocs / iterations;
+  r.peakBytes = peak;
+  r.completed = completedRequests - completedBefore;
+  return r;
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = (argc > 1) ? strtoul(argv[1], NULL, 10) : 2000;
+  if (!iterations) iterations = 1;
+
+  server.on("/", HTTP_GET, onRequest);
+  server.on("/update", HTTP_GET, onRequest);
+  server.on("/control", HTTP_POST, onRequest);
+  server.on("/update", HTTP_POST, onRequest, onUpload);
+
+  std::vector<CorpusEntry> corpus = buildCorpus();
+
+  printf("%-15s %-7s %8s %9s %11s %10s\n", "corpus", "split", "bytes", "ns/byte", "allocs/req", "peak heap");
+  bool failed = false;
+  for (const CorpusEntry &entry : corpus) {
+    // uploads are ~40x the size of a GET; keep each row's run time comparable
+    uint32_t n = entry.expectedUpload ? (iterations + 39) / 40 : iterations;
+    for (int split = 0; split < 2; split++) {
+      RunResult r = runCorpus(entry, split == 1, n);
+      printf("%-15s %-7s %8zu %9.2f %11.1f %10zu\n", entry.name, split ? "random" : "mss",
+             entry.stream.size(), r.nsPerByte, r.allocsPerRequest, r.peakBytes);
+      if (r.completed != n) {
+        fprintf(stderr, "%s: only %u of %u requests reached the handler\n", entry.name, r.completed, n);
+        failed = true;
+      }
+    }
+  }
+  return failed ? 1 : 0;
+}
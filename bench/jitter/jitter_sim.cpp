@@ -0,0 +1,202 @@
+/*
+  Jitter buffer and clock drift simulation
+
+  Replays A2DP packet arrivals into the firmware's AudioRing and drains it
+  the way the I2S writer task does - prime to the target fill, read a block,
+  resample it, wait for the DMA to take the output at the I2S clock - with
+  the source clock off by a given drift.  Arrivals get random delivery
+  jitter, and wifi coexistence stalls hold packets back and release them
+  in one burst.  Each drift is run once without correction and once with
+  DriftControl driving Resampler::setRatioAdjust().
+
+  Reports underruns and overruns for both runs.  For the corrected run it
+  also reports the drift estimate and the range of the fill, both after
+  the first SIM_SETTLE_S, and the largest correction.  Fails (exit 1) if
+  the corrected run glitches at all or its average estimate is more than
+  2 ppm off.  The loop needs SIM_SETTLE_S to find 300 ppm to well within
+  that, so a run (or trace) shorter than SIM_MIN_S is refused (exit 2)
+  rather than failed.  Stalls longer than the target latency glitch
+  whatever the control does; keep the target above SIM_STALL_MAX_MS plus
+  the jitter.
+
+  A trace file replaces the generated packet timing: one packet per line,
+  "<arrival time in us> <frames>", as logged at the stream reader; drift
+  and stalls are applied on top of it.
+
+  pio run -e bench_jitter && .pio/build/bench_jitter/program [minutes [target ms [trace]]]
+*/
+
+#include <Arduino.h>
+#include <AudioRing.h>
+#include <DriftControl.h>
+#include <Resampler.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+#define SIM_RATE            44100
+#define SIM_RING_FRAMES     4096
+#define SIM_PACKET_FRAMES   512                 // SBC frames per A2DP packet x 128
+#define SIM_JITTER_MS       8.0                 // delivery delay, uniform 0..this
+#define SIM_STALL_EVERY_S   15.0                // mean time between wifi stalls
+#define SIM_STALL_MIN_MS    10.0
+#define SIM_STALL_MAX_MS    35.0
+#define SIM_SETTLE_S        (DRIFT_LOOP_SECONDS * 8)            // 300 ppm is found to within 1 ppm by then
+#define SIM_MIN_S           (SIM_SETTLE_S + DRIFT_LOOP_SECONDS * 3)
+
+struct Packet {
+  double time;                                  // seconds on the source clock
+  uint32_t frames;
+};
+
+struct Result {
+  uint32_t underruns, overruns;
+  float estimate, maxCorrection;                // estimate averaged after settling
+  float minFill, maxFill;                       // after settling, frames
+};
+
+static std::vector<Packet> generate(double seconds) {
+  std::vector<Packet> trace;
+  const double period = (double)SIM_PACKET_FRAMES / SIM_RATE;
+  for (double t = 0.0; t < seconds; t += period) trace.push_back({ t, SIM_PACKET_FRAMES });
+  return trace;
+}
+
+static bool load(const char *path, std::vector<Packet> &trace) {
+  FILE *f = fopen(path, "r");
+  if (!f) return false;
+  double us;
+  unsigned frames;
+  while (fscanf(f, "%lf %u", &us, &frames) == 2) trace.push_back({ us / 1e6, frames });
+  fclose(f);
+  return !trace.empty();
+}
+
+// arrival times on the I2S clock: drift, delivery jitter, stalls that release everything held at once
+static std::vector<double> arrivals(const std::vector<Packet> &trace, double driftPpm, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> jitter(0.0, SIM_JITTER_MS / 1000.0);
+  std::exponential_distribution<double> nextStall(1.0 / SIM_STALL_EVERY_S);
+  std::uniform_real_distribution<double> stallLength(SIM_STALL_MIN_MS / 1000.0, SIM_STALL_MAX_MS / 1000.0);
+
+  std::vector<double> times;
+  double stallStart = nextStall(rng), stallEnd = stallStart + stallLength(rng), last = 0.0;
+  for (const Packet &p : trace) {
+    double t = p.time / (1.0 + driftPpm * 1e-6) + jitter(rng);
+    while (t >= stallEnd) {
+      stallStart = stallEnd + nextStall(rng);
+      stallEnd = stallStart + stallLength(rng);
+    }
+    if (t >= stallStart) t = stallEnd;
+    if (t < last) t = last;                     // delivered in order
+    times.push_back(last = t);
+  }
+  return times;
+}
+
+static Result run(const std::vector<Packet> &trace, const std::vector<double> &times, uint32_t target, bool correct) {
+  static int16_t packet[8192 * 2];
+  static int16_t pcm[AUDIO_BLOCK_FRAMES * 2];
+  static int32_t out[RESAMPLER_MAX_OUT * 2];
+  AudioRing ring;
+  ring.begin(SIM_RING_FRAMES, 2);
+  Resampler resampler;
+  resampler.begin(RESAMPLER_LINEAR, 2);          // only the output frame count matters here
+  resampler.setRates(SIM_RATE, SIM_RATE);
+  DriftControl drift;
+  drift.begin(SIM_RATE, target);
+
+  Result r = { 0, 0, 0.0f, 0.0f, 1e9f, 0.0f };
+  AudioBlock block;
+  block.channels = 2;
+  block.frames = AUDIO_BLOCK_FRAMES;
+  memset(block.samples, 0, sizeof(block.samples));
+  const double settle = SIM_SETTLE_S;
+  const double end = times.back();
+  double writer = 0.0;                          // when the DMA next has room for a block
+  bool primed = false;
+  size_t next = 0;
+  double estimateSum = 0.0;
+  uint32_t settled = 0;
+
+  while (next < times.size() || (primed && writer < end)) {
+    // deliver everything that arrived before the writer's next turn
+    while (next < times.size() && (times[next] <= writer || !primed)) {
+      const uint32_t frames = trace[next].frames < 8192 ? trace[next].frames : 8192;
+      if (ring.write(packet, frames) < frames) r.overruns++;
+      if (!primed && ring.available() >= target) {
+        primed = true;
+        writer = times[next];
+      }
+      next++;
+    }
+    if (!primed) break;
+    if (writer >= end) break;
+
+    if (ring.available() < AUDIO_BLOCK_FRAMES) {
+      r.underruns++;
+      primed = false;
+      drift.reset();
+      continue;
+    }
+    ring.read(pcm, AUDIO_BLOCK_FRAMES);
+    if (correct) {
+      int32_t ppm = drift.update(ring.available(), AUDIO_BLOCK_FRAMES);
+      resampler.setRatioAdjust(ppm);
+      if (fabsf(drift.correctionPpm()) > r.maxCorrection) r.maxCorrection = fabsf(drift.correctionPpm());
+    }
+    size_t produced = correct ? resampler.process(block, out) : AUDIO_BLOCK_FRAMES;
+    writer += (double)produced / SIM_RATE;
+
+    if (writer > settle) {
+      float fill = (float)ring.available();
+      if (fill < r.minFill) r.minFill = fill;
+      if (fill > r.maxFill) r.maxFill = fill;
+      estimateSum += drift.driftPpm();
+      settled++;
+    }
+  }
+  r.estimate = settled ? (float)(estimateSum / settled) : drift.driftPpm();
+  return r;
+}
+
+int main(int argc, char **argv) {
+  const double minutes = argc > 1 ? atof(argv[1]) : 30.0;
+  const double targetMs = argc > 2 ? atof(argv[2]) : 46.0;
+  const uint32_t target = (uint32_t)(targetMs * SIM_RATE / 1000.0);
+
+  std::vector<Packet> trace;
+  if (argc > 3) {
+    if (!load(argv[3], trace)) {
+      fprintf(stderr, "cannot read trace %s\n", argv[3]);
+      return 1;
+    }
+  } else {
+    trace = generate(minutes * 60.0);
+  }
+  if (trace.back().time < SIM_MIN_S) {
+    fprintf(stderr, "%.0f s of packets is too short: the estimate is measured after %.0f s, give it at least %.0f s\n",
+            trace.back().time, (double)SIM_SETTLE_S, (double)SIM_MIN_S);
+    return 2;
+  }
+
+  printf("%.0f s of packets, ring %d frames, target %u frames (%.1f ms), stalls %.0f-%.0f ms every ~%.0f s\n",
+         trace.back().time, SIM_RING_FRAMES, target, targetMs, SIM_STALL_MIN_MS, SIM_STALL_MAX_MS, SIM_STALL_EVERY_S);
+  printf("%8s | %9s %9s | %9s %9s %9s %15s %9s\n", "drift", "underrun", "overrun", "underrun", "overrun",
+         "estimate", "fill range", "max corr");
+
+  const double drifts[] = { -300.0, -100.0, -20.0, 0.0, 20.0, 100.0, 300.0 };
+  bool failed = false;
+  uint32_t seed = 1;
+  for (double d : drifts) {
+    std::vector<double> times = arrivals(trace, d, seed++);
+    Result off = run(trace, times, target, false);
+    Result on = run(trace, times, target, true);
+    bool bad = on.underruns || on.overruns || fabs(on.estimate - d) > 2.0;
+    printf("%+6.0f ppm | %9u %9u | %9u %9u %+9.1f %6.0f..%-6.0f %+9.0f %s\n", d, off.underruns, off.overruns,
+           on.underruns, on.overruns, on.estimate, on.minFill, on.maxFill, on.maxCorrection, bad ? "FAIL" : "");
+    if (bad) failed = true;
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+/*
+  Limiter benchmark and ceiling check
+
+  Runs the Limiter stage over signals built to get past a look-ahead
+  limiter - isolated full-scale spikes after silence, square waves and
+  noise bursts far above full scale (the block has 8 bits of headroom, so
+  EQ boost plus volume can get there), a hot log sweep - under a set of
+  fixed settings and a few hundred random ones (threshold, ratio, knee,
+  ceiling, release).  For every run the output peak must stay at or below
+  the ceiling without the stage's safety clamp ever firing; a quiet signal
+  under the default settings must come out bit for bit, delayed by the
+  look-ahead.  Prints the worst margin under the ceiling, the deepest
+  gain reduction and the cost in cycles per sample for a loud and a quiet
+  signal.  Exits non-zero on any failure.
+
+  pio run -e bench_limiter && .pio/build/bench_limiter/program [random runs]
+*/
+
+#include <Arduino.h>
+#include <Limiter.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+#define BENCH_RATE      44100
+#define BENCH_SECONDS   2
+
+struct Settings {
+  float threshold, ratio, knee, ceiling, release;
+};
+
+typedef std::vector<int32_t> Signal;    // interleaved stereo, Q8.23
+
+static std::mt19937 rng(12345);
+
+static double uniform(double lo, double hi) {
+  return std::uniform_real_distribution<double>(lo, hi)(rng);
+}
+
+static int32_t fromDb(double db) {
+  return (int32_t)lrint(AUDIO_FULL_SCALE * pow(10.0, db / 20.0));
+}
+
+static Signal spikes() {
+  Signal s(BENCH_RATE * BENCH_SECONDS * 2, 0);
+  for (size_t i = 1000; i + 1 < s.size() / 2; i += 997) {
+    int32_t v = fromDb(uniform(-6.0, 24.0)) * (i & 1 ? 1 : -1);
+    s[2 * i] = v;
+    s[2 * i + 1] = i % 3 ? v : -v / 2;
+  }
+  return s;
+}
+
+static Signal square() {
+  Signal s(BENCH_RATE * BENCH_SECONDS * 2);
+  const int32_t v = fromDb(12.0);
+  for (size_t i = 0; i < s.size() / 2; i++) {
+    s[2 * i] = (i / 220) & 1 ? v : -v;
+    s[2 * i + 1] = (i / 73) & 1 ? v : -v;
+  }
+  return s;
+}
+
+static Signal noiseBursts() {
+  Signal s(BENCH_RATE * BENCH_SECONDS * 2);
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  double level = 0.0;
+  for (size_t i = 0; i < s.size() / 2; i++) {
+    if (i % 2205 == 0) level = fromDb(uniform(-30.0, 18.0)) / 3.0;
+    for (int c = 0; c < 2; c++) {
+      double v = gauss(rng) * level;
+      v = v > INT32_MAX / 2 ? INT32_MAX / 2 : v < INT32_MIN / 2 ? INT32_MIN / 2 : v;
+      s[2 * i + c] = (int32_t)v;
+    }
+  }
+  return s;
+}
+
+static Signal sweep(double db) {
+  Signal s(BENCH_RATE * BENCH_SECONDS * 2);
+  const double f0 = 20.0, f1 = 20000.0, k = log(f1 / f0), amp = fromDb(db);
+  for (size_t i = 0; i < s.size() / 2; i++) {
+    double t = (double)i / BENCH_RATE;
+    double phase = 2.0 * M_PI * f0 * BENCH_SECONDS / k * (exp(k * t / BENCH_SECONDS) - 1.0);
+    s[2 * i] = (int32_t)lrint(amp * sin(phase));
+    s[2 * i + 1] = (int32_t)lrint(amp * cos(phase));
+  }
+  return s;
+}
+
+struct Result {
+  int32_t peak;
+  uint32_t clamped;
+  float reduction;
+  uint64_t cycles;
+};
+
+static Result run(Limiter &limiter, const Signal &in, Signal *out) {
+  limiter.reset();
+  limiter.resetStats();
+  Result r = { 0, 0, 0.0f, 0 };
+  AudioBlock block;
+  block.channels = 2;
+  if (out) out->resize(in.size());
+  for (size_t start = 0; start < in.size() / 2; start += AUDIO_BLOCK_FRAMES) {
+    size_t frames = in.size() / 2 - start < AUDIO_BLOCK_FRAMES ? in.size() / 2 - start : AUDIO_BLOCK_FRAMES;
+    block.frames = (uint16_t)frames;
+    memcpy(block.samples, &in[start * 2], frames * 2 * sizeof(int32_t));
+    uint32_t c0 = ESP.getCycleCount();
+    limiter.process(block);
+    r.cycles += (uint32_t)(ESP.getCycleCount() - c0);
+    for (size_t i = 0; i < frames * 2; i++) {
+      int32_t a = block.samples[i] < 0 ? -block.samples[i] : block.samples[i];
+      if (a > r.peak) r.peak = a;
+    }
+    if (out) memcpy(&(*out)[start * 2], block.samples, frames * 2 * sizeof(int32_t));
+  }
+  r.clamped = limiter.clampedSamples();
+  r.reduction = limiter.peakReductionDb();
+  return r;
+}
+
+static void apply(Limiter &limiter, const Settings &s) {
+  limiter.setThreshold(s.threshold);
+  limiter.setRatio(s.ratio);
+  limiter.setKnee(s.knee);
+  limiter.setCeiling(s.ceiling);
+  limiter.setRelease(s.release);
+}
+
+int main(int argc, char **argv) {
+  int randomRuns = argc > 1 ? atoi(argv[1]) : 200;
+  bool failed = false;
+
+  const char *signalNames[] = { "spikes", "square +12dB", "noise bursts", "sweep +9dB" };
+  std::vector<Signal> signals = { spikes(), square(), noiseBursts(), sweep(9.0) };
+
+  std::vector<Settings> settings = {
+    { 0.0f, 1.0f, 3.0f, -0.5f, 50.0f },           // the defaults: limiter only
+    { 0.0f, 1.0f, 0.0f, 0.0f, 1.0f },             // hard knee at full scale, fastest release
+    { -20.0f, 4.0f, 6.0f, -1.0f, 100.0f },
+    { -40.0f, 100.0f, 24.0f, -12.0f, 2000.0f },
+  };
+  for (int i = 0; i < randomRuns; i++) {
+    settings.push_back({ (float)uniform(-60.0, 0.0), (float)uniform(1.0, 20.0), (float)uniform(0.0, 24.0),
+                         (float)uniform(-24.0, 0.0), (float)uniform(1.0, 2000.0) });
+  }
+
+  Limiter limiter;
+  limiter.begin(BENCH_RATE, 2);
+  double worstMargin = 1e9, deepest = 0.0;
+  size_t runs = 0;
+  for (const Settings &s : settings) {
+    apply(limiter, s);
+    const int32_t ceiling = (int32_t)floor(AUDIO_FULL_SCALE * pow(10.0, s.ceiling / 20.0));
+    for (size_t n = 0; n < signals.size(); n++) {
+      Result r = run(limiter, signals[n], NULL);
+      runs++;
+      double margin = 20.0 * log10((double)ceiling / (r.peak ? r.peak : 1));
+      if (r.peak > ceiling || r.clamped) {
+        fprintf(stderr, "FAIL %s: threshold %.1f ratio %.1f knee %.1f ceiling %.2f release %.0f: peak %d > %d or %u clamped\n",
+                signalNames[n], s.threshold, s.ratio, s.knee, s.ceiling, s.release, r.peak, ceiling, r.clamped);
+        failed = true;
+      }
+      if (margin < worstMargin) worstMargin = margin;
+      if (r.reduction > deepest) deepest = r.reduction;
+    }
+  }
+  printf("%zu runs: output peak at most %.4f dB under the ceiling, deepest gain reduction %.1f dB\n", runs,
+         worstMargin, deepest);
+
+  // transparency: below the knee the stage is a pure delay
+  apply(limiter, settings[0]);
+  Signal quiet = sweep(-12.0), out;
+  Result q = run(limiter, quiet, &out);
+  const size_t delay = limiter.latencyFrames() * 2;
+  bool exact = true;
+  for (size_t i = delay; i < out.size() && exact; i++) exact = out[i] == quiet[i - delay];
+  printf("-12 dBFS sweep, default settings: %s, %u frames latency\n", exact ? "bit exact" : "CHANGED",
+         limiter.latencyFrames());
+  if (!exact) failed = true;
+
+  Result loud = run(limiter, signals[3], NULL);
+  const double samples = (double)quiet.size();
+  printf("cycles/sample: %.2f quiet, %.2f limiting\n", q.cycles / samples, loud.cycles / samples);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/*
+  MixMatrix kernel benchmark
+
+  Runs each shape the mixing matrix has a specialised kernel for (2x2
+  crossfeed and swap, 2x1 downmix, 1x2 upmix) through that kernel and
+  through the generic one over the same random input, including samples
+  far past full scale so the saturation is exercised, and checks that the
+  two agree bit for bit.  Shapes without a specialised kernel (2x3 for a
+  2.1 feed, 2x4 for a TDM frame) run the generic kernel only, for scale.
+  Then the MixMatrix stage itself with the crossfeed preset, against the
+  same matrix forced onto the generic kernel, and across a preset change
+  every block to show the cost of the cross-fade.  Prints cycles per frame
+  and the speedup.  Exits non-zero if any output differs.
+
+  pio run -e bench_mix && .pio/build/bench_mix/program [passes]
+*/
+
+#include <Arduino.h>
+#include <MixMatrix.h>
+
+#include <math.h>
+#include <random>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define BENCH_FRAMES    (44100 * 2)
+#define BENCH_PASSES    20
+
+struct Shape {
+  const char *name;
+  uint8_t inputs, outputs;
+  float gains[MIX_MAX_OUTPUTS * MIX_MAX_INPUTS];
+};
+
+static const Shape shapes[] = {
+  { "2x2 crossfeed", 2, 2, { 0.75f, 0.25f, 0.25f, 0.75f } },
+  { "2x2 swap", 2, 2, { 0.0f, 1.0f, 1.0f, 0.0f } },
+  { "2x1 downmix", 2, 1, { 0.5f, 0.5f } },
+  { "1x2 upmix", 1, 2, { 0.7071f, 0.7071f } },
+  { "2x3 2.1", 2, 3, { 1.0f, 0.0f, 0.0f, 1.0f, 0.5f, 0.5f } },
+  { "2x4 tdm", 2, 4, { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f } },
+};
+
+static std::mt19937 rng(12345);
+
+static MixConfig config(const Shape &s, MixKernel kernel) {
+  MixConfig c;
+  memset(&c, 0, sizeof(c));
+  c.inputs = s.inputs;
+  c.outputs = s.outputs;
+  for (uint8_t o = 0; o < s.outputs; o++) {
+    for (uint8_t i = 0; i < s.inputs; i++) c.gain[o][i] = (int32_t)lrintf(s.gains[o * s.inputs + i] * MIX_UNITY);
+  }
+  c.kernel = kernel;
+  c.preset = MIX_CUSTOM;
+  return c;
+}
+
+// mostly within the block's headroom, one sample in a hundred anywhere in int32
+static std::vector<int32_t> input(size_t count) {
+  std::vector<int32_t> v(count);
+  std::uniform_int_distribution<int32_t> wide(INT32_MIN, INT32_MAX), audio(-AUDIO_FULL_SCALE * 4, AUDIO_FULL_SCALE * 4);
+  for (size_t i = 0; i < count; i++) v[i] = i % 100 == 7 ? wide(rng) : audio(rng);
+  return v;
+}
+
+// cycles per frame, over passes runs of the whole input a block at a time
+static double timeKernel(const MixConfig &c, const std::vector<int32_t> &in, std::vector<int32_t> &out, int passes) {
+  uint64_t cycles = 0;
+  for (int p = 0; p < passes; p++) {
+    for (size_t f = 0; f < BENCH_FRAMES; f += AUDIO_BLOCK_FRAMES) {
+      const uint16_t frames = BENCH_FRAMES - f < AUDIO_BLOCK_FRAMES ? BENCH_FRAMES - f : AUDIO_BLOCK_FRAMES;
+      uint32_t c0 = ESP.getCycleCount();
+      c.kernel(c, &in[f * c.inputs], &out[f * c.outputs], frames);
+      cycles += (uint32_t)(ESP.getCycleCount() - c0);
+    }
+  }
+  return (double)cycles / ((double)BENCH_FRAMES * passes);
+}
+
+// the stage over stereo blocks; with flip the preset changes every block, so every block cross-fades
+static double timeStage(MixMatrix &mix, const std::vector<int32_t> &in, std::vector<int32_t> &out, int passes, bool flip) {
+  AudioBlock block;
+  block.channels = 2;
+  mix.reset();
+  uint64_t cycles = 0;
+  for (int p = 0; p < passes; p++) {
+    for (size_t f = 0; f < BENCH_FRAMES; f += AUDIO_BLOCK_FRAMES) {
+      block.frames = BENCH_FRAMES - f < AUDIO_BLOCK_FRAMES ? BENCH_FRAMES - f : AUDIO_BLOCK_FRAMES;
+      memcpy(block.samples, &in[f * 2], block.frames * 2 * sizeof(int32_t));
+      if (flip) mix.setPreset(mix.preset() == MIX_CROSSFEED ? MIX_SWAP : MIX_CROSSFEED);
+      uint32_t c0 = ESP.getCycleCount();
+      mix.process(block);
+      cycles += (uint32_t)(ESP.getCycleCount() - c0);
+      memcpy(&out[f * 2], block.samples, block.frames * 2 * sizeof(int32_t));
+    }
+  }
+  return (double)cycles / ((double)BENCH_FRAMES * passes);
+}
+
+int main(int argc, char **argv) {
+  const int passes = argc > 1 ? atoi(argv[1]) : BENCH_PASSES;
+  if (passes < 1) {
+    printf("usage: %s [passes]\n", argv[0]);
+    return 2;
+  }
+  const std::vector<int32_t> in = input((size_t)BENCH_FRAMES * MIX_MAX_INPUTS);
+  std::vector<int32_t> special((size_t)BENCH_FRAMES * MIX_MAX_OUTPUTS), generic(special.size());
+  bool failed = false;
+
+  printf("%-16s %12s %12s %8s\n", "kernel", "specialised", "generic", "speedup");
+  for (const Shape &s : shapes) {
+    const MixKernel kernel = MixMatrix::kernelFor(s.inputs, s.outputs);
+    const double g = timeKernel(config(s, MixMatrix::generic), in, generic, passes);
+    if (kernel == MixMatrix::generic) {
+      printf("%-16s %12s %12.2f %8s\n", s.name, "-", g, "-");
+      continue;
+    }
+    const double k = timeKernel(config(s, kernel), in, special, passes);
+    const bool same = memcmp(special.data(), generic.data(), (size_t)BENCH_FRAMES * s.outputs * sizeof(int32_t)) == 0;
+    printf("%-16s %12.2f %12.2f %7.2fx%s\n", s.name, k, g, g / k, same ? "" : "  MISMATCH");
+    failed |= !same;
+  }
+
+  // the stage, as the chain runs it
+  const Shape &crossfeed = shapes[0];
+  MixMatrix stage;
+  stage.setMatrix(2, 2, crossfeed.gains);
+  const double k = timeStage(stage, in, special, passes, false);
+  stage.setMatrix(2, 2, crossfeed.gains, true);
+  const double g = timeStage(stage, in, generic, passes, false);
+  bool same = memcmp(special.data(), generic.data(), (size_t)BENCH_FRAMES * 2 * sizeof(int32_t)) == 0;
+  printf("%-16s %12.2f %12.2f %7.2fx%s\n", "stage crossfeed", k, g, g / k, same ? "" : "  MISMATCH");
+  failed |= !same;
+  stage.setPreset(MIX_STEREO);
+  printf("%-16s %12.2f\n", "stage stereo", timeStage(stage, in, special, passes, false));
+  same = memcmp(special.data(), in.data(), (size_t)BENCH_FRAMES * 2 * sizeof(int32_t)) == 0;
+  if (!same) printf("stage stereo: output differs from the input\n");
+  failed |= !same;
+  printf("%-16s %12.2f\n", "stage fading", timeStage(stage, in, special, passes, true));
+
+  printf("%s\n", failed ? "FAILED" : "OK");
+  return failed ? 1 : 0;
+}
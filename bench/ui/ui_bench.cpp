@@ -0,0 +1,145 @@
+/*
+  OLED menu encoder burst and phone volume check
+
+  Runs the firmware (setup() and loop() from src/) and turns the encoder
+  through nativeSetPin(), the way the encoder interrupt sees it.  Each
+  check turns a number of detents one at a time, with loop() running in
+  between, and keeps the frame that ends up on the display; turns back;
+  then turns the same detents in one burst, all of them queued before
+  loop() wakes up, and compares that frame with the first one.  A burst
+  is what a fast turn looks like to loop(): one wakeup for several steps.
+  This is done in the control menu and in the volume editor.
+
+  Then the phone moves its volume slider (AVRCP absolute volume through
+  the sink's volume change callback): the last value has to end up in
+  EEPROM, written once after the slider has stopped.  Exits non-zero if a
+  burst leaves a different frame than the slow turn, or the phone's volume
+  is not saved.
+
+  pio run -e bench_ui && .pio/build/bench_ui/program [detents]
+*/
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include <BluetoothA2DPSink.h>
+#include <EEPROM.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+// as src/main.cpp has them
+#define PIN_A           32
+#define PIN_B           33
+#define PIN_BUTTON      25
+#define VOLUME_ADDR     0
+#define PHONE_SAVE_MS   2000
+
+#define SETTLE_MS       300             // long enough for the button debounce and a frame at any rate
+
+extern Adafruit_SSD1306 display;
+extern BluetoothA2DPSink a2dp_sink;
+
+static uint8_t level = 0;               // both encoder pins, between detents
+
+static void runFor(uint32_t ms) {
+  const uint32_t start = millis();
+  while ((uint32_t)(millis() - start) < ms) loop();
+}
+
+// the interrupt is on A: B first turns down the list (or the value down), A first turns the other way
+static void detent(bool down) {
+  level = !level;
+  if (down) {
+    nativeSetPin(PIN_B, level);
+    nativeSetPin(PIN_A, level);
+  } else {
+    nativeSetPin(PIN_A, level);
+    nativeSetPin(PIN_B, level);
+  }
+}
+
+static void press() {
+  nativeSetPin(PIN_BUTTON, LOW);
+  runFor(SETTLE_MS);
+  nativeSetPin(PIN_BUTTON, HIGH);
+  runFor(SETTLE_MS);
+}
+
+static std::vector<uint8_t> frame() {
+  const uint8_t *buffer = display.getBuffer();
+  return std::vector<uint8_t>(buffer, buffer + display.width() * ((display.height() + 7) / 8));
+}
+
+// true if turning n detents down in one burst leaves the frame turning them one at a time does
+static bool check(const char *what, int n) {
+  for (int i = 0; i < n; i++) {
+    detent(true);
+    runFor(SETTLE_MS / 2);
+  }
+  const std::vector<uint8_t> slow = frame();
+  for (int i = 0; i < n; i++) {
+    detent(false);
+    runFor(SETTLE_MS / 2);
+  }
+  const std::vector<uint8_t> before = frame();
+
+  const uint32_t frames = display.displayFrames();
+  for (int i = 0; i < n; i++) detent(true);
+  runFor(SETTLE_MS);
+  const std::vector<uint8_t> burst = frame();
+
+  const bool ok = burst == slow && burst != before;
+  printf("%-14s %d detents in one burst: %u frames, %s\n", what, n, display.displayFrames() - frames,
+         ok ? "same as one at a time" : burst == before ? "display not updated" : "DIFFERENT from one at a time");
+  return ok;
+}
+
+// a slider moved on the phone: a step every 10 ms, then the eeprom copy of the last one after it settled
+static bool checkPhoneVolume() {
+  const int to = EEPROM.read(VOLUME_ADDR) == 70 ? 60 : 70;
+  const uint32_t commits = EEPROM.commitCount();
+  for (int v = to - 20; v <= to; v++) {
+    a2dp_sink.native_set_remote_volume((uint8_t)v);
+    runFor(10);
+  }
+  runFor(PHONE_SAVE_MS / 2);
+  const bool early = EEPROM.commitCount() != commits;
+  runFor(PHONE_SAVE_MS / 2 + SETTLE_MS);
+
+  const int saved = EEPROM.read(VOLUME_ADDR);
+  const uint32_t written = EEPROM.commitCount() - commits;
+  const bool ok = saved == to && written == 1 && !early;
+  printf("%-14s 21 steps from the phone to %d: eeprom %d after %u commits%s, %s\n", "phone volume", to, saved, written,
+         early ? " (one while it was moving)" : "", ok ? "saved once" : "NOT as expected");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  const int n = argc > 1 ? atoi(argv[1]) : 3;
+  if (n < 1 || n > 10) {
+    fprintf(stderr, "usage: %s [detents 1..10]\n", argv[0]);
+    return 2;
+  }
+
+  setup();
+  runFor(SETTLE_MS);
+  press();                              // the welcome message: opens the control menu on Exit
+
+  bool ok = check("control menu", n);
+  for (int i = 0; i < 3 - n; i++) {     // onto Volume
+    detent(true);
+    runFor(SETTLE_MS / 2);
+  }
+  for (int i = 0; i < n - 3; i++) {
+    detent(false);
+    runFor(SETTLE_MS / 2);
+  }
+  press();
+  ok = check("volume editor", n) && ok;
+  ok = checkPhoneVolume() && ok;
+
+  fflush(stdout);
+  _exit(ok ? 0 : 1);                    // the web server and a2dp tasks are still running
+}
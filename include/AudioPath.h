@@ -0,0 +1,214 @@
+/*
+  AudioPath.h - A2DP sink -> PCM ring -> DSP chain -> I2S
+
+  audioPathBegin() takes over the sink's output: it installs the stream
+  reader with the library's own I2S output disabled and sets up the I2S
+  driver itself.  The Bluetooth callback only copies decoded PCM into a
+  lock-free ring; an I2S writer task drains the ring a block at a time,
+  runs audioPathPipeline(), the resampler and audioPathOutputChain(), and
+  writes to the DMA.  Call it before a2dp_sink.start().
+
+  The ring depth is AUDIO_RING_FRAMES (override with a build flag); with
+  AUDIO_RING_PSRAM set it is allocated from PSRAM when the module has it.
+
+  By default the I2S clock follows the rate the phone negotiates.  DACs
+  that only run from one fixed clock set AUDIO_OUTPUT_RATE instead: the
+  clock then stays at that rate and a Resampler of AUDIO_RESAMPLER_QUALITY
+  converts the stream between the DSP chain and the output chain.
+
+  The ring doubles as the jitter buffer: playback starts once it holds
+  AUDIO_TARGET_LATENCY_MS, and with AUDIO_DRIFT_CORRECTION a DriftControl
+  loop keeps it there by trimming the resampler's ratio by a few ppm, so
+  the drift between the phone's clock and the I2S clock never runs it
+  over or dry.  The resampler then runs even when the rates match, which
+  is why the limiter comes after it.  When a wifi stall does run it dry
+  mid-stream, a Concealer continues the audio from before the gap (fading
+  out after CONCEAL_HOLD_MS) until the ring has filled up again, then
+  cross-fades back into the stream.
+
+  The I2S word size and layout are AUDIO_OUTPUT_BITS (16, 24 or 32) and
+  AUDIO_OUTPUT_LEFT_JUSTIFIED; the processing stays at 24 bits until the
+  final packing, which dithers 16 bit output (AUDIO_OUTPUT_DITHER).
+
+  When the output has been silent for AUDIO_IDLE_HANGOVER_MS (paused
+  phone, silence streamed, or no stream at all) the writer stops the I2S
+  DMA, which lets most DACs drop into standby, and releases a PM lock so
+  that with CONFIG_PM_ENABLE the CPU clock scales down to AUDIO_IDLE_MIN_MHZ
+  (and light sleep engages if tickless idle is on).  Output starts again
+  on the first block that is not silent.  audioPathStats() has the time
+  spent in each state.
+
+  The chain is the loudness meter, normalization, channel mixing,
+  equalizer, room correction, spectrum tap, volume, loudness and fade, at
+  the source rate.  The output chain runs at the I2S rate, on what the
+  resampler made of it: audioPathLimiter(), which keeps hot masters at
+  high volume from clipping at the DAC, then the monitor tap.  The
+  resampler's interpolation rebuilds inter-sample peaks, so a limiter in
+  front of it would not hold the ceiling; after it, every sample that
+  reaches the DAC has been through the limiter.
+
+  Loudness follows the volume with bass and treble shelves from a flash
+  table; it is off until audioPathSetLoudness(true).
+
+  audioPathMeter() measures the stream as it arrives, before any of the
+  processing, to EBU R128: momentary, short-term and integrated loudness.
+  The integrated value starts over with each stream.  With
+  audioPathSetNormalize(true) the gain stage after it takes the stream
+  toward audioPathNormalizeTarget() LUFS, once AUDIO_NORMALIZE_SETTLE_S of
+  it has been measured, at no more than AUDIO_NORMALIZE_DB_PER_S and
+  within +/-AUDIO_NORMALIZE_MAX_DB, so apps that stream 10 dB apart play
+  at about the same level without the gain pumping within a track.
+
+  audioPathMixer() routes the channels through a matrix: stereo as it
+  comes, mono, swapped, a headphone crossfeed or any 2x2 set with
+  setMatrix(); a change cross-fades over one block.
+
+  audioPathRoom() convolves with a measured room response of up to
+  CONVOLVER_MAX_TAPS taps, read from a wav file by audioPathLoadRoom() (in
+  PSRAM with AUDIO_RING_PSRAM).  Its FFTs run on a worker task on core
+  ROOM_TASK_CORE, which adds one block of latency; if the worker cannot
+  keep up it shortens the filter.  Without a filter for the stream's
+  sample rate the stage passes the audio through.
+
+  audioPathSpectrum() is a tap between the equalizer and the volume stage.
+  It is bypassed until the display enables it; its FFT runs on a task of
+  its own on the other core so it never holds up the writer.
+
+  audioPathMonitor() taps the end of the output chain, after the limiter:
+  it collects decimated 16 bit frames at the I2S rate for a remote
+  listener and drops them when the sender falls behind.  It is bypassed
+  until someone listens.
+*/
+
+#ifndef AUDIOPATH_H_
+#define AUDIOPATH_H_
+
+#include "BluetoothA2DPSink.h"
+#include <FS.h>
+#include <AudioPipeline.h>
+#include <AudioRing.h>
+#include <Convolver.h>
+#include <DriftControl.h>
+#include <Limiter.h>
+#include <LoudnessMeter.h>
+#include <MixMatrix.h>
+#include <OutputFormat.h>
+#include <ParametricEQ.h>
+#include <PcmMonitor.h>
+#include <Resampler.h>
+#include <SilenceDetector.h>
+#include <SpectrumAnalyzer.h>
+
+#define AUDIO_PATH_I2S_PORT     I2S_NUM_0
+
+#ifndef AUDIO_RING_FRAMES
+#define AUDIO_RING_FRAMES       4096            // ~93 ms at 44.1 kHz, 16 KB
+#endif
+#ifndef AUDIO_RING_PSRAM
+#define AUDIO_RING_PSRAM        0
+#endif
+
+#ifndef AUDIO_OUTPUT_RATE
+#define AUDIO_OUTPUT_RATE       0               // Hz; 0 = follow the source
+#endif
+#ifndef AUDIO_RESAMPLER_QUALITY
+#define AUDIO_RESAMPLER_QUALITY RESAMPLER_MEDIUM
+#endif
+
+#ifndef AUDIO_OUTPUT_BITS
+#define AUDIO_OUTPUT_BITS       16              // I2S word: 16, 24 or 32
+#endif
+#ifndef AUDIO_OUTPUT_LEFT_JUSTIFIED
+#define AUDIO_OUTPUT_LEFT_JUSTIFIED 0           // 1: data starts on the word select edge (MSB format)
+#endif
+#ifndef AUDIO_OUTPUT_DITHER
+#define AUDIO_OUTPUT_DITHER     OUTPUT_DITHER_TPDF      // 16 bit output only
+#endif
+
+#ifndef AUDIO_TARGET_LATENCY_MS
+#define AUDIO_TARGET_LATENCY_MS 46              // ring fill to start at and hold; at most 3/4 of the ring
+#endif
+#ifndef AUDIO_DRIFT_CORRECTION
+#define AUDIO_DRIFT_CORRECTION  1               // track the source clock by resampling
+#endif
+
+#ifndef AUDIO_VOLUME_RANGE_DB
+#define AUDIO_VOLUME_RANGE_DB   60              // volume 1 is this far below 127; 0 mutes (loudness table assumes 60)
+#endif
+#define AUDIO_FADE_MS           20              // fade in/out around stream start, end and mute
+
+#ifndef AUDIO_NORMALIZE_TARGET_LUFS
+#define AUDIO_NORMALIZE_TARGET_LUFS -18.0f      // integrated loudness normalization aims for
+#endif
+#define AUDIO_NORMALIZE_MAX_DB  12.0f           // most boost or cut
+#define AUDIO_NORMALIZE_DB_PER_S 1.0f           // how fast the gain follows
+#define AUDIO_NORMALIZE_SETTLE_S 3.0f           // gated audio measured before the gain moves
+#define AUDIO_NORMALIZE_UPDATE_MS 250
+
+#ifndef AUDIO_IDLE_HANGOVER_MS
+#define AUDIO_IDLE_HANGOVER_MS  SILENCE_HANGOVER_MS     // silence before I2S stops; 0 keeps it running
+#endif
+#define AUDIO_SILENCE_PEAK_DB   SILENCE_PEAK_DB
+#define AUDIO_SILENCE_RMS_DB    SILENCE_RMS_DB
+#define AUDIO_IDLE_MIN_MHZ      80              // CPU clock DFS may drop to while idle (CONFIG_PM_ENABLE)
+
+#define AUDIO_WRITER_PRIORITY   (configMAX_PRIORITIES - 5)
+#define AUDIO_WRITER_CORE       1
+#define AUDIO_WRITER_STACK      4096
+
+#define ROOM_TASK_PRIORITY      AUDIO_WRITER_PRIORITY   // the writer waits on it every block
+#define ROOM_TASK_CORE          0
+#define ROOM_TASK_STACK         3072
+
+#define SPECTRUM_TASK_PRIORITY  1               // below wifi and bluetooth, above idle
+#define SPECTRUM_TASK_CORE      0
+#define SPECTRUM_TASK_STACK     2048
+
+struct AudioPathStats {
+  AudioRingStats ring;
+  uint32_t sampleRate;        // source rate
+  uint32_t outputRate;        // I2S rate
+  uint32_t blocksWritten;     // blocks handed to I2S
+  uint64_t writerCycles;      // cycles the writer spent on DSP (excludes waiting on the DMA)
+  float latencyMs;            // average ring fill
+  float targetLatencyMs;
+  float driftPpm;             // estimated source clock drift against I2S
+  float correctionPpm;        // rate trim applied right now
+  bool idle;                  // I2S stopped for silence
+  float activeSeconds;        // time with I2S running
+  float idleSeconds;          // time stopped
+  uint32_t idleCount;         // times it stopped
+  uint32_t concealedFrames;   // frames made up to cover underruns
+  uint32_t concealedGaps;     // underruns covered
+};
+
+bool audioPathBegin(BluetoothA2DPSink &sink, const i2s_pin_config_t &pins,
+                    size_t ringFrames = AUDIO_RING_FRAMES, bool psram = AUDIO_RING_PSRAM);
+void audioPathSetVolume(uint8_t volume);        // 0..127, same scale as a2dp_sink.set_volume(); dB law, ramped
+                                                // the library's volume never reaches the chain: the phone's
+                                                // changes come in through set_on_volumechange()
+void audioPathMute(bool mute);                  // fades out/in; call before pausing, after playing
+bool audioPathSetLoudness(bool enabled);        // volume-dependent bass/treble boost; off by default
+bool audioPathLoudness();
+void audioPathSetNormalize(bool enabled);       // loudness normalization; off by default
+bool audioPathNormalize();
+void audioPathSetNormalizeTarget(float lufs);   // -40 to -6
+float audioPathNormalizeTarget();
+float audioPathNormalizeDb();                   // gain normalization applies now
+void audioPathUpdate();                         // call from loop(): EQ design, room filters, normalization gain
+bool audioPathLoadRoom(fs::FS &fs, const char *path);     // room correction impulse response from a wav file
+void audioPathSetRoom(bool enabled);            // bypass the room correction (on while a filter is loaded)
+LoudnessMeter &audioPathMeter();
+MixMatrix &audioPathMixer();
+ParametricEQ &audioPathEqualizer();
+Convolver &audioPathRoom();
+AudioPipeline &audioPathPipeline();
+AudioPipeline &audioPathOutputChain();          // limiter and monitor, at the I2S rate
+Limiter &audioPathLimiter();
+SpectrumAnalyzer &audioPathSpectrum();          // setBypass(false) to start analysing
+PcmMonitor &audioPathMonitor();                 // setBypass(false) to start collecting frames
+OutputFormat &audioPathOutput();                // dither can be changed while playing
+AudioPathStats audioPathStats();
+void audioPathResetStats();
+
+#endif
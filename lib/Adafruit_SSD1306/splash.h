@@ -0,0 +1,120 @@
+/**
+ * This file is autogenerated, do not edit.
+ * Run `make` from the scripts directory to produce splash.h
+ *
+ * Splashes will be stored in PROGMEM (flash).
+ * If SSD1306_NO_SPLASH is defined, the splashes are omitted.
+ */
+
+#ifndef SSD1306_NO_SPLASH
+/* clang-format off */
+
+#define splash1_width  82
+#define splash1_height 64
+
+const uint8_t PROGMEM splash1_data[] = {
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000001,0b10000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000011,0b10000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000111,0b11000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000111,0b11000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00001111,0b11000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00011111,0b11100000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00011111,0b11100000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00111111,0b11100000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00111111,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b01111111,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00011111,0b11111000,0b01111111,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00111111,0b11111110,0b01111111,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00111111,0b11111111,0b01111111,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00011111,0b11111111,0b11111011,0b11100000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00001111,0b11111111,0b11111001,0b11111111,0b11000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00001111,0b11111111,0b11111001,0b11111111,0b11111000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000111,0b11111111,0b11110001,0b11111111,0b11111111,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000011,0b11111100,0b01110011,0b11111111,0b11111111,0b10000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000001,0b11111110,0b00111111,0b11111111,0b11111111,0b10000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b11111111,0b00011110,0b00001111,0b11111111,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b01111111,0b11111110,0b00011111,0b11111100,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00111111,0b11111111,0b11111111,0b11111000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00001111,0b11011111,0b11111111,0b11100000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00011111,0b00011001,0b11111111,0b11000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00111111,0b00111100,0b11111111,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b01111110,0b01111100,0b11111000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b01111111,0b11111110,0b01111100,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b11111111,0b11111111,0b11111100,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b11111111,0b11111111,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b11111111,0b11111111,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000001,0b11111111,0b11101111,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000001,0b11111111,0b11001111,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000011,0b11111111,0b00000111,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000011,0b11111100,0b00000111,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000011,0b11110000,0b00000011,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000001,0b10000000,0b00000000,0b11111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b01111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00111110,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00001100,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b00000111,0b10000000,0b00000000,0b11111100,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,
+  0b00000000,0b00000000,0b00000111,0b10000000,0b00000001,0b11111100,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,
+  0b00000000,0b00000000,0b00000111,0b10000000,0b00000001,0b11111100,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,
+  0b00000000,0b00000000,0b00000111,0b10000000,0b00000001,0b11100000,0b00000000,0b00000000,0b00000000,0b00011110,0b00000000,
+  0b00000000,0b00000000,0b00000111,0b10000000,0b00000001,0b11100000,0b00000000,0b00000000,0b00000000,0b00011110,0b00000000,
+  0b01111111,0b11100011,0b11110111,0b10011111,0b11111001,0b11111101,0b11100111,0b01111000,0b01111011,0b11011111,0b11000000,
+  0b11111111,0b11110111,0b11111111,0b10111111,0b11111101,0b11111101,0b11111111,0b01111000,0b01111011,0b11011111,0b11000000,
+  0b11111111,0b11110111,0b11111111,0b10111111,0b11111101,0b11111101,0b11111111,0b01111000,0b01111011,0b11011111,0b11000000,
+  0b11110000,0b11110111,0b10000111,0b10111100,0b00111101,0b11100001,0b11111111,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b11110000,0b11110111,0b10000111,0b10111100,0b00111101,0b11100001,0b11110000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b00000000,0b11110111,0b10000111,0b10000000,0b00111101,0b11100001,0b11100000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b01111111,0b11110111,0b10000111,0b10011111,0b11111101,0b11100001,0b11100000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b11111111,0b11110111,0b10000111,0b10111111,0b11111101,0b11100001,0b11100000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b11110000,0b11110111,0b10000111,0b10111100,0b00111101,0b11100001,0b11100000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b11110000,0b11110111,0b10000111,0b10111100,0b00111101,0b11100001,0b11100000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b11110000,0b11110111,0b10000111,0b10111100,0b00111101,0b11100001,0b11100000,0b01111000,0b01111011,0b11011110,0b00000000,
+  0b11111111,0b11110111,0b11111111,0b10111111,0b11111101,0b11100001,0b11100000,0b01111111,0b11111011,0b11011111,0b11000000,
+  0b11111111,0b11110111,0b11111111,0b10111111,0b11111101,0b11100001,0b11100000,0b01111111,0b11111011,0b11011111,0b11000000,
+  0b01111100,0b11110011,0b11110011,0b10011111,0b00111101,0b11100001,0b11100000,0b00111110,0b01111011,0b11001111,0b11000000,
+  0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11000000,
+  0b11111111,0b11111111,0b11111111,0b11111111,0b11111101,0b01101000,0b11011011,0b00010001,0b00011010,0b00110001,0b11000000,
+  0b11111111,0b11111111,0b11111111,0b11111111,0b11111101,0b00101011,0b01011010,0b11111011,0b01101010,0b11101111,0b11000000,
+  0b11111111,0b11111111,0b11111111,0b11111111,0b11111101,0b01001011,0b01011011,0b00111011,0b00011010,0b00110011,0b11000000,
+  0b11111111,0b11111111,0b11111111,0b11111111,0b11111101,0b01101011,0b01011011,0b11011011,0b01101010,0b11111101,0b11000000,
+};
+
+#define splash2_width  115
+#define splash2_height 32
+
+const uint8_t PROGMEM splash2_data[] = {
+  0b00000000,0b00000000,0b01100000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000000,0b11100000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000001,0b11100000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000001,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000011,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000111,0b11110000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00000111,0b11111000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00000000,0b00001111,0b11111000,0b00000000,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,0b01111110,0b00000000,0b00000000,0b00000001,0b11100000,0b00000000,
+  0b01111111,0b00001111,0b11111000,0b00000000,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,0b11111110,0b00000000,0b00000000,0b00000001,0b11100000,0b00000000,
+  0b11111111,0b11101111,0b11111000,0b00000000,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,0b11111110,0b00000000,0b00000000,0b00000001,0b11100000,0b00000000,
+  0b11111111,0b11111111,0b11111000,0b00000000,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,0b11110000,0b00000000,0b00000000,0b00000000,0b00001111,0b00000000,
+  0b01111111,0b11111110,0b01111111,0b11000000,0b00000000,0b00000000,0b00000011,0b11000000,0b00000000,0b11110000,0b00000000,0b00000000,0b00000000,0b00001111,0b00000000,
+  0b00111111,0b11111110,0b01111111,0b11111000,0b00111111,0b11110001,0b11111011,0b11001111,0b11111100,0b11111110,0b11110011,0b10111100,0b00111101,0b11101111,0b11100000,
+  0b00011111,0b11111110,0b01111111,0b11111111,0b01111111,0b11111011,0b11111111,0b11011111,0b11111110,0b11111110,0b11111111,0b10111100,0b00111101,0b11101111,0b11100000,
+  0b00011111,0b11000110,0b11111111,0b11111111,0b01111111,0b11111011,0b11111111,0b11011111,0b11111110,0b11111110,0b11111111,0b10111100,0b00111101,0b11101111,0b11100000,
+  0b00001111,0b11100011,0b11000111,0b11111110,0b01111000,0b01111011,0b11000011,0b11011110,0b00011110,0b11110000,0b11111111,0b10111100,0b00111101,0b11101111,0b00000000,
+  0b00000111,0b11111111,0b10000111,0b11111100,0b01111000,0b01111011,0b11000011,0b11011110,0b00011110,0b11110000,0b11111000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00000001,0b11111111,0b11111111,0b11110000,0b00000000,0b01111011,0b11000011,0b11000000,0b00011110,0b11110000,0b11110000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00000001,0b11110011,0b01111111,0b11100000,0b00111111,0b11111011,0b11000011,0b11001111,0b11111110,0b11110000,0b11110000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00000011,0b11100011,0b00111111,0b10000000,0b01111111,0b11111011,0b11000011,0b11011111,0b11111110,0b11110000,0b11110000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00000111,0b11100111,0b00111100,0b00000000,0b01111000,0b01111011,0b11000011,0b11011110,0b00011110,0b11110000,0b11110000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00000111,0b11111111,0b10111110,0b00000000,0b01111000,0b01111011,0b11000011,0b11011110,0b00011110,0b11110000,0b11110000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00000111,0b11111111,0b11111110,0b00000000,0b01111000,0b01111011,0b11000011,0b11011110,0b00011110,0b11110000,0b11110000,0b00111100,0b00111101,0b11101111,0b00000000,
+  0b00001111,0b11111111,0b11111110,0b00000000,0b01111111,0b11111011,0b11111111,0b11011111,0b11111110,0b11110000,0b11110000,0b00111111,0b11111101,0b11101111,0b11100000,
+  0b00001111,0b11111111,0b11111111,0b00000000,0b01111111,0b11111011,0b11111111,0b11011111,0b11111110,0b11110000,0b11110000,0b00111111,0b11111101,0b11101111,0b11100000,
+  0b00001111,0b11111001,0b11111111,0b00000000,0b00111110,0b01111001,0b11111001,0b11001111,0b10011110,0b11110000,0b11110000,0b00011111,0b00111101,0b11100111,0b11100000,
+  0b00011111,0b11110001,0b11111111,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,0b00000000,
+  0b00011111,0b10000000,0b11111111,0b00000000,0b01111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11111111,0b11100000,
+  0b00011100,0b00000000,0b01111111,0b00000000,0b01111111,0b11111111,0b11111111,0b11111111,0b11111110,0b10110100,0b01101101,0b10001000,0b10001101,0b00011000,0b11100000,
+  0b00000000,0b00000000,0b00011111,0b00000000,0b01111111,0b11111111,0b11111111,0b11111111,0b11111110,0b10010101,0b10101101,0b01111101,0b10110101,0b01110111,0b11100000,
+  0b00000000,0b00000000,0b00001111,0b00000000,0b01111111,0b11111111,0b11111111,0b11111111,0b11111110,0b10100101,0b10101101,0b10011101,0b10001101,0b00011001,0b11100000,
+  0b00000000,0b00000000,0b00000110,0b00000000,0b01111111,0b11111111,0b11111111,0b11111111,0b11111110,0b10110101,0b10101101,0b11101101,0b10110101,0b01111110,0b11100000,
+};
+/* clang-format on */
+#endif
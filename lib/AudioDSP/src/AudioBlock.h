@@ -0,0 +1,74 @@
+/*
+  AudioBlock.h - the unit of work passed between audio processing stages
+
+  A block holds up to AUDIO_BLOCK_FRAMES frames of interleaved int32 samples
+  (L R L R ...) in Q8.23: a 16 bit PCM sample shifted up by 8, so full scale
+  is +/-2^23 and every stage gets 8 bits of headroom above 0 dBFS plus 8
+  bits below the 16 bit LSB for rounding.  Blocks are 16 byte aligned and
+  never allocated per block; stages process them in place.
+
+  AUDIO_BLOCK_FRAMES matches one decoded SBC frame (16 blocks x 8 subbands),
+  which is what the A2DP sink hands to the stream reader each call.
+*/
+
+#ifndef AUDIOBLOCK_H_
+#define AUDIOBLOCK_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef AUDIO_BLOCK_FRAMES
+#define AUDIO_BLOCK_FRAMES      128
+#endif
+#define AUDIO_MAX_CHANNELS      2
+
+#define AUDIO_SAMPLE_SHIFT      8                       // int16 -> Q8.23
+#define AUDIO_FULL_SCALE        (1 << 23)               // 0 dBFS
+#define AUDIO_SAMPLE_MAX        (AUDIO_FULL_SCALE - (1 << AUDIO_SAMPLE_SHIFT))
+#define AUDIO_SAMPLE_MIN        (-AUDIO_FULL_SCALE)
+
+struct AudioBlock {
+  alignas(16) int32_t samples[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];
+  uint16_t frames;            // valid frames, <= AUDIO_BLOCK_FRAMES
+  uint8_t channels;           // 1 or 2
+};
+
+// load interleaved 16 bit PCM into a block; frames is clamped to AUDIO_BLOCK_FRAMES
+static inline void audioBlockFromInt16(AudioBlock &block, const int16_t *pcm, size_t frames, uint8_t channels) {
+  if (frames > AUDIO_BLOCK_FRAMES) frames = AUDIO_BLOCK_FRAMES;
+  block.frames = (uint16_t)frames;
+  block.channels = channels;
+  const size_t n = frames * channels;
+  for (size_t i = 0; i < n; i++) block.samples[i] = (int32_t)pcm[i] << AUDIO_SAMPLE_SHIFT;
+}
+
+// Q8.23 samples to 16 bit PCM, rounding and saturating at full scale
+static inline void audioSamplesToInt16(const int32_t *samples, int16_t *pcm, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    int32_t s = (samples[i] + (1 << (AUDIO_SAMPLE_SHIFT - 1))) >> AUDIO_SAMPLE_SHIFT;
+    if (s > INT16_MAX) s = INT16_MAX;
+    else if (s < INT16_MIN) s = INT16_MIN;
+    pcm[i] = (int16_t)s;
+  }
+}
+
+// the block holds a stage's output with new parameters, from the output with the old ones: ramp linearly from
+// one to the other over the block, so a parameter change never steps
+static inline void audioBlockCrossfade(AudioBlock &block, const int32_t *from) {
+  const uint32_t frames = block.frames;
+  const uint8_t channels = block.channels;
+  int32_t *s = block.samples;
+  for (uint32_t i = 0; i < frames; i++) {
+    const int32_t w = (int32_t)(((i + 1) << 15) / (frames + 1));        // Q15, excluding both ends
+    for (uint8_t c = 0; c < channels; c++, s++, from++) {
+      *s = (int32_t)(*from + ((((int64_t)*s - *from) * w) >> 15));
+    }
+  }
+}
+
+// store a block as interleaved 16 bit PCM
+static inline void audioBlockToInt16(const AudioBlock &block, int16_t *pcm) {
+  audioSamplesToInt16(block.samples, pcm, (size_t)block.frames * block.channels);
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+  AudioPipeline.cpp - ordered chain of AudioStages run on fixed size blocks
+*/
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "AudioPipeline.h"
+
+AudioPipeline::AudioPipeline() : _count(0), _channels(2), _sampleRate(44100) {
+  memset(_stages, 0, sizeof(_stages));
+  resetStats();
+}
+
+bool AudioPipeline::add(AudioStage *stage) {
+  if (!stage || _count >= AUDIO_PIPELINE_MAX_STAGES) return false;
+  _stages[_count++] = stage;
+  stage->begin(_sampleRate, _channels);
+  return true;
+}
+
+AudioStage *AudioPipeline::find(const char *name) const {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (strcmp(_stages[i]->name(), name) == 0) return _stages[i];
+  }
+  return NULL;
+}
+
+void AudioPipeline::begin(uint32_t sampleRate, uint8_t channels) {
+  _sampleRate = sampleRate;
+  _channels = channels;
+  for (uint8_t i = 0; i < _count; i++) _stages[i]->begin(sampleRate, channels);
+}
+
+void AudioPipeline::reset() {
+  for (uint8_t i = 0; i < _count; i++) _stages[i]->reset();
+}
+
+void AudioPipeline::process(AudioBlock &block) {
+  for (uint8_t i = 0; i < _count; i++) {
+    AudioStage *s = _stages[i];
+    if (s->bypassed()) continue;
+    uint32_t start = ESP.getCycleCount();
+    s->process(block);
+    _stats.stageCycles[i] += (uint32_t)(ESP.getCycleCount() - start);
+  }
+  _stats.blocks++;
+  _stats.frames += block.frames;
+}
+
+void AudioPipeline::process(const int16_t *in, int16_t *out, size_t frames) {
+  while (frames) {
+    size_t n = frames > AUDIO_BLOCK_FRAMES ? AUDIO_BLOCK_FRAMES : frames;
+    audioBlockFromInt16(_block, in, n, _channels);
+    process(_block);
+    audioBlockToInt16(_block, out);
+    in += n * _channels;
+    out += n * _channels;
+    frames -= n;
+  }
+}
+
+void AudioPipeline::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+}
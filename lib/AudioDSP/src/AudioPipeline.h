@@ -0,0 +1,54 @@
+/*
+  AudioPipeline.h - ordered chain of AudioStages run on fixed size blocks
+
+  The chain is assembled once at start up (add() is not safe while audio is
+  flowing) and owns no memory: stages are supplied by the caller and the
+  only buffer is the block passed to process().  Per stage cycle counts are
+  accumulated with the CPU cycle counter so the same numbers can be read on
+  the board and in the host harness.
+*/
+
+#ifndef AUDIOPIPELINE_H_
+#define AUDIOPIPELINE_H_
+
+#include "AudioStage.h"
+
+#define AUDIO_PIPELINE_MAX_STAGES   12
+
+struct AudioPipelineStats {
+  uint32_t blocks;                                  // blocks processed since resetStats()
+  uint64_t frames;                                  // frames processed since resetStats()
+  uint64_t stageCycles[AUDIO_PIPELINE_MAX_STAGES];  // cycles spent in each stage
+};
+
+class AudioPipeline {
+  public:
+    AudioPipeline();
+
+    bool add(AudioStage *stage);                    // false if the chain is full
+    uint8_t stages() const { return _count; }
+    AudioStage *stage(uint8_t index) const { return index < _count ? _stages[index] : NULL; }
+    AudioStage *find(const char *name) const;
+
+    void begin(uint32_t sampleRate, uint8_t channels);
+    void reset();
+    uint32_t sampleRate() const { return _sampleRate; }
+    uint8_t channels() const { return _channels; }
+
+    void process(AudioBlock &block);
+    // runs interleaved 16 bit PCM through the chain block by block; in and out may alias
+    void process(const int16_t *in, int16_t *out, size_t frames);
+
+    const AudioPipelineStats &stats() const { return _stats; }
+    void resetStats();
+
+  private:
+    AudioStage *_stages[AUDIO_PIPELINE_MAX_STAGES];
+    uint8_t _count;
+    uint8_t _channels;
+    uint32_t _sampleRate;
+    AudioBlock _block;
+    AudioPipelineStats _stats;
+};
+
+#endif
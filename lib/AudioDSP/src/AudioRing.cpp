@@ -0,0 +1,118 @@
+/*
+  AudioRing.cpp - lock-free single-producer/single-consumer ring of PCM frames
+*/
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+#include "AudioRing.h"
+
+AudioRing::AudioRing()
+  : _buf(NULL), _mask(0), _channels(2), _psram(false), _head(0), _tail(0),
+    _highWater(0), _overruns(0), _droppedFrames(0), _underruns(0) {
+}
+
+AudioRing::~AudioRing() {
+  end();
+}
+
+bool AudioRing::begin(size_t frames, uint8_t channels, bool psram) {
+  end();
+  size_t size = 1;
+  while (size < frames) size <<= 1;
+  size_t bytes = size * channels * sizeof(int16_t);
+
+  _psram = psram && psramFound();
+  if (_psram) _buf = (int16_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!_buf) {
+    _psram = false;
+    _buf = (int16_t *)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  }
+  if (!_buf) {
+    log_e("no memory for a %u frame audio ring", (unsigned)size);
+    return false;
+  }
+  _mask = (uint32_t)size - 1;
+  _channels = channels;
+  _head.store(0, std::memory_order_relaxed);
+  _tail.store(0, std::memory_order_relaxed);
+  resetStats();
+  return true;
+}
+
+void AudioRing::end() {
+  if (_buf) heap_caps_free(_buf);
+  _buf = NULL;
+  _mask = 0;
+}
+
+size_t AudioRing::available() const {
+  return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_relaxed);
+}
+
+size_t AudioRing::space() const {
+  return _buf ? capacity() - (_head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_acquire)) : 0;
+}
+
+size_t AudioRing::write(const int16_t *pcm, size_t frames) {
+  if (!_buf) return 0;
+  const uint32_t head = _head.load(std::memory_order_relaxed);
+  const uint32_t tail = _tail.load(std::memory_order_acquire);
+  const size_t room = capacity() - (head - tail);
+  size_t n = frames;
+  if (n > room) {
+    _overruns = _overruns + 1;
+    _droppedFrames = _droppedFrames + (uint32_t)(n - room);
+    n = room;
+  }
+
+  // copy in at most two pieces: up to the end of the buffer, then from the start
+  const size_t start = head & _mask;
+  const size_t first = (n < capacity() - start) ? n : capacity() - start;
+  memcpy(_buf + start * _channels, pcm, first * _channels * sizeof(int16_t));
+  memcpy(_buf, pcm + first * _channels, (n - first) * _channels * sizeof(int16_t));
+  _head.store(head + (uint32_t)n, std::memory_order_release);
+
+  const uint32_t fill = head + (uint32_t)n - tail;
+  if (fill > _highWater) _highWater = fill;
+  return n;
+}
+
+size_t AudioRing::read(int16_t *pcm, size_t frames) {
+  if (!_buf) return 0;
+  const uint32_t tail = _tail.load(std::memory_order_relaxed);
+  const uint32_t head = _head.load(std::memory_order_acquire);
+  size_t n = head - tail;
+  if (n > frames) n = frames;
+
+  const size_t start = tail & _mask;
+  const size_t first = (n < capacity() - start) ? n : capacity() - start;
+  memcpy(pcm, _buf + start * _channels, first * _channels * sizeof(int16_t));
+  memcpy(pcm + first * _channels, _buf, (n - first) * _channels * sizeof(int16_t));
+  _tail.store(tail + (uint32_t)n, std::memory_order_release);
+  return n;
+}
+
+void AudioRing::clear() {
+  _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+AudioRingStats AudioRing::stats() const {
+  AudioRingStats s;
+  s.capacity = _buf ? (uint32_t)capacity() : 0;
+  s.fill = (uint32_t)available();
+  s.highWater = _highWater;
+  s.overruns = _overruns;
+  s.droppedFrames = _droppedFrames;
+  s.underruns = _underruns;
+  s.psram = _psram;
+  return s;
+}
+
+void AudioRing::resetStats() {
+  _highWater = 0;
+  _overruns = 0;
+  _droppedFrames = 0;
+  _underruns = 0;
+}
@@ -0,0 +1,68 @@
+/*
+  AudioRing.h - lock-free single-producer/single-consumer ring of PCM frames
+
+  One task writes (the A2DP data callback), one task reads (the I2S writer);
+  neither ever blocks or takes a lock.  The read and write positions are
+  free-running 32 bit counters, published with release/acquire ordering, and
+  the capacity is a power of two so wrapping is a mask.  Storage is
+  allocated once in begin(), from PSRAM if asked for and present, otherwise
+  from internal RAM.
+
+  Overruns and the high-water mark are recorded by the producer, underruns
+  by the consumer through noteUnderrun(); each counter has a single writer.
+*/
+
+#ifndef AUDIORING_H_
+#define AUDIORING_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+struct AudioRingStats {
+  uint32_t capacity;          // frames
+  uint32_t fill;              // frames queued right now
+  uint32_t highWater;         // most frames ever queued since resetStats()
+  uint32_t overruns;          // writes that did not fit
+  uint32_t droppedFrames;     // frames lost to overruns
+  uint32_t underruns;         // times the consumer ran dry while audio was expected
+  bool psram;                 // storage is in PSRAM
+};
+
+class AudioRing {
+  public:
+    AudioRing();
+    ~AudioRing();
+
+    bool begin(size_t frames, uint8_t channels = 2, bool psram = false);   // frames is rounded up to a power of two
+    void end();
+
+    size_t capacity() const { return _mask + 1; }
+    size_t available() const;                   // frames ready to read
+    size_t space() const;                       // frames that can be written
+
+    // producer side; writes what fits and drops the rest
+    size_t write(const int16_t *pcm, size_t frames);
+
+    // consumer side
+    size_t read(int16_t *pcm, size_t frames);
+    void noteUnderrun() { _underruns = _underruns + 1; }
+    void clear();
+
+    AudioRingStats stats() const;
+    void resetStats();
+
+  private:
+    int16_t *_buf;
+    uint32_t _mask;
+    uint8_t _channels;
+    bool _psram;
+    std::atomic<uint32_t> _head;                // written by the producer
+    std::atomic<uint32_t> _tail;                // written by the consumer
+    volatile uint32_t _highWater;
+    volatile uint32_t _overruns;
+    volatile uint32_t _droppedFrames;
+    volatile uint32_t _underruns;
+};
+
+#endif
@@ -0,0 +1,37 @@
+/*
+  AudioStage.h - interface for one step of the audio processing chain
+
+  process() runs on the audio task for every block and must not allocate,
+  block or log.  begin() is called whenever the stream format changes (new
+  connection, new sample rate) and reset() when the stream restarts so a
+  stage can drop filter state and delay lines.  Parameter setters are called
+  from other tasks; stages keep them to single word stores the audio task
+  picks up at the next block, or publish whole coefficient sets through a
+  ParamStore.  No mutex is ever taken on the audio task.
+*/
+
+#ifndef AUDIOSTAGE_H_
+#define AUDIOSTAGE_H_
+
+#include "AudioBlock.h"
+
+class AudioStage {
+  public:
+    virtual ~AudioStage() {}
+
+    virtual const char *name() const = 0;
+    virtual void begin(uint32_t sampleRate, uint8_t channels) {
+      (void)sampleRate;
+      (void)channels;
+    }
+    virtual void reset() {}
+    virtual void process(AudioBlock &block) = 0;
+
+    void setBypass(bool bypass) { _bypass = bypass; }
+    bool bypassed() const { return _bypass; }
+
+  protected:
+    volatile bool _bypass = false;
+};
+
+#endif
@@ -0,0 +1,154 @@
+/*
+  Concealer.cpp - covers gaps in the A2DP stream with audio continued from before them
+*/
+
+#include <math.h>
+
+#include "Concealer.h"
+
+#define CONCEAL_MASK        (CONCEAL_HISTORY_FRAMES - 1)
+#define CONCEAL_UNITY       (1 << 16)               // envelope gain, Q16
+#define CONCEAL_MIX_SHIFT   15                      // cross-fade weights, Q15
+
+Concealer::Concealer()
+  : _head(0), _filled(0), _minPeriod(0), _maxPeriod(0), _overlap(0), _hold(0), _fade(1), _active(false), _phase(0),
+    _position(0), _period(0), _concealedFrames(0), _gaps(0) {
+  begin(44100);
+}
+
+void Concealer::begin(uint32_t sampleRate) {
+  _minPeriod = (uint32_t)(sampleRate * CONCEAL_MIN_PERIOD_MS / 1000.0f);
+  _maxPeriod = (uint32_t)(sampleRate * CONCEAL_MAX_PERIOD_MS / 1000.0f);
+  if (_maxPeriod > CONCEAL_HISTORY_FRAMES - CONCEAL_MATCH_FRAMES) _maxPeriod = CONCEAL_HISTORY_FRAMES - CONCEAL_MATCH_FRAMES;
+  _overlap = (uint32_t)(sampleRate * CONCEAL_OVERLAP_MS / 1000.0f);
+  if (_overlap > _minPeriod) _overlap = _minPeriod;
+  if (_overlap > AUDIO_BLOCK_FRAMES) _overlap = AUDIO_BLOCK_FRAMES;
+  _hold = sampleRate * CONCEAL_HOLD_MS / 1000;
+  _fade = sampleRate * CONCEAL_FADE_MS / 1000;
+  reset();
+}
+
+void Concealer::reset() {
+  _head = 0;
+  _filled = 0;
+  _active = false;
+}
+
+void Concealer::resetStats() {
+  _concealedFrames = 0;
+  _gaps = 0;
+}
+
+// left + right, the given number of frames before the newest
+inline int32_t Concealer::mono(uint32_t back) const {
+  const int16_t *f = _history + ((_head - back) & CONCEAL_MASK) * 2;
+  return (int32_t)f[0] + f[1];
+}
+
+// the period whose preceding audio looks most like the end of the history: normalised cross-correlation, compared
+// as c * |c| / energy so no square root is needed
+bool Concealer::search() {
+  if (_filled < _minPeriod + CONCEAL_MATCH_FRAMES) return false;
+  uint32_t longest = _filled - CONCEAL_MATCH_FRAMES;
+  if (longest > _maxPeriod) longest = _maxPeriod;
+
+  uint32_t best = longest;
+  float bestScore;
+  for (int pass = 0; pass < 2; pass++) {
+    // the first pass looks at every CONCEAL_DECIMATION-th frame and period, the second at all of them near the best
+    const uint32_t step = pass ? 1 : CONCEAL_DECIMATION, near = CONCEAL_DECIMATION - 1;
+    const uint32_t from = pass && best >= _minPeriod + near ? best - near : _minPeriod;
+    const uint32_t to = pass && best + near < longest ? best + near : longest;
+    bestScore = -INFINITY;
+    for (uint32_t period = from; period <= to; period += step) {
+      int64_t correlation = 0, energy = 0;
+      for (uint32_t j = 1; j <= CONCEAL_MATCH_FRAMES; j += step) {
+        const int32_t a = mono(j), b = mono(j + period);
+        correlation += (int64_t)a * b;
+        energy += (int64_t)b * b;
+      }
+      if (!energy) continue;
+      const float c = (float)correlation, score = c * fabsf(c) / (float)energy;
+      if (score > bestScore) {
+        bestScore = score;
+        best = period;
+      }
+    }
+  }
+  _period = best;
+  return true;
+}
+
+// full level for the hold time, then a linear fade, Q16
+inline int32_t Concealer::envelope() const {
+  if (_position < _hold) return CONCEAL_UNITY;
+  if (_position >= _hold + _fade) return 0;
+  return (int32_t)((uint64_t)(_hold + _fade - _position) * CONCEAL_UNITY / _fade);
+}
+
+// the period that followed the match, over and over; its last frames blend into the audio that led up to the
+// match, so looping back to its start is continuous
+void Concealer::synthesize(int32_t *out, uint16_t frames) {
+  const uint32_t period = _period, seam = period - _overlap;
+  for (uint16_t i = 0; i < frames; i++, out += 2) {
+    const int32_t gain = envelope();
+    const int16_t *a = _history + ((_head - (period - _phase)) & CONCEAL_MASK) * 2;
+    for (uint8_t c = 0; c < 2; c++) {
+      int32_t v = a[c];
+      if (_phase >= seam) {
+        const int16_t *b = _history + ((_head - (2 * period - _phase)) & CONCEAL_MASK) * 2;
+        const int32_t w = (int32_t)(((_phase - seam + 1) << CONCEAL_MIX_SHIFT) / (_overlap + 1));
+        v += (int32_t)(((int64_t)(b[c] - v) * w) >> CONCEAL_MIX_SHIFT);
+      }
+      out[c] = (int32_t)(((int64_t)(v << AUDIO_SAMPLE_SHIFT) * gain) >> 16);
+    }
+    if (++_phase == period) _phase = 0;
+    _position++;
+  }
+}
+
+bool Concealer::conceal(AudioBlock &block) {
+  if (!_active) {
+    if (!search()) return false;
+    _active = true;
+    _phase = 0;
+    _position = 0;
+    _gaps = _gaps + 1;
+  }
+  if (_position >= _hold + _fade) return false;          // faded out: the rest of the gap is silence anyway
+
+  block.frames = AUDIO_BLOCK_FRAMES;
+  block.channels = 2;
+  synthesize(block.samples, AUDIO_BLOCK_FRAMES);
+  _concealedFrames = _concealedFrames + AUDIO_BLOCK_FRAMES;
+  return true;
+}
+
+void Concealer::process(AudioBlock &block) {
+  const uint8_t ch = block.channels;
+  int32_t *s = block.samples;
+
+  if (_active) {
+    // cross-fade from where the repetition would have gone on to the stream
+    const uint16_t frames = block.frames < _overlap ? block.frames : (uint16_t)_overlap;
+    for (uint16_t i = 0; i < frames; i++) {
+      int32_t continued[2];
+      synthesize(continued, 1);
+      const int32_t w = (int32_t)(((uint32_t)(i + 1) << CONCEAL_MIX_SHIFT) / (frames + 1));
+      for (uint8_t c = 0; c < ch; c++) {
+        const int32_t from = continued[ch == 2 ? c : 0];
+        s[i * ch + c] = from + (int32_t)(((int64_t)(s[i * ch + c] - from) * w) >> CONCEAL_MIX_SHIFT);
+      }
+    }
+    _active = false;
+  }
+
+  // what was played is what the next gap continues
+  for (uint16_t i = 0; i < block.frames; i++, s += ch) {
+    int16_t *f = _history + (_head & CONCEAL_MASK) * 2;
+    audioSamplesToInt16(s, f, ch);
+    if (ch == 1) f[1] = f[0];
+    _head++;
+  }
+  _filled = _filled + block.frames < CONCEAL_HISTORY_FRAMES ? _filled + block.frames : CONCEAL_HISTORY_FRAMES;
+}
@@ -0,0 +1,82 @@
+/*
+  Concealer.h - covers gaps in the A2DP stream with audio continued from before them
+
+  When the shared radio is busy with wifi, SBC frames arrive late and the
+  jitter buffer can run dry.  Instead of letting the DMA play silence the
+  consumer asks conceal() for blocks until the stream is back.
+  Concealment is a waveform similarity search: at the start of a gap, the
+  last CONCEAL_MATCH_FRAMES of the history are compared with every earlier
+  position CONCEAL_MIN_PERIOD_MS..CONCEAL_MAX_PERIOD_MS back, first on a
+  decimated mono mix and then refined around the best match.  The audio
+  that followed that match is then repeated for as long as the gap lasts,
+  one period at a time.  The end of each period is overlap-added into the
+  audio that led up to the match, so the loop has no seam.  The repetition
+  plays at full level for CONCEAL_HOLD_MS and fades to silence over
+  CONCEAL_FADE_MS; longer gaps are silent.
+
+  The first block from the stream after a gap cross-fades from the
+  continued audio back to the real audio over CONCEAL_OVERLAP_MS, or fades
+  in if the concealment had already faded out.  Every block the consumer
+  plays goes through process() to keep the history; reset() forgets it
+  when the stream is not continuous (a new stream, or after idling).
+
+  All of it runs on the consumer task; the counters may be read from any
+  task.
+*/
+
+#ifndef CONCEALER_H_
+#define CONCEALER_H_
+
+#include "AudioBlock.h"
+
+#define CONCEAL_HISTORY_FRAMES  2048            // power of two; 16 bit stereo, 8 KB
+#define CONCEAL_MATCH_FRAMES    256             // template the search compares
+#define CONCEAL_DECIMATION      4               // coarse search step
+#define CONCEAL_MIN_PERIOD_MS   2.5f
+#define CONCEAL_MAX_PERIOD_MS   20.0f           // with the match it must fit the history
+#define CONCEAL_OVERLAP_MS      2.0f            // loop seam and cross-fade back
+#define CONCEAL_HOLD_MS         30
+#define CONCEAL_FADE_MS         50
+
+class Concealer {
+  public:
+    Concealer();
+
+    void begin(uint32_t sampleRate);
+    void reset();                               // forget the history
+
+    // consumer
+    void process(AudioBlock &block);            // a block from the stream: ends a gap, then joins the history
+    bool conceal(AudioBlock &block);            // fills a block of the gap; false if there is nothing to continue
+    bool concealing() const { return _active; }
+
+    // metrics
+    uint32_t concealedFrames() const { return _concealedFrames; }
+    uint32_t gaps() const { return _gaps; }
+    uint32_t period() const { return _period; }     // frames repeated in the last gap
+    void resetStats();
+
+  private:
+    int32_t mono(uint32_t back) const;
+    bool search();
+    void synthesize(int32_t *out, uint16_t frames);
+    int32_t envelope() const;
+
+    int16_t _history[CONCEAL_HISTORY_FRAMES * 2];
+    uint32_t _head;                             // frames written, free running
+    uint32_t _filled;                           // frames of history, up to CONCEAL_HISTORY_FRAMES
+
+    uint32_t _minPeriod, _maxPeriod;            // frames
+    uint32_t _overlap;
+    uint32_t _hold, _fade;
+
+    bool _active;                               // in a gap
+    uint32_t _phase;                            // frame within the period
+    uint32_t _position;                         // frames since the gap started
+
+    volatile uint32_t _period;
+    volatile uint32_t _concealedFrames;
+    volatile uint32_t _gaps;
+};
+
+#endif
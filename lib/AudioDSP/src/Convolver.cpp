@@ -0,0 +1,344 @@
+/*
+  Convolver.cpp - long FIR filters (room correction) by partitioned FFT convolution
+*/
+
+#include <esp_heap_caps.h>
+#include <math.h>
+#include <string.h>
+
+#include "Convolver.h"
+
+#define SPECTRUM_FLOATS     (2 * CONVOLVER_BINS)
+
+// one filter and the input delay line that goes with its partition count, in a single allocation
+struct ConvolverFilter {
+  uint32_t sampleRate;
+  uint16_t partitions;
+  uint8_t channels;               // impulse responses; one serves both channels
+  float *spectra;                 // [channels][partitions][SPECTRUM_FLOATS], scaled for the inverse FFT
+  float *delay;                   // [AUDIO_MAX_CHANNELS][partitions][SPECTRUM_FLOATS] input spectra
+};
+
+float Convolver::_cos[CONVOLVER_BINS];
+float Convolver::_sin[CONVOLVER_BINS];
+
+Convolver::Convolver()
+  : _pending(NULL), _retired(NULL), _taps(0), _filterRate(0), _filter(NULL), _sampleRate(44100), _busy(false),
+    _start(NULL), _done(NULL), _worker(NULL), _stop(false), _channels(2), _partitions(0), _newest(0), _busyUs(0), _measured(0),
+    _load(0.0f), _late(0), _fallbacks(0) {
+  initTables();
+  clear();
+}
+
+Convolver::~Convolver() {
+  if (_worker) {
+    // let the worker finish and end itself; its semaphores must outlive the wait
+    waitForWorker();
+    _stop = true;
+    xSemaphoreGive(_start);
+    xSemaphoreTake(_done, portMAX_DELAY);
+  }
+  if (_start) vSemaphoreDelete(_start);
+  if (_done) vSemaphoreDelete(_done);
+  heap_caps_free(_filter);
+  heap_caps_free(_pending.exchange(NULL));
+  heap_caps_free(_retired.exchange(NULL));
+}
+
+void Convolver::initTables() {
+  if (_cos[0] != 0.0f) return;
+  for (int k = 0; k < CONVOLVER_BINS; k++) {
+    _cos[k] = cosf(2.0f * (float)M_PI * k / CONVOLVER_FFT_SIZE);
+    _sin[k] = -sinf(2.0f * (float)M_PI * k / CONVOLVER_FFT_SIZE);
+  }
+}
+
+bool Convolver::startWorker(uint8_t core, UBaseType_t priority, uint32_t stack) {
+  if (_worker) return true;
+  _start = xSemaphoreCreateBinary();
+  _done = xSemaphoreCreateBinary();
+  if (!_start || !_done) return false;
+  return xTaskCreatePinnedToCore(workerTask, "convolver", stack, this, priority, &_worker, core) == pdPASS;
+}
+
+
+// ----------------------------------------------------------------
+//                      -control side
+// ----------------------------------------------------------------
+
+static ConvolverFilter *allocFilter(uint16_t partitions, uint8_t channels, bool psram) {
+  const size_t bytes = sizeof(ConvolverFilter) + (size_t)(channels + AUDIO_MAX_CHANNELS) * partitions * SPECTRUM_FLOATS * sizeof(float);
+  void *p = NULL;
+  if (psram && psramFound()) p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!p) p = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!p) return NULL;
+  ConvolverFilter *f = (ConvolverFilter *)p;
+  f->partitions = partitions;
+  f->channels = channels;
+  f->spectra = (float *)(f + 1);
+  f->delay = f->spectra + (size_t)channels * partitions * SPECTRUM_FLOATS;
+  return f;
+}
+
+bool Convolver::setFilter(const float *const *ir, uint8_t channels, size_t taps, uint32_t sampleRate, bool psram) {
+  if (!ir || channels < 1 || channels > AUDIO_MAX_CHANNELS || !taps) return false;
+  if (taps > CONVOLVER_MAX_TAPS) taps = CONVOLVER_MAX_TAPS;
+
+  // less memory than the whole response needs: keep its start
+  uint16_t partitions = (uint16_t)((taps + CONVOLVER_PARTITION - 1) / CONVOLVER_PARTITION);
+  ConvolverFilter *f;
+  while (!(f = allocFilter(partitions, channels, psram))) {
+    if (partitions == 1) {
+      log_e("no memory for a %u tap filter", (unsigned)taps);
+      return false;
+    }
+    partitions /= 2;
+  }
+  if ((size_t)partitions * CONVOLVER_PARTITION < taps) {
+    log_w("%u tap filter shortened to %u taps to fit in memory", (unsigned)taps, (unsigned)partitions * CONVOLVER_PARTITION);
+    taps = (size_t)partitions * CONVOLVER_PARTITION;
+  }
+  f->sampleRate = sampleRate;
+
+  // each partition zero padded to the FFT size; 1/CONVOLVER_BINS is the inverse FFT's scaling
+  float x[CONVOLVER_FFT_SIZE];
+  for (uint8_t c = 0; c < channels; c++) {
+    for (uint16_t p = 0; p < partitions; p++) {
+      memset(x, 0, sizeof(x));
+      for (size_t i = 0, t = (size_t)p * CONVOLVER_PARTITION; i < CONVOLVER_PARTITION && t < taps; i++, t++) {
+        x[i] = ir[c][t] * (1.0f / CONVOLVER_BINS);
+      }
+      forward(x, f->spectra + ((size_t)c * partitions + p) * SPECTRUM_FLOATS);
+    }
+  }
+  memset(f->delay, 0, (size_t)AUDIO_MAX_CHANNELS * partitions * SPECTRUM_FLOATS * sizeof(float));
+
+  heap_caps_free(_pending.exchange(f, std::memory_order_acq_rel));     // one the audio side never picked up
+  _taps = taps;
+  _filterRate = sampleRate;
+  return true;
+}
+
+void Convolver::update() {
+  heap_caps_free(_retired.exchange(NULL, std::memory_order_acquire));
+}
+
+bool Convolver::active() const {
+  return !bypassed() && _filterRate == _sampleRate && _worker;
+}
+
+void Convolver::resetStats() {
+  _late = 0;
+  _fallbacks = 0;
+}
+
+
+// ----------------------------------------------------------------
+//                      -audio side
+// ----------------------------------------------------------------
+
+void Convolver::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _sampleRate = sampleRate;
+  reset();
+}
+
+void Convolver::reset() {
+  waitForWorker();
+  clear();
+}
+
+// the worker is idle here
+void Convolver::clear() {
+  memset(_history, 0, sizeof(_history));
+  memset(_out, 0, sizeof(_out));
+  if (_filter) memset(_filter->delay, 0, (size_t)AUDIO_MAX_CHANNELS * _filter->partitions * SPECTRUM_FLOATS * sizeof(float));
+  _newest = 0;
+}
+
+void Convolver::waitForWorker() {
+  if (!_busy) return;
+  if (xSemaphoreTake(_done, 0) != pdTRUE) {
+    _late = _late + 1;
+    xSemaphoreTake(_done, portMAX_DELAY);
+  }
+  _busy = false;
+}
+
+void Convolver::process(AudioBlock &block) {
+  // take over a new filter once the control side has freed the one before the last
+  if (_pending.load(std::memory_order_acquire) && !_retired.load(std::memory_order_acquire)) {
+    waitForWorker();
+    ConvolverFilter *f = _pending.exchange(NULL, std::memory_order_acq_rel);
+    if (f) {
+      _retired.store(_filter, std::memory_order_release);
+      _filter = f;
+      _partitions = f->partitions;
+      _busyUs = 0;
+      _measured = 0;
+      clear();
+    }
+  }
+
+  const ConvolverFilter *f = _filter;
+  if (!f || f->sampleRate != _sampleRate || !_worker) return;
+
+  // the worker's result for the previous block out, this block in
+  waitForWorker();
+  const size_t count = (size_t)block.frames * block.channels;
+  memcpy(_in, block.samples, count * sizeof(int32_t));
+  memset(_in + count, 0, (CONVOLVER_PARTITION * block.channels - count) * sizeof(int32_t));
+  memcpy(block.samples, _out, count * sizeof(int32_t));
+  _channels = block.channels;
+  _busy = true;
+  xSemaphoreGive(_start);
+}
+
+
+// ----------------------------------------------------------------
+//                      -worker
+// ----------------------------------------------------------------
+
+void Convolver::workerTask(void *arg) {
+  static_cast<Convolver *>(arg)->work();
+}
+
+void Convolver::work() {
+  for (;;) {
+    xSemaphoreTake(_start, portMAX_DELAY);
+    if (_stop) break;
+    const uint32_t t0 = micros();
+    convolve(_filter);
+    _busyUs += micros() - t0;
+
+    // over budget: use half the partitions, which drops the later half of the impulse response
+    if (++_measured == CONVOLVER_BUDGET_BLOCKS) {
+      const float periodUs = (float)CONVOLVER_PARTITION * 1e6f / _sampleRate;
+      _load = 100.0f * _busyUs / (CONVOLVER_BUDGET_BLOCKS * periodUs);
+      if (_load > CONVOLVER_BUDGET_PERCENT && _partitions > 1) {
+        _partitions = _partitions / 2;
+        _fallbacks = _fallbacks + 1;
+        log_w("convolver at %.0f%% of its budget: filter shortened to %u taps", _load,
+              (unsigned)_partitions * CONVOLVER_PARTITION);
+      }
+      _busyUs = 0;
+      _measured = 0;
+    }
+    xSemaphoreGive(_done);
+  }
+  xSemaphoreGive(_done);
+  vTaskDelete(NULL);
+}
+
+void Convolver::convolve(ConvolverFilter *f) {
+  const uint16_t stride = f->partitions, used = _partitions;
+  const uint8_t ch = _channels;
+  _newest = (_newest + 1) % stride;
+
+  for (uint8_t c = 0; c < ch; c++) {
+    // overlap-save: the previous block and this one
+    float *h = _history[c];
+    memmove(h, h + CONVOLVER_PARTITION, CONVOLVER_PARTITION * sizeof(float));
+    for (int i = 0; i < CONVOLVER_PARTITION; i++) h[CONVOLVER_PARTITION + i] = (float)_in[i * ch + c];
+    float *delay = f->delay + (size_t)c * stride * SPECTRUM_FLOATS;
+    forward(h, delay + (size_t)_newest * SPECTRUM_FLOATS);
+
+    // newest input against the first partition, the one before against the second, ...
+    const float *spectra = f->spectra + (f->channels == 1 ? 0 : (size_t)c * stride * SPECTRUM_FLOATS);
+    float *acc = _spectrum;
+    memset(acc, 0, sizeof(_spectrum));
+    uint32_t slot = _newest;
+    for (uint16_t p = 0; p < used; p++) {
+      const float *x = delay + (size_t)slot * SPECTRUM_FLOATS, *y = spectra + (size_t)p * SPECTRUM_FLOATS;
+      acc[0] += x[0] * y[0];                      // DC and Nyquist are real
+      acc[1] += x[1] * y[1];
+      for (int k = 2; k < SPECTRUM_FLOATS; k += 2) {
+        acc[k] += x[k] * y[k] - x[k + 1] * y[k + 1];
+        acc[k + 1] += x[k] * y[k + 1] + x[k + 1] * y[k];
+      }
+      slot = slot ? slot - 1 : stride - 1;
+    }
+
+    // the second half is the linear convolution, the first half wrapped around
+    inverse(acc, _time);
+    for (int i = 0; i < CONVOLVER_PARTITION; i++) {
+      const float v = _time[CONVOLVER_PARTITION + i];
+      _out[i * ch + c] = v >= 2147483520.0f ? INT32_MAX : v <= -2147483648.0f ? INT32_MIN : (int32_t)lrintf(v);
+    }
+  }
+}
+
+
+// ----------------------------------------------------------------
+//                          -fft
+// ----------------------------------------------------------------
+
+// in-place radix-2 complex FFT of CONVOLVER_BINS points
+void Convolver::fft(float *re, float *im) {
+  for (int i = 1, j = 0; i < CONVOLVER_BINS; i++) {
+    int bit = CONVOLVER_BINS >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j |= bit;
+    if (i < j) {
+      float t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+  for (int len = 2; len <= CONVOLVER_BINS; len <<= 1) {
+    const int stride = CONVOLVER_FFT_SIZE / len;            // twiddle step in the N point table
+    for (int start = 0; start < CONVOLVER_BINS; start += len) {
+      for (int k = 0; k < len / 2; k++) {
+        const float wr = _cos[k * stride], wi = _sin[k * stride];
+        const int a = start + k, b = a + len / 2;
+        const float tr = re[b] * wr - im[b] * wi;
+        const float ti = re[b] * wi + im[b] * wr;
+        re[b] = re[a] - tr;
+        im[b] = im[a] - ti;
+        re[a] += tr;
+        im[a] += ti;
+      }
+    }
+  }
+}
+
+// real FFT of CONVOLVER_FFT_SIZE samples: the even/odd samples as one half-size complex FFT, then a split pass;
+// out holds bins 0..CONVOLVER_BINS-1 as re, im pairs with the (real) Nyquist bin in bin 0's imaginary part
+void Convolver::forward(const float *x, float *out) {
+  float re[CONVOLVER_BINS], im[CONVOLVER_BINS];
+  for (int n = 0; n < CONVOLVER_BINS; n++) {
+    re[n] = x[2 * n];
+    im[n] = x[2 * n + 1];
+  }
+  fft(re, im);
+  out[0] = re[0] + im[0];
+  out[1] = re[0] - im[0];
+  for (int k = 1; k < CONVOLVER_BINS; k++) {
+    const int m = CONVOLVER_BINS - k;
+    const float er = 0.5f * (re[k] + re[m]), ei = 0.5f * (im[k] - im[m]);
+    const float or_ = 0.5f * (im[k] + im[m]), oi = -0.5f * (re[k] - re[m]);
+    out[2 * k] = er + or_ * _cos[k] - oi * _sin[k];
+    out[2 * k + 1] = ei + or_ * _sin[k] + oi * _cos[k];
+  }
+}
+
+// the reverse of forward(), unscaled (CONVOLVER_BINS times the signal): merge the halves again, then an inverse
+// FFT done as a forward one on the conjugate
+void Convolver::inverse(const float *in, float *x) {
+  float re[CONVOLVER_BINS], im[CONVOLVER_BINS];
+  re[0] = 0.5f * (in[0] + in[1]);
+  im[0] = -0.5f * (in[0] - in[1]);
+  for (int k = 1; k < CONVOLVER_BINS; k++) {
+    const int m = CONVOLVER_BINS - k;
+    const float ar = in[2 * k], ai = in[2 * k + 1], br = in[2 * m], bi = -in[2 * m + 1];
+    const float er = 0.5f * (ar + br), ei = 0.5f * (ai + bi);
+    const float dr = 0.5f * (ar - br), di = 0.5f * (ai - bi);
+    const float or_ = dr * _cos[k] + di * _sin[k], oi = di * _cos[k] - dr * _sin[k];
+    re[k] = er - oi;
+    im[k] = -(ei + or_);
+  }
+  fft(re, im);
+  for (int n = 0; n < CONVOLVER_BINS; n++) {
+    x[2 * n] = re[n];
+    x[2 * n + 1] = -im[n];
+  }
+}
@@ -0,0 +1,127 @@
+/*
+  Convolver.h - long FIR filters (room correction) by partitioned FFT convolution
+
+  Uniformly partitioned overlap-save: the impulse response is cut into
+  partitions of one block (CONVOLVER_PARTITION frames), and each partition's
+  spectrum is computed once, when the filter is set.  Per block and channel
+  the work is one real FFT of the last two blocks of input, stored in a
+  frequency domain delay line holding one spectrum per partition, a
+  complex multiply-accumulate of the delay line against the partition
+  spectra, and one inverse FFT.  The second half of the result is the
+  output; the first half is circular wrap-around and is discarded.  For
+  4096 taps that is about 7 M multiplies per second and channel at 44.1
+  kHz, where direct form would need 180 M.  The partition spectra have the
+  inverse FFT's scaling folded in.
+
+  The convolution runs on a worker task, normally on the other core:
+  process() hands the block to the worker and returns the result of the
+  previous block, so the stage adds one block of latency.  The worker
+  times itself.  When it averages more than CONVOLVER_BUDGET_PERCENT of
+  the block period over CONVOLVER_BUDGET_BLOCKS, it halves the number of
+  partitions it uses, which truncates the impulse response.  It keeps
+  halving, down to one partition, until the load fits.
+
+  setFilter() (control task) builds the spectra of a new filter, in PSRAM
+  if asked for and present, and hands it over without stopping the audio;
+  update() frees the filter it replaced.  One impulse response serves both
+  channels, or there is one per channel.  A filter designed for another
+  sample rate than the stream's is left alone: the stage passes audio
+  through until the rates match.
+*/
+
+#ifndef CONVOLVER_H_
+#define CONVOLVER_H_
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "AudioStage.h"
+
+#define CONVOLVER_PARTITION         AUDIO_BLOCK_FRAMES      // frames per partition, one block
+#define CONVOLVER_FFT_SIZE          (2 * CONVOLVER_PARTITION)
+#define CONVOLVER_BINS              (CONVOLVER_FFT_SIZE / 2)    // complex bins, with Nyquist packed into bin 0
+#ifndef CONVOLVER_MAX_TAPS
+#define CONVOLVER_MAX_TAPS          4096                    // 32 partitions; 64 KB of spectra per channel with its delay line
+#endif
+#define CONVOLVER_BUDGET_PERCENT    60                      // of the block period, on the worker's core
+#define CONVOLVER_BUDGET_BLOCKS     128                     // blocks averaged for each check
+
+struct ConvolverFilter;
+
+class Convolver : public AudioStage {
+  public:
+    Convolver();
+    ~Convolver();
+
+    const char *name() const override { return "room"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // control side; ir[c] holds taps samples (full scale 1.0) for channel c
+    bool setFilter(const float *const *ir, uint8_t channels, size_t taps, uint32_t sampleRate, bool psram = false);
+    void update();                                      // frees a filter the audio side has let go of
+    size_t taps() const { return _taps; }               // as set
+    size_t activeTaps() const {                         // within the budget
+      const size_t budget = (size_t)_partitions * CONVOLVER_PARTITION;
+      return budget < _taps ? budget : _taps;
+    }
+    uint32_t filterRate() const { return _filterRate; }
+    bool active() const;                                // a filter for the stream's rate is in use
+
+    // worker
+    bool startWorker(uint8_t core, UBaseType_t priority, uint32_t stack);
+
+    // metrics
+    float load() const { return _load; }                // percent of the block period, last check
+    uint32_t lateBlocks() const { return _late; }       // blocks the audio task waited for
+    uint32_t fallbacks() const { return _fallbacks; }   // times the filter was shortened
+    void resetStats();
+
+  private:
+    static void workerTask(void *arg);
+    void work();
+    void convolve(ConvolverFilter *f);
+    void clear();
+    void waitForWorker();
+
+    static void initTables();
+    static void fft(float *re, float *im);
+    static void forward(const float *x, float *spectrum);      // 2 * CONVOLVER_BINS floats out
+    static void inverse(const float *spectrum, float *x);
+    static float _cos[CONVOLVER_BINS];
+    static float _sin[CONVOLVER_BINS];
+
+    // handover: control -> audio in _pending, audio -> control in _retired
+    std::atomic<ConvolverFilter *> _pending;
+    std::atomic<ConvolverFilter *> _retired;
+    size_t _taps;
+    uint32_t _filterRate;
+
+    // audio side
+    ConvolverFilter *_filter;
+    uint32_t _sampleRate;
+    bool _busy;                                         // the worker has a block
+    SemaphoreHandle_t _start, _done;
+    TaskHandle_t _worker;
+    volatile bool _stop;                                // destructor: the worker ends itself
+
+    // shared with the worker; only touched by one side at a time, the semaphores order them
+    int32_t _in[CONVOLVER_PARTITION * AUDIO_MAX_CHANNELS];
+    int32_t _out[CONVOLVER_PARTITION * AUDIO_MAX_CHANNELS];
+    uint8_t _channels;
+    volatile uint16_t _partitions;                      // in use, <= the filter's
+
+    // worker side
+    float _history[AUDIO_MAX_CHANNELS][CONVOLVER_FFT_SIZE];     // last two blocks of input
+    float _spectrum[2 * CONVOLVER_BINS];
+    float _time[CONVOLVER_FFT_SIZE];
+    uint32_t _newest;                                   // delay line slot of the latest input spectrum
+    uint32_t _busyUs;
+    uint32_t _measured;
+    volatile float _load;
+    volatile uint32_t _late;
+    volatile uint32_t _fallbacks;
+};
+
+#endif
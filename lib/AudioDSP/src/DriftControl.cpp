@@ -0,0 +1,69 @@
+/*
+  DriftControl.cpp - keeps the jitter buffer at its target fill despite clock drift
+*/
+
+#include "DriftControl.h"
+
+DriftControl::DriftControl()
+  : _average(0.0f), _setpoint(0.0f), _settling(0), _started(false), _integral(0.0f), _correction(0.0f) {
+  begin(44100, 2048);
+}
+
+void DriftControl::begin(uint32_t sampleRate, uint32_t targetFrames) {
+  _sampleRate = sampleRate;
+  _target = targetFrames;
+  // fill error e (frames) changes at rate * correction, so the loop is
+  // e'' + rate*kp e' + rate*ki e = 0; critically damped at w = 1 / DRIFT_LOOP_SECONDS
+  const float w = 1.0f / DRIFT_LOOP_SECONDS;
+  _kp = 2.0f * w / sampleRate * 1e6f;
+  _ki = w * w / sampleRate * 1e6f;
+  reset();
+}
+
+void DriftControl::reset() {
+  _average = (float)_target;
+  _setpoint = (float)_target;
+  _settling = (uint32_t)(DRIFT_SETTLE_SECONDS * _sampleRate);
+  _started = false;
+  _correction = _integral;
+}
+
+void DriftControl::clear() {
+  _integral = 0.0f;
+  reset();
+}
+
+int32_t DriftControl::update(size_t fill, size_t frames) {
+  const float dt = (float)frames / _sampleRate;
+  float average = _started ? _average + (dt / DRIFT_FILTER_SECONDS) * ((float)fill - _average) : (float)fill;
+  _average = average;
+  _started = true;
+
+  if (_settling) {                          // open loop at the estimate until the average has settled
+    _settling = frames < _settling ? _settling - frames : 0;
+    if (!_settling) _setpoint = average;
+    _correction = _integral;
+    return (int32_t)(_integral >= 0.0f ? _integral + 0.5f : _integral - 0.5f);
+  }
+
+  float approach = 0.0f;                    // walking the set point to the target, fed forward
+  const float step = DRIFT_APPROACH_PPM * 1e-6f * frames, gap = (float)_target - _setpoint;
+  if (gap > step) {
+    _setpoint += step;
+    approach = -DRIFT_APPROACH_PPM;
+  } else if (gap < -step) {
+    _setpoint -= step;
+    approach = DRIFT_APPROACH_PPM;
+  } else {
+    _setpoint = (float)_target;
+  }
+
+  const float error = average - _setpoint;
+  float integral = _integral + _ki * error * dt;
+  float correction = _kp * error + integral + approach;
+  if (correction > DRIFT_MAX_PPM) correction = DRIFT_MAX_PPM;
+  else if (correction < -DRIFT_MAX_PPM) correction = -DRIFT_MAX_PPM;
+  else _integral = integral;                // no windup while limited
+  _correction = correction;
+  return (int32_t)(correction >= 0.0f ? correction + 0.5f : correction - 0.5f);
+}
@@ -0,0 +1,74 @@
+/*
+  DriftControl.h - keeps the jitter buffer at its target fill despite clock drift
+
+  The phone's clock and the I2S clock are never exactly equal, so a ring
+  read at the I2S rate slowly fills up or drains until it overruns or
+  underruns, every few minutes at typical crystal tolerances.  This is a
+  PI controller on the ring fill that returns a rate correction in parts
+  per million for Resampler::setRatioAdjust(): positive consumes input
+  faster.
+
+  update() is called by the consumer once per block with the fill left
+  after the read.  Packets arrive in bursts, so the fill first goes
+  through a one-pole average (DRIFT_FILTER_SECONDS).  Priming stops at the
+  packet that reaches the target, so the fill then plays on average some
+  part of a packet below it; holding that as an error would pull the rate
+  hard for the first minute and wind the drift estimate far off.  After
+  reset() the loop stays open for DRIFT_SETTLE_SECONDS instead, playing at
+  the drift estimate while the average starts from the real fill and
+  settles.  From there the set point walks to the target at
+  DRIFT_APPROACH_PPM, and that rate is added to the output as it is, so
+  the loop only sees the drift and the jitter.  The loop itself is
+  critically damped with a time constant of DRIFT_LOOP_SECONDS, which is
+  slow enough that wifi stalls and the bursts after them barely move the
+  estimate.  The correction is limited to DRIFT_MAX_PPM (under 2 cents of
+  pitch), and the integral stops while the limit is reached.
+
+  Once settled the integral term is the drift between the two clocks;
+  reset() keeps it for the next stream from the same source, clear()
+  forgets it.
+*/
+
+#ifndef DRIFTCONTROL_H_
+#define DRIFTCONTROL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DRIFT_FILTER_SECONDS    1.0f
+#define DRIFT_LOOP_SECONDS      20.0f
+#define DRIFT_SETTLE_SECONDS    3.0f            // after reset(): learn the level the fill plays at
+#define DRIFT_APPROACH_PPM      100.0f          // then move it to the target this fast (4.4 frames/s at 44.1 kHz)
+#define DRIFT_MAX_PPM           1000.0f
+
+class DriftControl {
+  public:
+    DriftControl();
+
+    void begin(uint32_t sampleRate, uint32_t targetFrames);
+    void reset();                               // new stream: the fill starts from the target again
+    void clear();                               // new source: forget the drift estimate too
+
+    // consumer, once per block: fill after reading frames; returns the correction in ppm
+    int32_t update(size_t fill, size_t frames);
+
+    uint32_t target() const { return _target; }
+    float setpoint() const { return _setpoint; }           // the average fill the loop holds now
+    float averageFill() const { return _average; }
+    float driftPpm() const { return _integral; }            // estimated clock drift, source vs I2S
+    float correctionPpm() const { return _correction; }     // what the last update() asked for
+
+  private:
+    uint32_t _sampleRate;
+    uint32_t _target;
+    float _kp;                                  // ppm per frame of error
+    float _ki;                                  // ppm per frame of error per second
+    volatile float _average;
+    float _setpoint;
+    uint32_t _settling;                         // frames until the loop closes, after reset()
+    bool _started;                              // the average has seen a fill since reset()
+    volatile float _integral;
+    volatile float _correction;
+};
+
+#endif
@@ -0,0 +1,67 @@
+/*
+  GainStage.cpp - flat gain applied to every channel, ramped on changes
+*/
+
+#include "GainStage.h"
+
+void GainStage::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _sampleRate = sampleRate;
+  setRampTime(_rampMs);
+}
+
+void GainStage::setRampTime(uint16_t ms) {
+  _rampMs = ms;
+  setRampFrames((uint32_t)((uint64_t)_sampleRate * ms / 1000));
+}
+
+void GainStage::reset() {
+  _rampTarget = _gain;
+  _current = _rampTarget << GAIN_RAMP_SHIFT;
+  _remaining = 0;
+}
+
+// y = x * g, Q16 gain; gains are small enough that the product fits an int32 after the shift
+static void scale(int32_t *s, size_t n, int32_t g) {
+  for (size_t i = 0; i < n; i++) s[i] = (int32_t)(((int64_t)s[i] * g) >> 16);
+}
+
+void GainStage::process(AudioBlock &block) {
+  const int32_t target = _gain;               // one read per block
+  if (target != _rampTarget) {
+    // division once per change, not per frame
+    const uint32_t frames = _rampFrames;
+    _rampTarget = target;
+    _step = (int32_t)((((int64_t)target << GAIN_RAMP_SHIFT) - _current) / (int64_t)frames);
+    _remaining = frames;
+  }
+
+  const uint8_t ch = block.channels;
+  int32_t *s = block.samples;
+  uint16_t done = 0;
+  if (_remaining) {
+    const uint16_t n = _remaining < block.frames ? (uint16_t)_remaining : block.frames;
+    const int32_t start = _current, step = _step;
+    if (ch == 2) {
+      for (uint16_t i = 0; i < n; i++) {
+        const int32_t g = (start + step * (int32_t)(i + 1)) >> GAIN_RAMP_SHIFT;
+        s[2 * i] = (int32_t)(((int64_t)s[2 * i] * g) >> 16);
+        s[2 * i + 1] = (int32_t)(((int64_t)s[2 * i + 1] * g) >> 16);
+      }
+    } else {
+      for (uint16_t i = 0; i < n; i++) {
+        const int32_t g = (start + step * (int32_t)(i + 1)) >> GAIN_RAMP_SHIFT;
+        for (uint8_t c = 0; c < ch; c++) s[i * ch + c] = (int32_t)(((int64_t)s[i * ch + c] * g) >> 16);
+      }
+    }
+    _remaining -= n;
+    // land exactly on the target; the truncated step would leave it a few LSBs short
+    _current = _remaining ? start + step * (int32_t)n : target << GAIN_RAMP_SHIFT;
+    done = n;
+    if (done == block.frames) return;
+  }
+
+  const int32_t g = _current >> GAIN_RAMP_SHIFT;
+  if (g == GAIN_UNITY) return;
+  scale(s + done * ch, (size_t)(block.frames - done) * ch, g);
+}
@@ -0,0 +1,62 @@
+/*
+  GainStage.h - flat gain applied to every channel, ramped on changes
+
+  The gain is Q16 (65536 = unity) so one 32x32->64 multiply and a shift per
+  sample covers -96 dB to +24 dB without leaving the block's headroom.
+
+  setGain() does not step: the audio task moves the gain to the new target
+  in a straight line over the ramp time (setRampTime(), 5 ms by default),
+  so volume changes and fades do not click.  A new target part way through
+  a ramp starts a fresh ramp from wherever the gain has got to.  The ramp
+  runs in Q24 so even small steps move every frame; each frame's gain is
+  worked out from the block's start value, not accumulated, so the loop has
+  no dependency between frames and vectorizes.  Outside a ramp the block
+  costs what a fixed gain does, and nothing at unity.
+
+  reset() jumps straight to the target (stream restart: nothing to ramp
+  from).
+*/
+
+#ifndef GAINSTAGE_H_
+#define GAINSTAGE_H_
+
+#include "AudioStage.h"
+
+#define GAIN_UNITY          65536
+#define GAIN_RAMP_SHIFT     8                   // extra fraction bits while ramping: Q24
+#define GAIN_RAMP_MS        5
+
+class GainStage : public AudioStage {
+  public:
+    explicit GainStage(const char *name = "gain", int32_t gain = GAIN_UNITY)
+      : _name(name), _gain(gain), _rampMs(GAIN_RAMP_MS), _rampFrames(44100 * GAIN_RAMP_MS / 1000),
+        _current(gain << GAIN_RAMP_SHIFT), _rampTarget(gain), _step(0), _remaining(0) {}
+
+    const char *name() const override { return _name; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    void setGain(int32_t gain) { _gain = gain; }              // Q16, ramped
+    int32_t gain() const { return _gain; }                    // target
+    int32_t currentGain() const { return _current >> GAIN_RAMP_SHIFT; }
+    bool ramping() const { return _remaining || _gain != _rampTarget; }
+
+    void setRampTime(uint16_t ms);                            // applies from the next setGain()
+    void setRampFrames(uint32_t frames) { _rampFrames = frames ? frames : 1; }  // until the next begin()/setRampTime()
+
+  private:
+    const char *_name;
+    volatile int32_t _gain;
+    volatile uint16_t _rampMs;
+    volatile uint32_t _rampFrames;
+    uint32_t _sampleRate = 44100;
+
+    // audio task
+    volatile int32_t _current;                  // Q24
+    int32_t _rampTarget;                        // target the running ramp heads for
+    int32_t _step;                              // per frame, Q24
+    uint32_t _remaining;                        // frames left in the ramp
+};
+
+#endif
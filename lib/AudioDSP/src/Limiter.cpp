@@ -0,0 +1,229 @@
+/*
+  Limiter.cpp - look-ahead peak limiter with a soft-knee compressor in front
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "Limiter.h"
+
+#define LIMITER_LOG_ONE     (1 << LIMITER_LOG_SHIFT)
+#define LIMITER_LEVEL_MIN   (-64 * LIMITER_LOG_ONE)        // level of digital silence
+#define LIMITER_LEVEL_MARGIN 64                            // covers the log2/exp2 interpolation error (~0.006 dB)
+#define LIMITER_MASK        (LIMITER_LOOKAHEAD - 1)
+
+int32_t Limiter::_log2Table[33];
+uint32_t Limiter::_exp2Table[33];
+
+static int32_t dbToLog(float db) {
+  return (int32_t)lrintf(db / 6.0206f * LIMITER_LOG_ONE);
+}
+
+static float logToDb(int32_t log) {
+  return log * 6.0206f / LIMITER_LOG_ONE;
+}
+
+Limiter::Limiter()
+  : _thresholdDb(0.0f), _ratioValue(1.0f), _kneeDb(0.0f), _ceilingDb(0.0f), _releaseMs(50.0f), _sampleRate(44100) {
+  initTables();
+  setThreshold(0.0f);
+  setRatio(1.0f);
+  setKnee(3.0f);
+  setCeiling(-0.5f);
+  setRelease(50.0f);
+  reset();
+  resetStats();
+}
+
+void Limiter::initTables() {
+  if (_exp2Table[0]) return;
+  for (int i = 0; i <= 32; i++) {
+    _log2Table[i] = (int32_t)lrint(log2(1.0 + i / 32.0) * LIMITER_LOG_ONE);
+    _exp2Table[i] = (uint32_t)llrint(exp2(i / 32.0) * (1 << LIMITER_GAIN_SHIFT));
+  }
+}
+
+void Limiter::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _sampleRate = sampleRate;
+  updateRelease();
+  reset();
+}
+
+void Limiter::reset() {
+  memset(_delay, 0, sizeof(_delay));
+  memset(_average, 0, sizeof(_average));
+  _averageSum = 0;
+  _minHead = 0;
+  _minCount = 0;
+  _released = 0;
+  _frame = 0;
+  _pos = 0;
+}
+
+void Limiter::setThreshold(float db) {
+  if (db > 0.0f) db = 0.0f;
+  if (db < -60.0f) db = -60.0f;
+  _thresholdDb = db;
+  _threshold = dbToLog(db);
+}
+
+void Limiter::setRatio(float ratio) {
+  if (ratio < 1.0f) ratio = 1.0f;
+  if (ratio > 100.0f) ratio = 100.0f;
+  _ratioValue = ratio;
+  _slope = (int32_t)lrintf((1.0f / ratio - 1.0f) * LIMITER_LOG_ONE);
+}
+
+void Limiter::setKnee(float db) {
+  if (db < 0.0f) db = 0.0f;
+  if (db > 24.0f) db = 24.0f;
+  _kneeDb = db;
+  // a block that sees a new width with the old scale gets a slightly different curve; the ceiling still holds
+  const int32_t knee = dbToLog(db);
+  if (knee > 0) _kneeScale = (int32_t)(((int64_t)1 << (2 * LIMITER_LOG_SHIFT)) / (2 * knee));
+  _knee = knee;
+}
+
+void Limiter::setCeiling(float db) {
+  if (db > 0.0f) db = 0.0f;
+  if (db < -24.0f) db = -24.0f;
+  _ceilingDb = db;
+  _ceiling = dbToLog(db);
+  _ceilingSample = (int32_t)floor(AUDIO_FULL_SCALE * pow(10.0, db / 20.0));
+}
+
+void Limiter::setRelease(float ms) {
+  if (ms < 1.0f) ms = 1.0f;
+  if (ms > 2000.0f) ms = 2000.0f;
+  _releaseMs = ms;
+  updateRelease();
+}
+
+void Limiter::updateRelease() {
+  double coef = 1.0 - exp(-1000.0 / (_releaseMs * _sampleRate));
+  _releaseCoef = (int32_t)lrint(coef * (1 << LIMITER_GAIN_SHIFT));
+}
+
+float Limiter::gainReductionDb() const {
+  return logToDb(_reduction);
+}
+
+float Limiter::peakReductionDb() const {
+  return logToDb(_peakReduction);
+}
+
+void Limiter::resetStats() {
+  _reduction = 0;
+  _peakReduction = 0;
+  _clamped = 0;
+}
+
+// log2(peak / full scale) in Q16, rounded up by the margin
+int32_t Limiter::log2Level(uint32_t peak) {
+  if (!peak) return LIMITER_LEVEL_MIN;
+  const int lz = __builtin_clz(peak);
+  const uint32_t m = peak << lz;                               // leading one at bit 31
+  const uint32_t index = (m >> 26) & 31;
+  const int32_t rem = (m >> 15) & 0x7FF;
+  const int32_t frac = _log2Table[index] + (((_log2Table[index + 1] - _log2Table[index]) * rem) >> 11);
+  return (31 - lz - 23) * LIMITER_LOG_ONE + frac + LIMITER_LEVEL_MARGIN;
+}
+
+// 2^logGain for logGain <= 0, Q30
+int32_t Limiter::exp2Gain(int32_t logGain) {
+  const int32_t whole = -(logGain >> LIMITER_LOG_SHIFT);         // floor, so the fraction is positive
+  if (whole > LIMITER_GAIN_SHIFT) return 0;
+  const uint32_t frac = logGain & (LIMITER_LOG_ONE - 1);
+  const uint32_t index = frac >> 11;
+  const uint32_t rem = frac & 0x7FF;
+  const uint32_t m = _exp2Table[index] + (uint32_t)(((uint64_t)(_exp2Table[index + 1] - _exp2Table[index]) * rem) >> 11);
+  return (int32_t)(m >> whole);
+}
+
+// gain (<= 0) one soft-knee segment asks for at this level
+int32_t Limiter::kneeGain(int32_t level, int32_t threshold, int32_t slope) const {
+  const int32_t knee = _knee;
+  const int32_t half = knee >> 1;
+  const int32_t over = level - threshold;
+  if (over <= -half) return 0;
+  if (over >= knee - half) return (int32_t)(((int64_t)slope * over) >> LIMITER_LOG_SHIFT);
+  const int64_t e = over + half;
+  const int64_t squared = (e * e) >> LIMITER_LOG_SHIFT;
+  const int64_t curve = (squared * _kneeScale) >> LIMITER_LOG_SHIFT;
+  return (int32_t)(((int64_t)slope * curve) >> LIMITER_LOG_SHIFT);
+}
+
+void Limiter::process(AudioBlock &block) {
+  const uint8_t ch = block.channels;
+  const int32_t threshold = _threshold, slope = _slope, ceiling = _ceiling;
+  const int32_t limit = _ceilingSample, release = _releaseCoef;
+  const int32_t quiet = (threshold < ceiling ? threshold : ceiling) - (_knee >> 1);     // below this no gain is needed
+  int32_t *s = block.samples;
+  int32_t lowest = 0;
+  uint32_t clamped = 0;
+
+  for (uint16_t i = 0; i < block.frames; i++, s += ch) {
+    // detector: channel peak -> level -> gain the static curve wants
+    uint32_t peak = 0;
+    for (uint8_t c = 0; c < ch; c++) {
+      uint32_t a = s[c] < 0 ? (uint32_t)0 - (uint32_t)s[c] : (uint32_t)s[c];
+      if (a > peak) peak = a;
+    }
+    const int32_t level = log2Level(peak);
+    int32_t gain = 0;
+    if (level > quiet) {
+      gain = kneeGain(level, threshold, slope);
+      const int32_t limited = kneeGain(level, ceiling, -LIMITER_LOG_ONE);
+      if (limited < gain) gain = limited;
+      if (ceiling - level < gain) gain = ceiling - level;
+      if (gain > 0) gain = 0;
+    }
+
+    // running minimum over the look-ahead window (ascending queue)
+    const uint32_t frame = _frame++;
+    if (_minCount && frame - _minFrame[_minHead] >= LIMITER_LOOKAHEAD) {
+      _minHead = (_minHead + 1) & LIMITER_MASK;
+      _minCount--;
+    }
+    while (_minCount && _minGain[(_minHead + _minCount - 1) & LIMITER_MASK] >= gain) _minCount--;
+    const uint16_t tail = (_minHead + _minCount) & LIMITER_MASK;
+    _minGain[tail] = gain;
+    _minFrame[tail] = frame;
+    _minCount++;
+    const int32_t target = _minGain[_minHead];
+
+    // release: fall at once, rise as a one-pole rounded up so it settles on the target, never above it
+    if (target < _released) _released = target;
+    else _released += (int32_t)(((int64_t)(target - _released) * release + (1 << LIMITER_GAIN_SHIFT) - 1) >> LIMITER_GAIN_SHIFT);
+
+    // attack: average over the window (arithmetic shift rounds towards more reduction)
+    const uint16_t pos = _pos;
+    _averageSum += _released - _average[pos];
+    _average[pos] = _released;
+    const int32_t smoothed = (int32_t)(_averageSum >> LIMITER_LOOKAHEAD_SHIFT);
+    if (smoothed < lowest) lowest = smoothed;
+    const int32_t linear = exp2Gain(smoothed);
+
+    // delay line: store this frame, output the one from LIMITER_LOOKAHEAD - 1 frames ago
+    int32_t *slot = _delay + pos * ch;
+    const int32_t *oldest = _delay + ((pos + 1) & LIMITER_MASK) * ch;
+    for (uint8_t c = 0; c < ch; c++) slot[c] = s[c];
+    for (uint8_t c = 0; c < ch; c++) {
+      int32_t y = linear == (1 << LIMITER_GAIN_SHIFT) ? oldest[c] : (int32_t)(((int64_t)oldest[c] * linear) >> LIMITER_GAIN_SHIFT);
+      if (y > limit) {
+        y = limit;
+        clamped++;
+      } else if (y < -limit) {
+        y = -limit;
+        clamped++;
+      }
+      s[c] = y;
+    }
+    _pos = (pos + 1) & LIMITER_MASK;
+  }
+
+  _reduction = -(int32_t)(_averageSum >> LIMITER_LOOKAHEAD_SHIFT);
+  if (-lowest > _peakReduction) _peakReduction = -lowest;
+  if (clamped) _clamped = _clamped + clamped;
+}
@@ -0,0 +1,116 @@
+/*
+  Limiter.h - look-ahead peak limiter with a soft-knee compressor in front
+
+  Everything runs in fixed point in the log2 domain (Q15.16, 0 = full
+  scale): per frame the channel peak goes through a table-based log2, the
+  static curve gives the gain it needs, and one table-based exp2 turns the
+  smoothed gain back into a Q2.30 multiplier.  The inner loop has no
+  divisions; the curve's constants are worked out by the setters.
+
+  The curve is a soft-knee compressor (threshold, ratio, knee width) and a
+  limiter with the same knee at the ceiling, whichever asks for less gain.
+  Gain smoothing is built so the ceiling holds exactly:
+
+    - the required gain goes through a running minimum over the look-ahead
+      window (LIMITER_LOOKAHEAD frames), so a peak is seen a whole window
+      before it reaches the output
+    - release is a one-pole rise towards that minimum (set in ms); falls
+      are taken at once
+    - attack is a moving average over the window, a linear-in-dB ramp that
+      arrives at the peak's gain exactly when the peak leaves the delay line
+
+  Every gain in the averaging window is at or below what the delayed frame
+  needs, so the average is too.  The log2 estimate errs on the high side,
+  so output peaks stay at or just under the ceiling.  A final clamp catches
+  anything the approximations miss and counts it in clampedSamples();
+  bench/limiter checks that count stays at zero.
+
+  Signals that never reach the knee pass bit for bit, delayed by
+  latencyFrames().
+*/
+
+#ifndef LIMITER_H_
+#define LIMITER_H_
+
+#include "AudioStage.h"
+
+#define LIMITER_LOOKAHEAD_SHIFT 6
+#define LIMITER_LOOKAHEAD       (1 << LIMITER_LOOKAHEAD_SHIFT)    // frames; 1.45 ms at 44.1 kHz
+#define LIMITER_LOG_SHIFT       16                              // levels and gains: log2, Q15.16
+#define LIMITER_GAIN_SHIFT      30                              // linear gain: Q2.30
+
+class Limiter : public AudioStage {
+  public:
+    Limiter();
+
+    const char *name() const override { return "limiter"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // control side; each setter ends in single word stores the audio task picks up at the next frame
+    void setThreshold(float db);                // compressor threshold, dBFS
+    void setRatio(float ratio);                 // compressor ratio, 1 = off
+    void setKnee(float db);                     // knee width for compressor and limiter, 0 = hard
+    void setCeiling(float db);                  // output peak limit, dBFS, <= 0
+    void setRelease(float ms);
+    float threshold() const { return _thresholdDb; }
+    float ratio() const { return _ratioValue; }
+    float knee() const { return _kneeDb; }
+    float ceiling() const { return _ceilingDb; }
+    float release() const { return _releaseMs; }
+    int32_t ceilingSample() const { return _ceilingSample; }    // largest output magnitude, Q8.23
+
+    // metrics
+    float gainReductionDb() const;              // at the end of the last block, >= 0
+    float peakReductionDb() const;              // largest since resetStats()
+    uint32_t clampedSamples() const { return _clamped; }
+    void resetStats();
+    uint32_t latencyFrames() const { return LIMITER_LOOKAHEAD - 1; }
+
+  private:
+    static void initTables();
+    static int32_t log2Level(uint32_t peak);
+    static int32_t exp2Gain(int32_t logGain);
+    int32_t kneeGain(int32_t level, int32_t threshold, int32_t slope) const;
+    void updateRelease();
+
+    // parameters as the audio task uses them
+    volatile int32_t _threshold;                // log2 Q16
+    volatile int32_t _slope;                    // 1/ratio - 1, Q16
+    volatile int32_t _knee;                     // log2 Q16
+    volatile int32_t _kneeScale;                // 1 / (2 * knee), Q16 per log2 unit
+    volatile int32_t _ceiling;                  // log2 Q16
+    volatile int32_t _ceilingSample;
+    volatile int32_t _releaseCoef;              // Q30, per frame
+
+    // as set
+    float _thresholdDb;
+    float _ratioValue;
+    float _kneeDb;
+    float _ceilingDb;
+    float _releaseMs;
+    volatile uint32_t _sampleRate;
+
+    // delay line and gain smoothing, all LIMITER_LOOKAHEAD long
+    int32_t _delay[LIMITER_LOOKAHEAD * AUDIO_MAX_CHANNELS];
+    int32_t _average[LIMITER_LOOKAHEAD];        // released gains in the attack window
+    int64_t _averageSum;
+    int32_t _minGain[LIMITER_LOOKAHEAD];        // running minimum: ascending gains still in the window
+    uint32_t _minFrame[LIMITER_LOOKAHEAD];
+    uint16_t _minHead;
+    uint16_t _minCount;
+    int32_t _released;
+    uint32_t _frame;
+    uint16_t _pos;
+
+    // metrics
+    volatile int32_t _reduction;                // log2 Q16, >= 0
+    volatile int32_t _peakReduction;
+    volatile uint32_t _clamped;
+
+    static int32_t _log2Table[33];              // log2(1 + i/32), Q16
+    static uint32_t _exp2Table[33];             // 2^(i/32), Q30
+};
+
+#endif
@@ -0,0 +1,104 @@
+/*
+  Loudness.cpp - volume-dependent bass and treble boost (loudness compensation)
+*/
+
+#include <string.h>
+
+#include "Loudness.h"
+#include "LoudnessTable.h"
+
+Loudness::Loudness()
+  : _volume(LOUDNESS_STEPS - 1), _clear(true), _off(false), _rateTable(loudnessTable[0]), _row(NULL), _running(false) {
+  memset(_state, 0, sizeof(_state));
+  setBypass(true);
+}
+
+float Loudness::volumeRangeDb() {
+  return LOUDNESS_VOLUME_RANGE_DB;
+}
+
+void Loudness::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _rateTable = NULL;
+  for (uint8_t i = 0; i < LOUDNESS_RATE_COUNT; i++) {
+    if (loudnessRates[i] == sampleRate) _rateTable = loudnessTable[i];
+  }
+  reset();
+}
+
+void Loudness::reset() {
+  memset(_state, 0, sizeof(_state));
+  _row = NULL;
+  _running = false;
+}
+
+void Loudness::setVolume(uint8_t volume) {
+  _volume = volume < LOUDNESS_STEPS ? volume : LOUDNESS_STEPS - 1;
+}
+
+// switching off goes through process() like a move to a flat row, so the shelves fade out over a block
+// before the stage is bypassed
+void Loudness::setEnabled(bool enabled) {
+  if (enabled) {
+    if (bypassed()) _clear = true;
+    _off = false;
+    setBypass(false);
+  } else if (!bypassed()) {
+    _off = true;
+  }
+}
+
+void Loudness::biquad(const int32_t *c, int64_t *state, int32_t *s, uint16_t frames, uint8_t channels) {
+  const int32_t b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+  int64_t s1 = state[0], s2 = state[1];
+  for (uint16_t i = 0; i < frames; i++, s += channels) {
+    const int32_t x = *s;
+    int64_t acc = ((int64_t)b0 * x + s1) >> LOUDNESS_COEF_SHIFT;
+    if (acc > INT32_MAX) acc = INT32_MAX;
+    else if (acc < INT32_MIN) acc = INT32_MIN;
+    const int32_t y = (int32_t)acc;
+    s1 = (int64_t)b1 * x - (int64_t)a1 * y + s2;
+    s2 = (int64_t)b2 * x - (int64_t)a2 * y;
+    *s = y;
+  }
+  state[0] = s1;
+  state[1] = s2;
+}
+
+void Loudness::shelves(const LoudnessCoeffs &c, State &state, int32_t *samples, uint16_t frames, uint8_t channels) {
+  for (uint8_t ch = 0; ch < channels; ch++) {
+    biquad(c.low, state[0][ch], samples + ch, frames, channels);
+    biquad(c.high, state[1][ch], samples + ch, frames, channels);
+  }
+}
+
+void Loudness::process(AudioBlock &block) {
+  const uint8_t volume = _volume;
+  const bool off = _off;
+  const bool flat = off || !_rateTable || volume == 0 || volume == LOUDNESS_STEPS - 1;
+  const LoudnessCoeffs *row = flat ? NULL : &_rateTable[volume];
+  if (_clear) {
+    _row = NULL;
+    _clear = false;
+  }
+
+  // a new row: the old one on a copy, from a copy of its state, to fade from
+  const bool fade = row != _row && _running;
+  if (fade) {
+    memcpy(_old, block.samples, (size_t)block.frames * block.channels * sizeof(int32_t));
+    if (_row) {
+      State state;
+      memcpy(state, _state, sizeof(state));
+      shelves(*_row, state, _old, block.frames, block.channels);
+    }
+  }
+  if (row && !_row) memset(_state, 0, sizeof(_state));      // the filters start from silence after flat stretches
+  if (row) shelves(*row, _state, block.samples, block.frames, block.channels);
+  if (fade) audioBlockCrossfade(block, _old);
+  _row = row;
+  _running = true;
+  if (off && _off) {                                        // faded out, and not switched on again meanwhile
+    setBypass(true);
+    _off = false;
+  }
+}
@@ -0,0 +1,67 @@
+/*
+  Loudness.h - volume-dependent bass and treble boost (loudness compensation)
+
+  The ear loses bass, and to a lesser degree treble, as the level drops, so
+  music turned down sounds thin.  This stage follows the volume with a low
+  shelf (120 Hz, up to +15 dB) and a high shelf (8 kHz, up to +5 dB) whose
+  gain grows with the attenuation.
+
+  Every coefficient comes from a table in flash, generated for each a2dp
+  volume step at 44.1 and 48 kHz by tools/loudness_table.py: setVolume()
+  stores an index and process() points at another table row at the next
+  block.  Nothing is designed on the device.  The rows are constant, so
+  the table is its own parameter store: the block that moves to a new row
+  also runs the old one and cross-fades between the two, and so do the
+  blocks that switch the stage on and off: switching off fades to flat
+  over one block and only then bypasses the stage.  At other sample
+  rates, at full volume and when muted the stage passes audio through.
+
+  The biquads are the ParametricEQ ones: transposed direct form II with
+  Q3.28 coefficients and 64 bit state.
+*/
+
+#ifndef LOUDNESS_H_
+#define LOUDNESS_H_
+
+#include "AudioStage.h"
+
+#define LOUDNESS_STEPS      128                 // a2dp volume 0..127
+#define LOUDNESS_COEF_SHIFT 28
+
+struct LoudnessCoeffs {
+  int32_t low[5];                               // b0 b1 b2 a1 a2
+  int32_t high[5];
+};
+
+class Loudness : public AudioStage {
+  public:
+    Loudness();
+
+    const char *name() const override { return "loudness"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // any task
+    void setVolume(uint8_t volume);             // same 0..127 as audioPathSetVolume()
+    void setEnabled(bool enabled);
+    bool enabled() const { return !bypassed() && !_off; }
+    static float volumeRangeDb();               // the volume law the table was generated for
+
+  private:
+    typedef int64_t State[2][AUDIO_MAX_CHANNELS][2];   // shelf, channel, s1/s2
+
+    static void biquad(const int32_t *c, int64_t *state, int32_t *s, uint16_t frames, uint8_t channels);
+    static void shelves(const LoudnessCoeffs &c, State &state, int32_t *samples, uint16_t frames, uint8_t channels);
+
+    volatile uint8_t _volume;
+    volatile bool _clear;                       // switched on: the audio so far was not filtered
+    volatile bool _off;                         // switched off: fade to flat in the next block, then bypass
+    const LoudnessCoeffs *_rateTable;           // LOUDNESS_STEPS rows for the current rate, or NULL
+    const LoudnessCoeffs *_row;                 // used for the last block, NULL if it was flat
+    bool _running;                              // has seen audio since reset(): row changes fade
+    State _state;
+    int32_t _old[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];     // the block through the last row
+};
+
+#endif
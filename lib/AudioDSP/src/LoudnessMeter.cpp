@@ -0,0 +1,168 @@
+/*
+  LoudnessMeter.cpp - EBU R128 / ITU-R BS.1770 loudness of the stream
+
+  The K weighting is designed for the stream's rate from its analogue
+  prototypes, as libebur128 does, so it matches the 48 kHz coefficients in
+  BS.1770 and holds at 44.1 kHz.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "LoudnessMeter.h"
+
+#define METER_OFFSET    -0.691f                     // BS.1770: a 997 Hz sine at 0 dBFS in one channel reads -3.01 LUFS
+
+static float lufs(float meanSquare) {
+  return meanSquare > 0.0f ? METER_OFFSET + 10.0f * log10f(meanSquare) : METER_FLOOR;
+}
+
+LoudnessMeter::LoudnessMeter()
+  : _stepFrames(44100 * METER_STEP_MS / 1000), _stepFill(0), _stepSum(0.0f), _head(0), _filled(0),
+    _momentary(METER_FLOOR), _shortTerm(METER_FLOOR), _restart(false), _blocks(0) {
+  memset(_histogram, 0, sizeof(_histogram));
+  design(44100);
+  reset();
+}
+
+// ----------------------------------------------------------------
+//                      -audio side
+// ----------------------------------------------------------------
+
+void LoudnessMeter::design(uint32_t sampleRate) {
+  // high shelf, +4 dB above about 1.7 kHz
+  double f0 = 1681.974450955533, gain = 3.999843853973347, q = 0.7071752369554196;
+  double k = tan(M_PI * f0 / sampleRate);
+  const double vh = pow(10.0, gain / 20.0), vb = pow(vh, 0.4996667741545416);
+  double a0 = 1.0 + k / q + k * k;
+  _shelfB[0] = (float)((vh + vb * k / q + k * k) / a0);
+  _shelfB[1] = (float)(2.0 * (k * k - vh) / a0);
+  _shelfB[2] = (float)((vh - vb * k / q + k * k) / a0);
+  _shelfA[0] = (float)(2.0 * (k * k - 1.0) / a0);
+  _shelfA[1] = (float)((1.0 - k / q + k * k) / a0);
+
+  // second order high pass at 38 Hz
+  f0 = 38.13547087602444;
+  q = 0.5003270373238773;
+  k = tan(M_PI * f0 / sampleRate);
+  a0 = 1.0 + k / q + k * k;
+  _passA[0] = (float)(2.0 * (k * k - 1.0) / a0);
+  _passA[1] = (float)((1.0 - k / q + k * k) / a0);
+}
+
+void LoudnessMeter::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _stepFrames = sampleRate * METER_STEP_MS / 1000;
+  design(sampleRate);
+  reset();
+}
+
+void LoudnessMeter::reset() {
+  memset(_state, 0, sizeof(_state));
+  memset(_steps, 0, sizeof(_steps));
+  _stepFill = 0;
+  _stepSum = 0.0f;
+  _head = 0;
+  _filled = 0;
+  _momentary = METER_FLOOR;
+  _shortTerm = METER_FLOOR;
+}
+
+void LoudnessMeter::process(AudioBlock &block) {
+  if (_restart) {
+    memset(_histogram, 0, sizeof(_histogram));
+    _blocks = 0;
+    _restart = false;
+  }
+
+  const float scale = 1.0f / AUDIO_FULL_SCALE;
+  const uint8_t channels = block.channels;
+  uint16_t done = 0;
+  while (done < block.frames) {
+    // up to the end of the block or of the step, whichever comes first
+    uint32_t frames = block.frames - done;
+    if (frames > _stepFrames - _stepFill) frames = _stepFrames - _stepFill;
+    float sum = 0.0f;
+    for (uint8_t c = 0; c < channels; c++) {
+      float *z = _state[c];
+      float s1 = z[0], s2 = z[1], h1 = z[2], h2 = z[3];
+      const int32_t *s = block.samples + done * channels + c;
+      for (uint32_t i = 0; i < frames; i++, s += channels) {
+        const float x = *s * scale;
+        const float y = _shelfB[0] * x + s1;
+        s1 = _shelfB[1] * x - _shelfA[0] * y + s2;
+        s2 = _shelfB[2] * x - _shelfA[1] * y;
+        const float w = y + h1;
+        h1 = -2.0f * y - _passA[0] * w + h2;
+        h2 = y - _passA[1] * w;
+        sum += w * w;
+      }
+      z[0] = s1;
+      z[1] = s2;
+      z[2] = h1;
+      z[3] = h2;
+    }
+    _stepSum += sum;
+    _stepFill += frames;
+    done += frames;
+    if (_stepFill == _stepFrames) endStep();
+  }
+}
+
+// a 100 ms step is complete: new momentary and short-term values, and the 400 ms block ending here for the gate
+void LoudnessMeter::endStep() {
+  _head = (_head + 1) % METER_SHORT_TERM_STEPS;
+  _steps[_head] = _stepSum / _stepFrames;
+  _stepSum = 0.0f;
+  _stepFill = 0;
+  if (_filled < METER_SHORT_TERM_STEPS) _filled++;
+
+  float momentary = 0.0f, shortTerm = 0.0f;
+  for (uint8_t i = 0; i < METER_SHORT_TERM_STEPS; i++) {
+    const float e = _steps[(_head + METER_SHORT_TERM_STEPS - i) % METER_SHORT_TERM_STEPS];
+    if (i < METER_MOMENTARY_STEPS) momentary += e;
+    shortTerm += e;
+  }
+  if (_filled < METER_MOMENTARY_STEPS) return;              // not 400 ms of audio yet
+  momentary /= METER_MOMENTARY_STEPS;
+  _momentary = lufs(momentary);
+  _shortTerm = _filled < METER_SHORT_TERM_STEPS ? METER_FLOOR : lufs(shortTerm / METER_SHORT_TERM_STEPS);
+
+  if (_momentary < METER_ABSOLUTE_GATE) return;
+  int bin = (int)((_momentary - METER_ABSOLUTE_GATE) / METER_BIN_LU);
+  if (bin >= METER_BINS) bin = METER_BINS - 1;
+  _histogram[bin]++;
+  _blocks = _blocks + 1;
+}
+
+// ----------------------------------------------------------------
+//                      -control side
+// ----------------------------------------------------------------
+
+// the mean square of the blocks in the histogram at or above bin from, taking each at its bin's centre
+static float gatedMean(const uint32_t *histogram, int from, uint32_t &count) {
+  const float ratio = powf(10.0f, METER_BIN_LU / 10.0f);
+  float e = powf(10.0f, (METER_ABSOLUTE_GATE + METER_BIN_LU / 2 - METER_OFFSET) / 10.0f);
+  double sum = 0.0;
+  count = 0;
+  for (int i = 0; i < METER_BINS; i++, e *= ratio) {
+    if (i < from || !histogram[i]) continue;
+    sum += (double)histogram[i] * e;
+    count += histogram[i];
+  }
+  return count ? (float)(sum / count) : 0.0f;
+}
+
+float LoudnessMeter::integrated() const {
+  uint32_t count;
+  const float absolute = gatedMean(_histogram, 0, count);
+  if (!count) return METER_FLOOR;
+  const float threshold = lufs(absolute) + METER_RELATIVE_GATE;
+  int from = (int)ceilf((threshold - METER_ABSOLUTE_GATE) / METER_BIN_LU - 0.5f);   // bins whose centre passes
+  if (from < 0) from = 0;
+  return lufs(gatedMean(_histogram, from, count));
+}
+
+float LoudnessMeter::integratedSeconds() const {
+  return _blocks * (METER_STEP_MS / 1000.0f);
+}
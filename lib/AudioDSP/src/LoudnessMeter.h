@@ -0,0 +1,71 @@
+/*
+  LoudnessMeter.h - EBU R128 / ITU-R BS.1770 loudness of the stream
+
+  A tap that leaves the audio alone.  Each channel goes through the K
+  weighting (a high shelf for the head, then the RLB high pass), and the
+  mean square is collected in 100 ms steps.  The last 4 steps make the
+  momentary loudness, the last 30 the short-term loudness, both in LUFS.
+
+  Integrated loudness follows BS.1770-4: every 400 ms block (one per step,
+  so 75% overlap) louder than the absolute gate of -70 LUFS goes into a
+  histogram of 0.1 LU bins, and integrated() averages the blocks that are
+  also within 10 LU of the mean of those.  The histogram has fixed size,
+  so the measurement can run for as long as the stream does; restart()
+  begins a new one.
+
+  All of the filtering and the histogram run on the audio task, in single
+  precision.  The results are read from any task.
+*/
+
+#ifndef LOUDNESSMETER_H_
+#define LOUDNESSMETER_H_
+
+#include "AudioStage.h"
+
+#define METER_STEP_MS           100
+#define METER_MOMENTARY_STEPS   4                   // 400 ms
+#define METER_SHORT_TERM_STEPS  30                  // 3 s
+#define METER_ABSOLUTE_GATE     -70.0f              // LUFS
+#define METER_RELATIVE_GATE     -10.0f              // LU below the absolutely gated mean
+#define METER_BIN_LU            0.1f
+#define METER_BINS              750                 // -70 to +5 LUFS
+#define METER_FLOOR             -99.0f              // reported for silence and before anything was measured
+
+class LoudnessMeter : public AudioStage {
+  public:
+    LoudnessMeter();
+
+    const char *name() const override { return "meter"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // any task
+    float momentary() const { return _momentary; }          // LUFS
+    float shortTerm() const { return _shortTerm; }
+    float integrated() const;                               // gated, since restart()
+    float integratedSeconds() const;                        // audio above the absolute gate behind integrated()
+    void restart() { _restart = true; }                     // from the next block
+
+  private:
+    void design(uint32_t sampleRate);
+    void endStep();
+
+    // K weighting, normalised by a0; the high pass numerator is 1 -2 1
+    float _shelfB[3], _shelfA[2], _passA[2];
+    float _state[AUDIO_MAX_CHANNELS][4];                    // shelf s1 s2, high pass s1 s2
+
+    uint32_t _stepFrames;
+    uint32_t _stepFill;
+    float _stepSum;                                         // squares summed over channels
+    float _steps[METER_SHORT_TERM_STEPS];                   // mean square of each step, newest at _head
+    uint8_t _head;
+    uint8_t _filled;
+
+    volatile float _momentary, _shortTerm;
+    volatile bool _restart;
+    uint32_t _histogram[METER_BINS];                        // 400 ms blocks per loudness bin
+    volatile uint32_t _blocks;                              // in the histogram
+};
+
+#endif
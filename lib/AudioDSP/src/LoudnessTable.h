@@ -0,0 +1,279 @@
+/*
+  LoudnessTable.h - generated by lib/AudioDSP/tools/loudness_table.py, do not edit
+
+  Per sample rate and a2dp volume step: low shelf 120 Hz, high shelf 8000 Hz,
+  Q3.28 b0 b1 b2 a1 a2.  Volume law: 0 mutes, 1..127 span -60..0 dB.
+*/
+
+#ifndef LOUDNESSTABLE_H_
+#define LOUDNESSTABLE_H_
+
+#define LOUDNESS_VOLUME_RANGE_DB 60
+#define LOUDNESS_RATE_COUNT      2
+
+static const uint32_t loudnessRates[LOUDNESS_RATE_COUNT] = { 44100, 48000 };
+
+static const LoudnessCoeffs loudnessTable[LOUDNESS_RATE_COUNT][LOUDNESS_STEPS] = {
+  {
+    { { 268435456, -530379777, 262021848, -530379777, 262021848 }, { 268435456, -136549755, 58418453, -136549755, 58418453 } },    //   0: mute, bass  +0.0, treble +0.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   1: -60.0 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   2: -59.5 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   3: -59.0 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   4: -58.6 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   5: -58.1 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   6: -57.6 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   7: -57.1 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   8: -56.7 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //   9: -56.2 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  10: -55.7 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  11: -55.2 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  12: -54.8 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  13: -54.3 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  14: -53.8 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  15: -53.3 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  16: -52.9 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  17: -52.4 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  18: -51.9 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  19: -51.4 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  20: -51.0 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  21: -50.5 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 385084979, -254669453, 96237755, -93612770, 51830595 } },    //  22: -50.0 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 383765090, -253254000, 95777549, -94029286, 51882470 } },    //  23: -49.5 dB, bass +15.0, treble +5.0
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 382449690, -251844923, 95319577, -94445674, 51934562 } },    //  24: -49.0 dB, bass +15.0, treble +4.9
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 381138763, -250442197, 94863830, -94861932, 51986872 } },    //  25: -48.6 dB, bass +15.0, treble +4.9
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 379832294, -249045797, 94410298, -95278060, 52039399 } },    //  26: -48.1 dB, bass +15.0, treble +4.8
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 378530269, -247655699, 93958970, -95694058, 52092143 } },    //  27: -47.6 dB, bass +15.0, treble +4.8
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 377232673, -246271876, 93509837, -96109926, 52145103 } },    //  28: -47.1 dB, bass +15.0, treble +4.7
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 375939491, -244894305, 93062889, -96525662, 52198281 } },    //  29: -46.7 dB, bass +15.0, treble +4.7
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 374650709, -243522962, 92618117, -96941266, 52251674 } },    //  30: -46.2 dB, bass +15.0, treble +4.6
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 373366313, -242157820, 92175510, -97356738, 52305284 } },    //  31: -45.7 dB, bass +15.0, treble +4.6
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 372086288, -240798857, 91735058, -97772077, 52359110 } },    //  32: -45.2 dB, bass +15.0, treble +4.5
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 370810619, -239446046, 91296753, -98187282, 52413151 } },    //  33: -44.8 dB, bass +15.0, treble +4.5
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 369539292, -238099365, 90860583, -98602354, 52467408 } },    //  34: -44.3 dB, bass +15.0, treble +4.4
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 368272293, -236758789, 90426541, -99017291, 52521880 } },    //  35: -43.8 dB, bass +15.0, treble +4.4
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 367009607, -235424294, 89994616, -99432094, 52576566 } },    //  36: -43.3 dB, bass +15.0, treble +4.3
+    { { 271341340, -532579610, 261422897, -532655507, 264252883 }, { 365751220, -234095855, 89564798, -99846760, 52631468 } },    //  37: -42.9 dB, bass +15.0, treble +4.3
+    { { 271306923, -532560383, 261436318, -532635239, 264232930 }, { 364497119, -232773450, 89137079, -100261291, 52686583 } },    //  38: -42.4 dB, bass +14.8, treble +4.2
+    { { 271272577, -532541053, 261449581, -532614872, 264212882 }, { 363247288, -231457053, 88711448, -100675686, 52741913 } },    //  39: -41.9 dB, bass +14.7, treble +4.2
+    { { 271238300, -532521617, 261462686, -532594408, 264192739 }, { 362001714, -230146641, 88287896, -101089943, 52797457 } },    //  40: -41.4 dB, bass +14.5, treble +4.1
+    { { 271204093, -532502077, 261475633, -532573846, 264172501 }, { 360760383, -228842190, 87866414, -101504063, 52853214 } },    //  41: -41.0 dB, bass +14.3, treble +4.1
+    { { 271169954, -532482430, 261488423, -532553184, 264152167 }, { 359523280, -227543677, 87446993, -101918045, 52909185 } },    //  42: -40.5 dB, bass +14.2, treble +4.0
+    { { 271135883, -532462678, 261501055, -532532423, 264131737 }, { 358290391, -226251078, 87029623, -102331888, 52965369 } },    //  43: -40.0 dB, bass +14.0, treble +4.0
+    { { 271101878, -532442820, 261513531, -532511563, 264111210 }, { 357061704, -224964370, 86614295, -102745593, 53021766 } },    //  44: -39.5 dB, bass +13.8, treble +4.0
+    { { 271067939, -532422855, 261525851, -532490602, 264090586 }, { 355837203, -223683529, 86200999, -103159157, 53078375 } },    //  45: -39.0 dB, bass +13.7, treble +3.9
+    { { 271034065, -532402783, 261538014, -532469540, 264069865 }, { 354616875, -222408531, 85789727, -103572582, 53135197 } },    //  46: -38.6 dB, bass +13.5, treble +3.9
+    { { 271000255, -532382603, 261550020, -532448378, 264049046 }, { 353400706, -221139355, 85380470, -103985866, 53192231 } },    //  47: -38.1 dB, bass +13.3, treble +3.8
+    { { 270966509, -532362316, 261561872, -532427113, 264028128 }, { 352188682, -219875976, 84973217, -104399009, 53249477 } },    //  48: -37.6 dB, bass +13.2, treble +3.8
+    { { 270932826, -532341920, 261573567, -532405746, 264007111 }, { 350980790, -218618371, 84567961, -104812011, 53306934 } },    //  49: -37.1 dB, bass +13.0, treble +3.7
+    { { 270899204, -532321416, 261585107, -532384277, 263985995 }, { 349777016, -217366518, 84164691, -105224870, 53364603 } },    //  50: -36.7 dB, bass +12.8, treble +3.7
+    { { 270865644, -532300802, 261596493, -532362704, 263964779 }, { 348577346, -216120394, 83763400, -105637587, 53422483 } },    //  51: -36.2 dB, bass +12.7, treble +3.6
+    { { 270832144, -532280080, 261607723, -532341027, 263943463 }, { 347381767, -214879975, 83364077, -106050161, 53480574 } },    //  52: -35.7 dB, bass +12.5, treble +3.6
+    { { 270798703, -532259247, 261618799, -532319247, 263922046 }, { 346190265, -213645239, 82966715, -106462591, 53538876 } },    //  53: -35.2 dB, bass +12.3, treble +3.5
+    { { 270765321, -532238304, 261629720, -532297361, 263900528 }, { 345002827, -212416164, 82571304, -106874877, 53597388 } },    //  54: -34.8 dB, bass +12.2, treble +3.5
+    { { 270731997, -532217250, 261640488, -532275371, 263878908 }, { 343819438, -211192726, 82177835, -107287018, 53656110 } },    //  55: -34.3 dB, bass +12.0, treble +3.4
+    { { 270698730, -532196085, 261651101, -532253274, 263857186 }, { 342640087, -209974903, 81786300, -107699015, 53715042 } },    //  56: -33.8 dB, bass +11.8, treble +3.4
+    { { 270665519, -532174808, 261661561, -532231072, 263835361 }, { 341464758, -208762674, 81396689, -108110865, 53774183 } },    //  57: -33.3 dB, bass +11.7, treble +3.3
+    { { 270632364, -532153420, 261671867, -532208762, 263813433 }, { 340293440, -207556014, 81008994, -108522570, 53833534 } },    //  58: -32.9 dB, bass +11.5, treble +3.3
+    { { 270599264, -532131919, 261682021, -532186346, 263791402 }, { 339126118, -206354903, 80623206, -108934128, 53893093 } },    //  59: -32.4 dB, bass +11.3, treble +3.2
+    { { 270566218, -532110305, 261692021, -532163821, 263769266 }, { 337962780, -205159318, 80239317, -109345539, 53952862 } },    //  60: -31.9 dB, bass +11.2, treble +3.2
+    { { 270533225, -532088578, 261701868, -532141189, 263747026 }, { 336803412, -203969237, 79857318, -109756802, 54012839 } },    //  61: -31.4 dB, bass +11.0, treble +3.1
+    { { 270500284, -532066738, 261711563, -532118447, 263724681 }, { 335648001, -202784638, 79477199, -110167918, 54073024 } },    //  62: -31.0 dB, bass +10.8, treble +3.1
+    { { 270467395, -532044783, 261721105, -532095597, 263702230 }, { 334496534, -201605498, 79098954, -110578884, 54133417 } },    //  63: -30.5 dB, bass +10.7, treble +3.0
+    { { 270434557, -532022713, 261730495, -532072636, 263679674 }, { 333348998, -200431797, 78722572, -110989702, 54194018 } },    //  64: -30.0 dB, bass +10.5, treble +3.0
+    { { 270401769, -532000529, 261739734, -532049565, 263657011 }, { 332205379, -199263512, 78348046, -111400370, 54254827 } },    //  65: -29.5 dB, bass +10.3, treble +3.0
+    { { 270369031, -531978229, 261748820, -532026383, 263634240 }, { 331065665, -198100621, 77975367, -111810888, 54315843 } },    //  66: -29.0 dB, bass +10.2, treble +2.9
+    { { 270336341, -531955813, 261757755, -532003090, 263611363 }, { 329929843, -196943103, 77604526, -112221255, 54377065 } },    //  67: -28.6 dB, bass +10.0, treble +2.9
+    { { 270303699, -531933281, 261766538, -531979685, 263588377 }, { 328797900, -195790937, 77235515, -112631472, 54438494 } },    //  68: -28.1 dB, bass  +9.8, treble +2.8
+    { { 270271104, -531910631, 261775171, -531956167, 263565283 }, { 327669823, -194644100, 76868326, -113041537, 54500130 } },    //  69: -27.6 dB, bass  +9.7, treble +2.8
+    { { 270238555, -531887865, 261783652, -531932536, 263542080 }, { 326545598, -193502571, 76502951, -113451450, 54561971 } },    //  70: -27.1 dB, bass  +9.5, treble +2.7
+    { { 270206051, -531864981, 261791982, -531908791, 263518767 }, { 325425214, -192366330, 76139381, -113861210, 54624019 } },    //  71: -26.7 dB, bass  +9.3, treble +2.7
+    { { 270173593, -531841978, 261800162, -531884933, 263495344 }, { 324308658, -191235354, 75777607, -114270817, 54686272 } },    //  72: -26.2 dB, bass  +9.2, treble +2.6
+    { { 270141178, -531818857, 261808191, -531860959, 263471811 }, { 323195916, -190109623, 75417622, -114680271, 54748730 } },    //  73: -25.7 dB, bass  +9.0, treble +2.6
+    { { 270108807, -531795616, 261816070, -531836871, 263448167 }, { 322086977, -188989116, 75059417, -115089571, 54811394 } },    //  74: -25.2 dB, bass  +8.8, treble +2.5
+    { { 270076478, -531772256, 261823799, -531812666, 263424411 }, { 320981827, -187873811, 74702985, -115498717, 54874262 } },    //  75: -24.8 dB, bass  +8.7, treble +2.5
+    { { 270044191, -531748776, 261831378, -531788346, 263400543 }, { 319880454, -186763687, 74348316, -115907707, 54937334 } },    //  76: -24.3 dB, bass  +8.5, treble +2.4
+    { { 270011945, -531725175, 261838806, -531763908, 263376563 }, { 318782845, -185658724, 73995403, -116316542, 55000611 } },    //  77: -23.8 dB, bass  +8.3, treble +2.4
+    { { 269979739, -531701453, 261846086, -531739353, 263352469 }, { 317688988, -184558900, 73644239, -116725222, 55064091 } },    //  78: -23.3 dB, bass  +8.2, treble +2.3
+    { { 269947573, -531677609, 261853215, -531714680, 263328262 }, { 316598870, -183464196, 73294813, -117133744, 55127776 } },    //  79: -22.9 dB, bass  +8.0, treble +2.3
+    { { 269915445, -531653644, 261860196, -531689888, 263303940 }, { 315512479, -182374590, 72947120, -117542110, 55191663 } },    //  80: -22.4 dB, bass  +7.8, treble +2.2
+    { { 269883355, -531629555, 261867027, -531664977, 263279504 }, { 314429802, -181290061, 72601150, -117950319, 55255754 } },    //  81: -21.9 dB, bass  +7.7, treble +2.2
+    { { 269851302, -531605344, 261873709, -531639946, 263254953 }, { 313350828, -180210590, 72256896, -118358370, 55320047 } },    //  82: -21.4 dB, bass  +7.5, treble +2.1
+    { { 269819286, -531581009, 261880242, -531614795, 263230286 }, { 312275543, -179136156, 71914350, -118766263, 55384543 } },    //  83: -21.0 dB, bass  +7.3, treble +2.1
+    { { 269787306, -531556550, 261886626, -531589523, 263205503 }, { 311203936, -178066738, 71573504, -119173997, 55449241 } },    //  84: -20.5 dB, bass  +7.2, treble +2.0
+    { { 269755360, -531531967, 261892862, -531564130, 263180603 }, { 310135993, -177002316, 71234349, -119581571, 55514142 } },    //  85: -20.0 dB, bass  +7.0, treble +2.0
+    { { 269723449, -531507258, 261898949, -531538614, 263155586 }, { 309071704, -175942871, 70896880, -119988986, 55579243 } },    //  86: -19.5 dB, bass  +6.8, treble +2.0
+    { { 269691571, -531482424, 261904888, -531512976, 263130450 }, { 308011056, -174888380, 70561086, -120396241, 55644547 } },    //  87: -19.0 dB, bass  +6.7, treble +1.9
+    { { 269659726, -531457463, 261910678, -531487214, 263105197 }, { 306954036, -173838826, 70226962, -120803335, 55710051 } },    //  88: -18.6 dB, bass  +6.5, treble +1.9
+    { { 269627913, -531432376, 261916320, -531461329, 263079824 }, { 305900633, -172794187, 69894498, -121210268, 55775756 } },    //  89: -18.1 dB, bass  +6.3, treble +1.8
+    { { 269596131, -531407162, 261921815, -531435320, 263054332 }, { 304850834, -171754444, 69563688, -121617039, 55841661 } },    //  90: -17.6 dB, bass  +6.2, treble +1.8
+    { { 269564379, -531381820, 261927161, -531409185, 263028719 }, { 303804628, -170719576, 69234523, -122023648, 55907767 } },    //  91: -17.1 dB, bass  +6.0, treble +1.7
+    { { 269532658, -531356350, 261932359, -531382924, 263002986 }, { 302762002, -169689565, 68906996, -122430095, 55974073 } },    //  92: -16.7 dB, bass  +5.8, treble +1.7
+    { { 269500965, -531330751, 261937410, -531356538, 262977132 }, { 301722945, -168664390, 68581100, -122836379, 56040578 } },    //  93: -16.2 dB, bass  +5.7, treble +1.6
+    { { 269469301, -531305022, 261942314, -531330024, 262951156 }, { 300687445, -167644031, 68256826, -123242499, 56107283 } },    //  94: -15.7 dB, bass  +5.5, treble +1.6
+    { { 269437664, -531279164, 261947069, -531303384, 262925058 }, { 299655489, -166628470, 67934168, -123648455, 56174187 } },    //  95: -15.2 dB, bass  +5.3, treble +1.5
+    { { 269406054, -531253176, 261951678, -531276615, 262898837 }, { 298627066, -165617686, 67613118, -124054247, 56241289 } },    //  96: -14.8 dB, bass  +5.2, treble +1.5
+    { { 269374470, -531227057, 261956139, -531249717, 262872493 }, { 297602164, -164611660, 67293668, -124459874, 56308591 } },    //  97: -14.3 dB, bass  +5.0, treble +1.4
+    { { 269342911, -531200806, 261960453, -531222690, 262846024 }, { 296580772, -163610373, 66975811, -124865336, 56376090 } },    //  98: -13.8 dB, bass  +4.8, treble +1.4
+    { { 269311377, -531174423, 261964620, -531195533, 262819431 }, { 295562878, -162613805, 66659539, -125270632, 56443787 } },    //  99: -13.3 dB, bass  +4.7, treble +1.3
+    { { 269279867, -531147908, 261968640, -531168246, 262792713 }, { 294548469, -161621938, 66344845, -125675761, 56511682 } },    // 100: -12.9 dB, bass  +4.5, treble +1.3
+    { { 269248380, -531121259, 261972513, -531140827, 262765869 }, { 293537535, -160634751, 66031722, -126080724, 56579774 } },    // 101: -12.4 dB, bass  +4.3, treble +1.2
+    { { 269216915, -531094477, 261976239, -531113277, 262738898 }, { 292530063, -159652227, 65720162, -126485520, 56648063 } },    // 102: -11.9 dB, bass  +4.2, treble +1.2
+    { { 269185472, -531067561, 261979818, -531085594, 262711801 }, { 291526043, -158674345, 65410159, -126890148, 56716549 } },    // 103: -11.4 dB, bass  +4.0, treble +1.1
+    { { 269154050, -531040510, 261983251, -531057778, 262684577 }, { 290525462, -157701087, 65101704, -127294608, 56785232 } },    // 104: -11.0 dB, bass  +3.8, treble +1.1
+    { { 269122649, -531013323, 261986537, -531029829, 262657224 }, { 289528310, -156732434, 64794791, -127698900, 56854110 } },    // 105: -10.5 dB, bass  +3.7, treble +1.0
+    { { 269091266, -530986001, 261989676, -531001745, 262629743 }, { 288534574, -155768368, 64489412, -128103022, 56923184 } },    // 106: -10.0 dB, bass  +3.5, treble +1.0
+    { { 269059903, -530958542, 261992669, -530973526, 262602132 }, { 287544243, -154808868, 64185561, -128506975, 56992454 } },    // 107:  -9.5 dB, bass  +3.3, treble +1.0
+    { { 269028557, -530930946, 261995516, -530945171, 262574392 }, { 286557306, -153853918, 63883229, -128910758, 57061919 } },    // 108:  -9.0 dB, bass  +3.2, treble +0.9
+    { { 268997229, -530903212, 261998216, -530916680, 262546521 }, { 285573752, -152903498, 63582411, -129314371, 57131580 } },    // 109:  -8.6 dB, bass  +3.0, treble +0.9
+    { { 268965917, -530875340, 262000771, -530888053, 262518519 }, { 284593569, -151957589, 63283098, -129717813, 57201434 } },    // 110:  -8.1 dB, bass  +2.8, treble +0.8
+    { { 268934622, -530847329, 262003178, -530859287, 262490386 }, { 283616746, -151016173, 62985284, -130121083, 57271483 } },    // 111:  -7.6 dB, bass  +2.7, treble +0.8
+    { { 268903341, -530819179, 262005440, -530830384, 262462120 }, { 282643271, -150079232, 62688962, -130524182, 57341727 } },    // 112:  -7.1 dB, bass  +2.5, treble +0.7
+    { { 268872075, -530790888, 262007555, -530801341, 262433721 }, { 281673134, -149146748, 62394124, -130927109, 57412164 } },    // 113:  -6.7 dB, bass  +2.3, treble +0.7
+    { { 268840822, -530762457, 262009525, -530772159, 262405189 }, { 280706323, -148218701, 62100765, -131329863, 57482794 } },    // 114:  -6.2 dB, bass  +2.2, treble +0.6
+    { { 268809583, -530733885, 262011348, -530742836, 262376523 }, { 279742828, -147295074, 61808876, -131732444, 57553617 } },    // 115:  -5.7 dB, bass  +2.0, treble +0.6
+    { { 268778355, -530705171, 262013026, -530713373, 262347723 }, { 278782636, -146375849, 61518451, -132134851, 57624634 } },    // 116:  -5.2 dB, bass  +1.8, treble +0.5
+    { { 268747139, -530676314, 262014557, -530683768, 262318787 }, { 277825738, -145461008, 61229484, -132537085, 57695843 } },    // 117:  -4.8 dB, bass  +1.7, treble +0.5
+    { { 268715934, -530647314, 262015943, -530654020, 262289715 }, { 276872121, -144550532, 60941966, -132939144, 57767244 } },    // 118:  -4.3 dB, bass  +1.5, treble +0.4
+    { { 268684739, -530618171, 262017182, -530624130, 262260506 }, { 275921775, -143644403, 60655892, -133341028, 57838837 } },    // 119:  -3.8 dB, bass  +1.3, treble +0.4
+    { { 268653554, -530588884, 262018276, -530594096, 262231161 }, { 274974690, -142742604, 60371255, -133742737, 57910621 } },    // 120:  -3.3 dB, bass  +1.2, treble +0.3
+    { { 268622377, -530559451, 262019224, -530563918, 262201677 }, { 274030853, -141845117, 60088047, -134144270, 57982597 } },    // 121:  -2.9 dB, bass  +1.0, treble +0.3
+    { { 268591208, -530529873, 262020026, -530533594, 262172056 }, { 273090254, -140951925, 59806263, -134545627, 58054764 } },    // 122:  -2.4 dB, bass  +0.8, treble +0.2
+    { { 268560046, -530500149, 262020682, -530503125, 262142295 }, { 272152883, -140063008, 59525895, -134946808, 58127122 } },    // 123:  -1.9 dB, bass  +0.7, treble +0.2
+    { { 268528890, -530470277, 262021192, -530472510, 262112394 }, { 271218729, -139178350, 59246936, -135347811, 58199670 } },    // 124:  -1.4 dB, bass  +0.5, treble +0.1
+    { { 268497741, -530440259, 262021557, -530441747, 262082354 }, { 270287780, -138297934, 58969381, -135748637, 58272408 } },    // 125:  -1.0 dB, bass  +0.3, treble +0.1
+    { { 268466596, -530410092, 262021775, -530410836, 262052172 }, { 269360026, -137421741, 58693222, -136149285, 58345336 } },    // 126:  -0.5 dB, bass  +0.2, treble +0.0
+    { { 268435456, -530379777, 262021848, -530379777, 262021848 }, { 268435456, -136549755, 58418453, -136549755, 58418453 } },    // 127:  -0.0 dB, bass  +0.0, treble +0.0
+  },
+  {
+    { { 268435456, -530907136, 262537185, -530907136, 262537185 }, { 268435456, -166475222, 64514988, -166475222, 64514988 } },    //   0: mute, bass  +0.0, treble +0.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   1: -60.0 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   2: -59.5 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   3: -59.0 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   4: -58.6 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   5: -58.1 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   6: -57.6 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   7: -57.1 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   8: -56.7 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //   9: -56.2 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  10: -55.7 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  11: -55.2 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  12: -54.8 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  13: -54.3 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  14: -53.8 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  15: -53.3 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  16: -52.9 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  17: -52.4 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  18: -51.9 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  19: -51.4 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  20: -51.0 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  21: -50.5 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 391301273, -299918746, 108525702, -124910920, 56383693 } },    //  22: -50.0 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 389900826, -298319543, 107989388, -125316197, 56451412 } },    //  23: -49.5 dB, bass +15.0, treble +5.0
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 388505348, -296727565, 107455694, -125721308, 56519329 } },    //  24: -49.0 dB, bass +15.0, treble +4.9
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 387114823, -295142783, 106924607, -126126252, 56587443 } },    //  25: -48.6 dB, bass +15.0, treble +4.9
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 385729233, -293565167, 106396116, -126531029, 56655755 } },    //  26: -48.1 dB, bass +15.0, treble +4.8
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 384348561, -291994690, 105870210, -126935639, 56724263 } },    //  27: -47.6 dB, bass +15.0, treble +4.8
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 382972791, -290431322, 105346876, -127340080, 56792967 } },    //  28: -47.1 dB, bass +15.0, treble +4.7
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 381601905, -288875036, 104826103, -127744352, 56861868 } },    //  29: -46.7 dB, bass +15.0, treble +4.7
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 380235887, -287325801, 104307879, -128148455, 56930964 } },    //  30: -46.2 dB, bass +15.0, treble +4.6
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 378874720, -285783590, 103792193, -128552389, 57000256 } },    //  31: -45.7 dB, bass +15.0, treble +4.6
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 377518387, -284248375, 103279033, -128956153, 57069743 } },    //  32: -45.2 dB, bass +15.0, treble +4.5
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 376166872, -282720127, 102768389, -129359747, 57139425 } },    //  33: -44.8 dB, bass +15.0, treble +4.5
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 374820158, -281198818, 102260248, -129763169, 57209302 } },    //  34: -44.3 dB, bass +15.0, treble +4.4
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 373478229, -279684421, 101754600, -130166421, 57279373 } },    //  35: -43.8 dB, bass +15.0, treble +4.4
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 372141068, -278176907, 101251432, -130569500, 57349638 } },    //  36: -43.3 dB, bass +15.0, treble +4.3
+    { { 271104096, -532933899, 261985745, -532998005, 264590280 }, { 370808659, -276676248, 100750734, -130972408, 57420096 } },    //  37: -42.9 dB, bass +15.0, treble +4.3
+    { { 271072502, -532916157, 261998103, -532979382, 264571924 }, { 369480984, -275182417, 100252495, -131375142, 57490748 } },    //  38: -42.4 dB, bass +14.8, treble +4.2
+    { { 271040973, -532898320, 262010315, -532960671, 264553481 }, { 368158029, -273695386, 99756703, -131777704, 57561594 } },    //  39: -41.9 dB, bass +14.7, treble +4.2
+    { { 271009508, -532880387, 262022381, -532941869, 264534951 }, { 366839777, -272215128, 99263347, -132180092, 57632632 } },    //  40: -41.4 dB, bass +14.5, treble +4.1
+    { { 270978106, -532862358, 262034302, -532922977, 264516333 }, { 365526211, -270741616, 98772417, -132582306, 57703862 } },    //  41: -41.0 dB, bass +14.3, treble +4.1
+    { { 270946766, -532844232, 262046078, -532903994, 264497627 }, { 364217315, -269274821, 98283901, -132984345, 57775285 } },    //  42: -40.5 dB, bass +14.2, treble +4.0
+    { { 270915488, -532826010, 262057710, -532884920, 264478832 }, { 362913074, -267814717, 97797789, -133386210, 57846899 } },    //  43: -40.0 dB, bass +14.0, treble +4.0
+    { { 270884271, -532807690, 262069197, -532865754, 264459948 }, { 361613471, -266361276, 97314068, -133787899, 57918705 } },    //  44: -39.5 dB, bass +13.8, treble +4.0
+    { { 270853114, -532789273, 262080540, -532846496, 264440975 }, { 360318490, -264914473, 96832729, -134189412, 57990703 } },    //  45: -39.0 dB, bass +13.7, treble +3.9
+    { { 270822016, -532770758, 262091739, -532827146, 264421912 }, { 359028115, -263474278, 96353761, -134590749, 58062891 } },    //  46: -38.6 dB, bass +13.5, treble +3.9
+    { { 270790977, -532752145, 262102794, -532807702, 264402758 }, { 357742331, -262040667, 95877153, -134991910, 58135270 } },    //  47: -38.1 dB, bass +13.3, treble +3.8
+    { { 270759997, -532733433, 262113705, -532788165, 264383514 }, { 356461121, -260613612, 95402894, -135392893, 58207840 } },    //  48: -37.6 dB, bass +13.2, treble +3.8
+    { { 270729073, -532714622, 262124474, -532768534, 264364179 }, { 355184470, -259193087, 94930973, -135793699, 58280599 } },    //  49: -37.1 dB, bass +13.0, treble +3.7
+    { { 270698206, -532695712, 262135099, -532748808, 264344752 }, { 353912362, -257779064, 94461380, -136194327, 58353548 } },    //  50: -36.7 dB, bass +12.8, treble +3.7
+    { { 270667394, -532676702, 262145582, -532728988, 264325234 }, { 352644781, -256371518, 93994104, -136594777, 58426687 } },    //  51: -36.2 dB, bass +12.7, treble +3.6
+    { { 270636638, -532657592, 262155922, -532709073, 264305623 }, { 351381712, -254970423, 93529134, -136995047, 58500015 } },    //  52: -35.7 dB, bass +12.5, treble +3.6
+    { { 270605936, -532638381, 262166119, -532689061, 264285919 }, { 350123139, -253575751, 93066461, -137395139, 58573531 } },    //  53: -35.2 dB, bass +12.3, treble +3.5
+    { { 270575287, -532619069, 262176175, -532668954, 264266121 }, { 348869046, -252187477, 92606073, -137795050, 58647236 } },    //  54: -34.8 dB, bass +12.2, treble +3.5
+    { { 270544692, -532599656, 262186088, -532648750, 264246231 }, { 347619418, -250805576, 92147961, -138194782, 58721129 } },    //  55: -34.3 dB, bass +12.0, treble +3.4
+    { { 270514148, -532580141, 262195860, -532628448, 264226245 }, { 346374240, -249430019, 91692113, -138594333, 58795210 } },    //  56: -33.8 dB, bass +11.8, treble +3.4
+    { { 270483657, -532560525, 262205490, -532608049, 264206166 }, { 345133497, -248060783, 91238519, -138993703, 58869479 } },    //  57: -33.3 dB, bass +11.7, treble +3.3
+    { { 270453215, -532540805, 262214979, -532587553, 264185991 }, { 343897172, -246697841, 90787169, -139392891, 58943935 } },    //  58: -32.9 dB, bass +11.5, treble +3.3
+    { { 270422824, -532520983, 262224327, -532566957, 264165721 }, { 342665250, -245341168, 90338054, -139791898, 59018577 } },    //  59: -32.4 dB, bass +11.3, treble +3.2
+    { { 270392482, -532501058, 262233534, -532546262, 264145355 }, { 341437717, -243990738, 89891161, -140190722, 59093407 } },    //  60: -31.9 dB, bass +11.2, treble +3.2
+    { { 270362189, -532481028, 262242600, -532525468, 264124893 }, { 340214558, -242646525, 89446482, -140589364, 59168422 } },    //  61: -31.4 dB, bass +11.0, treble +3.1
+    { { 270331943, -532460895, 262251526, -532504574, 264104334 }, { 338995756, -241308504, 89004006, -140987822, 59243624 } },    //  62: -31.0 dB, bass +10.8, treble +3.1
+    { { 270301745, -532440657, 262260312, -532483580, 264083677 }, { 337781297, -239976650, 88563724, -141386097, 59319011 } },    //  63: -30.5 dB, bass +10.7, treble +3.0
+    { { 270271593, -532420315, 262268957, -532462485, 264062923 }, { 336571166, -238650938, 88125624, -141784188, 59394584 } },    //  64: -30.0 dB, bass +10.5, treble +3.0
+    { { 270241486, -532399866, 262277462, -532441288, 264042071 }, { 335365348, -237331342, 87689697, -142182094, 59470341 } },    //  65: -29.5 dB, bass +10.3, treble +3.0
+    { { 270211425, -532379313, 262285828, -532419989, 264021120 }, { 334163828, -236017838, 87255933, -142579816, 59546283 } },    //  66: -29.0 dB, bass +10.2, treble +2.9
+    { { 270181408, -532358652, 262294054, -532398588, 264000071 }, { 332966591, -234710400, 86824322, -142977352, 59622410 } },    //  67: -28.6 dB, bass +10.0, treble +2.9
+    { { 270151435, -532337886, 262302141, -532377084, 263978921 }, { 331773623, -233409004, 86394855, -143374703, 59698721 } },    //  68: -28.1 dB, bass  +9.8, treble +2.8
+    { { 270121505, -532317012, 262310088, -532355477, 263957672 }, { 330584908, -232113624, 85967520, -143771868, 59775215 } },    //  69: -27.6 dB, bass  +9.7, treble +2.8
+    { { 270091617, -532296031, 262317896, -532333766, 263936322 }, { 329400431, -230824237, 85542309, -144168846, 59851893 } },    //  70: -27.1 dB, bass  +9.5, treble +2.7
+    { { 270061770, -532274942, 262325566, -532311950, 263914871 }, { 328220179, -229540818, 85119212, -144565637, 59928754 } },    //  71: -26.7 dB, bass  +9.3, treble +2.7
+    { { 270031964, -532253744, 262333096, -532290029, 263893319 }, { 327044136, -228263342, 84698219, -144962241, 60005797 } },    //  72: -26.2 dB, bass  +9.2, treble +2.6
+    { { 270002198, -532232438, 262340488, -532268004, 263871665 }, { 325872288, -226991785, 84279320, -145358657, 60083023 } },    //  73: -25.7 dB, bass  +9.0, treble +2.6
+    { { 269972472, -532211023, 262347742, -532245872, 263849909 }, { 324704620, -225726122, 83862505, -145754885, 60160432 } },    //  74: -25.2 dB, bass  +8.8, treble +2.5
+    { { 269942785, -532189498, 262354857, -532223634, 263828050 }, { 323541118, -224466330, 83447766, -146150924, 60238022 } },    //  75: -24.8 dB, bass  +8.7, treble +2.5
+    { { 269913135, -532167862, 262361835, -532201289, 263806088 }, { 322381767, -223212384, 83035091, -146546774, 60315793 } },    //  76: -24.3 dB, bass  +8.5, treble +2.4
+    { { 269883523, -532146117, 262368674, -532178836, 263784021 }, { 321226553, -221964260, 82624473, -146942435, 60393746 } },    //  77: -23.8 dB, bass  +8.3, treble +2.4
+    { { 269853947, -532124260, 262375376, -532156276, 263761851 }, { 320075462, -220721934, 82215901, -147337906, 60471879 } },    //  78: -23.3 dB, bass  +8.2, treble +2.3
+    { { 269824408, -532102292, 262381939, -532133607, 263739576 }, { 318928478, -219485382, 81809366, -147733187, 60550193 } },    //  79: -22.9 dB, bass  +8.0, treble +2.3
+    { { 269794903, -532080211, 262388366, -532110829, 263717196 }, { 317785589, -218254582, 81404858, -148128277, 60628687 } },    //  80: -22.4 dB, bass  +7.8, treble +2.2
+    { { 269765434, -532058019, 262394655, -532087942, 263694710 }, { 316646780, -217029508, 81002369, -148523176, 60707361 } },    //  81: -21.9 dB, bass  +7.7, treble +2.2
+    { { 269735998, -532035714, 262400806, -532064944, 263672118 }, { 315512036, -215810137, 80601888, -148917884, 60786214 } },    //  82: -21.4 dB, bass  +7.5, treble +2.1
+    { { 269706595, -532013295, 262406821, -532041836, 263649419 }, { 314381343, -214596446, 80203406, -149312400, 60865247 } },    //  83: -21.0 dB, bass  +7.3, treble +2.1
+    { { 269677225, -531990763, 262412698, -532018617, 263626613 }, { 313254688, -213388412, 79806915, -149706724, 60944458 } },    //  84: -20.5 dB, bass  +7.2, treble +2.0
+    { { 269647886, -531968116, 262418439, -531995286, 263603699 }, { 312132056, -212186010, 79412404, -150100855, 61023848 } },    //  85: -20.0 dB, bass  +7.0, treble +2.0
+    { { 269618579, -531945355, 262424043, -531971844, 263580677 }, { 311013433, -210989219, 79019865, -150494793, 61103416 } },    //  86: -19.5 dB, bass  +6.8, treble +2.0
+    { { 269589302, -531922478, 262429510, -531948288, 263557547 }, { 309898806, -209798014, 78629289, -150888537, 61183162 } },    //  87: -19.0 dB, bass  +6.7, treble +1.9
+    { { 269560055, -531899486, 262434841, -531924619, 263534307 }, { 308788160, -208612373, 78240666, -151282088, 61263086 } },    //  88: -18.6 dB, bass  +6.5, treble +1.9
+    { { 269530837, -531876377, 262440035, -531900837, 263510957 }, { 307681482, -207432272, 77853987, -151675444, 61343186 } },    //  89: -18.1 dB, bass  +6.3, treble +1.8
+    { { 269501648, -531853152, 262445094, -531876940, 263487498 }, { 306578758, -206257689, 77469244, -152068606, 61423464 } },    //  90: -17.6 dB, bass  +6.2, treble +1.8
+    { { 269472486, -531829810, 262450016, -531852928, 263463928 }, { 305479974, -205088600, 77086427, -152461573, 61503918 } },    //  91: -17.1 dB, bass  +6.0, treble +1.7
+    { { 269443351, -531806351, 262454801, -531828801, 263440246 }, { 304385116, -203924984, 76705528, -152854344, 61584548 } },    //  92: -16.7 dB, bass  +5.8, treble +1.7
+    { { 269414243, -531782773, 262459451, -531804558, 263416453 }, { 303294171, -202766817, 76326537, -153246919, 61665354 } },    //  93: -16.2 dB, bass  +5.7, treble +1.6
+    { { 269385160, -531759076, 262463965, -531780198, 263392548 }, { 302207126, -201614077, 75949445, -153639299, 61746336 } },    //  94: -15.7 dB, bass  +5.5, treble +1.6
+    { { 269356102, -531735261, 262468343, -531755721, 263368529 }, { 301123965, -200466742, 75574244, -154031481, 61827493 } },    //  95: -15.2 dB, bass  +5.3, treble +1.5
+    { { 269327069, -531711325, 262472586, -531731127, 263344398 }, { 300044677, -199324788, 75200925, -154423467, 61908824 } },    //  96: -14.8 dB, bass  +5.2, treble +1.5
+    { { 269298059, -531687270, 262476693, -531706414, 263320153 }, { 298969247, -198188194, 74829479, -154815255, 61990331 } },    //  97: -14.3 dB, bass  +5.0, treble +1.4
+    { { 269269073, -531663094, 262480664, -531681582, 263295793 }, { 297897662, -197056938, 74459897, -155206846, 62072011 } },    //  98: -13.8 dB, bass  +4.8, treble +1.4
+    { { 269240108, -531638797, 262484500, -531656631, 263271319 }, { 296829909, -195930997, 74092171, -155598238, 62153865 } },    //  99: -13.3 dB, bass  +4.7, treble +1.3
+    { { 269211166, -531614379, 262488201, -531631561, 263246729 }, { 295765974, -194810349, 73726292, -155989432, 62235893 } },    // 100: -12.9 dB, bass  +4.5, treble +1.3
+    { { 269182244, -531589838, 262491767, -531606369, 263222023 }, { 294705845, -193694972, 73362251, -156380426, 62318094 } },    // 101: -12.4 dB, bass  +4.3, treble +1.2
+    { { 269153343, -531565174, 262495197, -531581057, 263197201 }, { 293649506, -192584844, 73000040, -156771222, 62400468 } },    // 102: -11.9 dB, bass  +4.2, treble +1.2
+    { { 269124461, -531540388, 262498492, -531555623, 263172262 }, { 292596947, -191479944, 72639650, -157161817, 62483014 } },    // 103: -11.4 dB, bass  +4.0, treble +1.1
+    { { 269095598, -531515477, 262501652, -531530066, 263147205 }, { 291548153, -190380250, 72281073, -157552213, 62565733 } },    // 104: -11.0 dB, bass  +3.8, treble +1.1
+    { { 269066754, -531490442, 262504677, -531504387, 263122030 }, { 290503111, -189285739, 71924299, -157942408, 62648623 } },    // 105: -10.5 dB, bass  +3.7, treble +1.0
+    { { 269037927, -531465283, 262507568, -531478584, 263096737 }, { 289461808, -188196391, 71569322, -158332402, 62731685 } },    // 106: -10.0 dB, bass  +3.5, treble +1.0
+    { { 269009117, -531439998, 262510323, -531452657, 263071324 }, { 288424231, -187112184, 71216131, -158722196, 62814918 } },    // 107:  -9.5 dB, bass  +3.3, treble +1.0
+    { { 268980323, -531414587, 262512944, -531426606, 263045792 }, { 287390367, -186033097, 70864720, -159111787, 62898321 } },    // 108:  -9.0 dB, bass  +3.2, treble +0.9
+    { { 268951545, -531389050, 262515429, -531400429, 263020140 }, { 286360204, -184959107, 70515079, -159501176, 62981895 } },    // 109:  -8.6 dB, bass  +3.0, treble +0.9
+    { { 268922782, -531363386, 262517781, -531374127, 262994366 }, { 285333727, -183890195, 70167200, -159890363, 63065640 } },    // 110:  -8.1 dB, bass  +2.8, treble +0.8
+    { { 268894033, -531337595, 262519997, -531347698, 262968471 }, { 284310925, -182826338, 69821075, -160279348, 63149554 } },    // 111:  -7.6 dB, bass  +2.7, treble +0.8
+    { { 268865298, -531311675, 262522079, -531321142, 262942455 }, { 283291784, -181767516, 69476696, -160668129, 63233637 } },    // 112:  -7.1 dB, bass  +2.5, treble +0.7
+    { { 268836576, -531285627, 262524027, -531294459, 262916316 }, { 282276292, -180713708, 69134054, -161056707, 63317890 } },    // 113:  -6.7 dB, bass  +2.3, treble +0.7
+    { { 268807866, -531259450, 262525840, -531267647, 262890053 }, { 281264436, -179664892, 68793142, -161445081, 63402311 } },    // 114:  -6.2 dB, bass  +2.2, treble +0.6
+    { { 268779168, -531233143, 262527518, -531240706, 262863668 }, { 280256204, -178621048, 68453951, -161833250, 63486901 } },    // 115:  -5.7 dB, bass  +2.0, treble +0.6
+    { { 268750481, -531206706, 262529063, -531213636, 262837157 }, { 279251581, -177582154, 68116472, -162221215, 63571659 } },    // 116:  -5.2 dB, bass  +1.8, treble +0.5
+    { { 268721804, -531180138, 262530472, -531186435, 262810523 }, { 278250557, -176548191, 67780699, -162608975, 63656584 } },    // 117:  -4.8 dB, bass  +1.7, treble +0.5
+    { { 268693136, -531153438, 262531748, -531159104, 262783762 }, { 277253118, -175519138, 67446623, -162996530, 63741677 } },    // 118:  -4.3 dB, bass  +1.5, treble +0.4
+    { { 268664478, -531126607, 262532889, -531131642, 262756876 }, { 276259252, -174494974, 67114235, -163383879, 63826937 } },    // 119:  -3.8 dB, bass  +1.3, treble +0.4
+    { { 268635828, -531099643, 262533896, -531104047, 262729864 }, { 275268947, -173475678, 66783529, -163771022, 63912364 } },    // 120:  -3.3 dB, bass  +1.2, treble +0.3
+    { { 268607186, -531072546, 262534768, -531076320, 262702724 }, { 274282189, -172461230, 66454495, -164157958, 63997956 } },    // 121:  -2.9 dB, bass  +1.0, treble +0.3
+    { { 268578551, -531045315, 262535507, -531048460, 262675457 }, { 273298967, -171451610, 66127127, -164544688, 64083715 } },    // 122:  -2.4 dB, bass  +0.8, treble +0.2
+    { { 268549922, -531017950, 262536111, -531020465, 262648061 }, { 272319267, -170446798, 65801416, -164931211, 64169640 } },    // 123:  -1.9 dB, bass  +0.7, treble +0.2
+    { { 268521298, -530990451, 262536580, -530992336, 262620537 }, { 271343079, -169446773, 65477354, -165317526, 64255730 } },    // 124:  -1.4 dB, bass  +0.5, treble +0.1
+    { { 268492680, -530962815, 262536916, -530964072, 262592883 }, { 270370389, -168451515, 65154934, -165703633, 64341985 } },    // 125:  -1.0 dB, bass  +0.3, treble +0.1
+    { { 268464066, -530935044, 262537117, -530935672, 262565099 }, { 269401186, -167461005, 64834148, -166089532, 64428404 } },    // 126:  -0.5 dB, bass  +0.2, treble +0.0
+    { { 268435456, -530907136, 262537185, -530907136, 262537185 }, { 268435456, -166475222, 64514988, -166475222, 64514988 } },    // 127:  -0.0 dB, bass  +0.0, treble +0.0
+  },
+};
+
+#endif
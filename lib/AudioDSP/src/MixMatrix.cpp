@@ -0,0 +1,149 @@
+/*
+  MixMatrix.cpp - channel routing and mixing: every output a weighted sum of the inputs
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "MixMatrix.h"
+
+static const char *const mixPresetNames[] = { "stereo", "mono", "swap", "crossfeed", "custom" };
+
+static inline int32_t saturate(int64_t x) {
+  return x > INT32_MAX ? INT32_MAX : x < INT32_MIN ? INT32_MIN : (int32_t)x;
+}
+
+// the channel counts are constants, so the gains stay in registers and both channel loops unroll
+template <uint8_t N, uint8_t M>
+static void mixFixed(const MixConfig &c, const int32_t *__restrict in, int32_t *__restrict out, uint16_t frames) {
+  int32_t g[M][N];
+  for (uint8_t o = 0; o < M; o++) {
+    for (uint8_t i = 0; i < N; i++) g[o][i] = c.gain[o][i];
+  }
+  for (uint16_t f = 0; f < frames; f++, in += N, out += M) {
+    for (uint8_t o = 0; o < M; o++) {
+      int64_t acc = 0;
+      for (uint8_t i = 0; i < N; i++) acc += (int64_t)g[o][i] * in[i];
+      out[o] = saturate(acc >> MIX_COEF_SHIFT);
+    }
+  }
+}
+
+void MixMatrix::generic(const MixConfig &c, const int32_t *__restrict in, int32_t *__restrict out, uint16_t frames) {
+  const uint8_t inputs = c.inputs, outputs = c.outputs;
+  for (uint16_t f = 0; f < frames; f++, in += inputs, out += outputs) {
+    for (uint8_t o = 0; o < outputs; o++) {
+      int64_t acc = 0;
+      for (uint8_t i = 0; i < inputs; i++) acc += (int64_t)c.gain[o][i] * in[i];
+      out[o] = saturate(acc >> MIX_COEF_SHIFT);
+    }
+  }
+}
+
+MixKernel MixMatrix::kernelFor(uint8_t inputs, uint8_t outputs) {
+  if (inputs == 2 && outputs == 2) return mixFixed<2, 2>;
+  if (inputs == 2 && outputs == 1) return mixFixed<2, 1>;
+  if (inputs == 1 && outputs == 2) return mixFixed<1, 2>;
+  return generic;
+}
+
+void MixMatrix::mix(const MixConfig &c, const int32_t *in, int32_t *out, uint16_t frames) {
+  if (c.kernel) c.kernel(c, in, out, frames);
+  else memcpy(out, in, (size_t)frames * c.inputs * sizeof(int32_t));
+}
+
+MixMatrix::MixMatrix() : _preset(MIX_STEREO), _running(false) {
+  setPreset(MIX_STEREO);
+}
+
+// ----------------------------------------------------------------
+//                      -audio side
+// ----------------------------------------------------------------
+
+// the block through c into out; false if c leaves it as it is, or does not fit its layout
+bool MixMatrix::apply(const MixConfig &c, const AudioBlock &block, int32_t *out) {
+  if (!c.kernel || c.inputs != block.channels || c.outputs != block.channels) return false;
+  c.kernel(c, block.samples, out, block.frames);
+  return true;
+}
+
+void MixMatrix::process(AudioBlock &block) {
+  const size_t bytes = (size_t)block.frames * block.channels * sizeof(int32_t);
+  bool fade = false;
+  if (_configs.acquire() && _running) {
+    if (!apply(_configs.previous(), block, _old)) memcpy(_old, block.samples, bytes);
+    fade = true;
+  }
+  if (apply(_configs.current(), block, _mixed)) memcpy(block.samples, _mixed, bytes);
+  if (fade) audioBlockCrossfade(block, _old);
+  _running = true;
+}
+
+// ----------------------------------------------------------------
+//                      -control side
+// ----------------------------------------------------------------
+
+const char *MixMatrix::presetName(MixPreset preset) {
+  return preset <= MIX_CUSTOM ? mixPresetNames[preset] : "";
+}
+
+bool MixMatrix::presetFromName(const char *name, MixPreset &preset) {
+  for (uint8_t i = 0; i < MIX_CUSTOM; i++) {
+    if (strcmp(name, mixPresetNames[i]) == 0) {
+      preset = (MixPreset)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MixMatrix::configure(uint8_t inputs, uint8_t outputs, const float *gains, bool generic, MixPreset preset) {
+  if (!inputs || inputs > MIX_MAX_INPUTS || !outputs || outputs > MIX_MAX_OUTPUTS || !gains) return false;
+  MixConfig &c = _configs.edit();
+  memset(&c, 0, sizeof(c));
+  c.inputs = inputs;
+  c.outputs = outputs;
+  bool identity = inputs == outputs;
+  for (uint8_t o = 0; o < outputs; o++) {
+    for (uint8_t i = 0; i < inputs; i++) {
+      float g = gains[o * inputs + i];
+      g = g > 16.0f ? 16.0f : g < -16.0f ? -16.0f : g;
+      c.gain[o][i] = (int32_t)lrintf(g * MIX_UNITY);
+      if (c.gain[o][i] != (o == i ? MIX_UNITY : 0)) identity = false;
+    }
+  }
+  c.kernel = identity ? NULL : generic ? MixMatrix::generic : kernelFor(inputs, outputs);
+  c.preset = preset;
+  _configs.publish();
+  _preset = preset;
+  return true;
+}
+
+bool MixMatrix::setMatrix(uint8_t inputs, uint8_t outputs, const float *gains, bool generic) {
+  return configure(inputs, outputs, gains, generic, MIX_CUSTOM);
+}
+
+bool MixMatrix::setPreset(MixPreset preset) {
+  // centred sound keeps its level in the crossfeed: the two gains add up to one
+  const float cross = powf(10.0f, MIX_CROSSFEED_DB / 20.0f) / (1.0f + powf(10.0f, MIX_CROSSFEED_DB / 20.0f));
+  switch (preset) {
+    case MIX_STEREO: {
+      static const float g[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+      return configure(2, 2, g, false, preset);
+    }
+    case MIX_MONO: {
+      static const float g[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+      return configure(2, 2, g, false, preset);
+    }
+    case MIX_SWAP: {
+      static const float g[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+      return configure(2, 2, g, false, preset);
+    }
+    case MIX_CROSSFEED: {
+      const float g[4] = { 1.0f - cross, cross, cross, 1.0f - cross };
+      return configure(2, 2, g, false, preset);
+    }
+    default:
+      return false;
+  }
+}
@@ -0,0 +1,87 @@
+/*
+  MixMatrix.h - channel routing and mixing: every output a weighted sum of the inputs
+
+  A matrix of Q16 gains (MIX_UNITY = 1.0), outputs x inputs, covers mono
+  downmix, L/R swap, a flat headphone crossfeed and routing to more
+  outputs than inputs, such as a 2.1 subwoofer feed or the slots of a TDM
+  frame.  In the chain the block keeps its layout, so there the matrix is
+  square with at most AUDIO_MAX_CHANNELS; mix() runs any matrix up to
+  MIX_MAX_INPUTS x MIX_MAX_OUTPUTS between buffers of its own.
+
+  setMatrix() picks the kernel when the matrix is set.  The common shapes
+  (2x2, 2x1, 1x2) are instances of one template with the channel counts as
+  constants: the gains sit in registers, the loops unroll, and on the host
+  the frame loop vectorizes.  Other shapes take the generic kernel, which
+  loops over the channel counts at run time.  An identity matrix costs
+  nothing.  Every product is one 32x32->64 multiply, the sum saturates to
+  32 bits.
+
+  A new matrix goes through a ParamStore; the block that picks it up runs
+  the old one as well and cross-fades, so switching presets does not
+  click.
+*/
+
+#ifndef MIXMATRIX_H_
+#define MIXMATRIX_H_
+
+#include "AudioStage.h"
+#include "ParamStore.h"
+
+#define MIX_MAX_INPUTS      4
+#define MIX_MAX_OUTPUTS     4
+#define MIX_COEF_SHIFT      16
+#define MIX_UNITY           (1 << MIX_COEF_SHIFT)
+#define MIX_CROSSFEED_DB    -9.5f               // the other side's level in the crossfeed preset
+
+enum MixPreset : uint8_t {
+  MIX_STEREO,                                   // as it comes
+  MIX_MONO,                                     // (L + R) / 2 on both
+  MIX_SWAP,                                     // L and R exchanged
+  MIX_CROSSFEED,                                // each side with some of the other, for headphones
+  MIX_CUSTOM                                    // from setMatrix()
+};
+
+struct MixConfig;
+typedef void (*MixKernel)(const MixConfig &c, const int32_t *__restrict in, int32_t *__restrict out, uint16_t frames);
+
+struct MixConfig {
+  uint8_t inputs, outputs;
+  int32_t gain[MIX_MAX_OUTPUTS][MIX_MAX_INPUTS];    // Q16, out[o] = sum of gain[o][i] * in[i]
+  MixKernel kernel;                                 // NULL: identity
+  MixPreset preset;
+};
+
+class MixMatrix : public AudioStage {
+  public:
+    MixMatrix();
+
+    const char *name() const override { return "mix"; }
+    void reset() override { _running = false; }
+    void process(AudioBlock &block) override;
+
+    // control side, one task; gains are linear, row by row (one row per output)
+    bool setMatrix(uint8_t inputs, uint8_t outputs, const float *gains, bool generic = false);
+    bool setPreset(MixPreset preset);
+    MixPreset preset() const { return _preset; }
+    static const char *presetName(MixPreset preset);
+    static bool presetFromName(const char *name, MixPreset &preset);
+
+    // kernels, also for use outside the chain; in and out must not overlap
+    static MixKernel kernelFor(uint8_t inputs, uint8_t outputs);    // the specialised one, or generic
+    static void generic(const MixConfig &c, const int32_t *__restrict in, int32_t *__restrict out, uint16_t frames);
+    static void mix(const MixConfig &c, const int32_t *in, int32_t *out, uint16_t frames);
+
+  private:
+    bool configure(uint8_t inputs, uint8_t outputs, const float *gains, bool generic, MixPreset preset);
+    static bool apply(const MixConfig &c, const AudioBlock &block, int32_t *out);
+
+    ParamStore<MixConfig> _configs;
+    volatile MixPreset _preset;                     // control side copy, for reading back
+
+    // audio side
+    bool _running;                                  // has seen a block: changes fade
+    int32_t _mixed[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];
+    int32_t _old[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];
+};
+
+#endif
@@ -0,0 +1,90 @@
+/*
+  OutputFormat.cpp - packs Q8.23 samples into the words the I2S DMA sends
+*/
+
+#include "OutputFormat.h"
+
+#define OUTPUT_LSB      (1 << AUDIO_SAMPLE_SHIFT)          // one 16 bit step in Q8.23
+
+OutputFormat::OutputFormat() : _bits(16), _dither(OUTPUT_DITHER_NONE), _seed(0x2545F491) {
+  reset();
+}
+
+bool OutputFormat::setBits(uint8_t bits) {
+  if (bits != 16 && bits != 24 && bits != 32) return false;
+  _bits = bits;
+  reset();
+  return true;
+}
+
+const char *OutputFormat::ditherName(OutputDither dither) {
+  switch (dither) {
+    case OUTPUT_DITHER_TPDF: return "tpdf";
+    case OUTPUT_DITHER_SHAPED: return "shaped";
+    default: return "none";
+  }
+}
+
+void OutputFormat::reset() {
+  _active = false;
+  for (uint8_t c = 0; c < AUDIO_MAX_CHANNELS; c++) _error[c] = 0;
+}
+
+template <OutputDither mode>
+void OutputFormat::pack16(const int32_t *in, size_t frames, uint8_t channels, int16_t *out) {
+  uint32_t seed = _seed;
+  int32_t any = 0;
+  const bool dither = mode != OUTPUT_DITHER_NONE && _active;
+
+  for (size_t i = 0; i < frames; i++) {
+    for (uint8_t c = 0; c < channels; c++, in++, out++) {
+      const int32_t x = *in;
+      any |= x;
+      int32_t v = x;
+      if (mode == OUTPUT_DITHER_SHAPED) v -= _error[c];
+      int32_t d = 0;
+      if (dither) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        // difference of two 16 bit uniforms, scaled to +/-1 LSB: triangular
+        d = ((int32_t)(seed & 0xFFFF) - (int32_t)(seed >> 16)) >> (16 - AUDIO_SAMPLE_SHIFT);
+      }
+      int32_t q = (v + d + (OUTPUT_LSB >> 1)) >> AUDIO_SAMPLE_SHIFT;
+      if (q > INT16_MAX) q = INT16_MAX;
+      else if (q < INT16_MIN) q = INT16_MIN;
+      if (mode == OUTPUT_DITHER_SHAPED) {
+        const int32_t e = q * OUTPUT_LSB - v;
+        // a clipped sample would feed back its overshoot; drop it instead
+        _error[c] = e > 2 * OUTPUT_LSB || e < -2 * OUTPUT_LSB ? 0 : e;
+      }
+      *out = (int16_t)q;
+    }
+  }
+
+  _seed = seed;
+  _active = any != 0;
+  if (!_active && mode == OUTPUT_DITHER_SHAPED) for (uint8_t c = 0; c < channels; c++) _error[c] = 0;
+}
+
+size_t OutputFormat::pack(const int32_t *in, size_t frames, uint8_t channels, void *out) {
+  const size_t count = frames * channels;
+  if (_bits == 16) {
+    switch (_dither) {
+      case OUTPUT_DITHER_TPDF: pack16<OUTPUT_DITHER_TPDF>(in, frames, channels, (int16_t *)out); break;
+      case OUTPUT_DITHER_SHAPED: pack16<OUTPUT_DITHER_SHAPED>(in, frames, channels, (int16_t *)out); break;
+      default: pack16<OUTPUT_DITHER_NONE>(in, frames, channels, (int16_t *)out); break;
+    }
+    return count * sizeof(int16_t);
+  }
+
+  // 24 significant bits, MSB aligned in 32 bit slots
+  int32_t *o = (int32_t *)out;
+  for (size_t i = 0; i < count; i++) {
+    int32_t s = in[i];
+    if (s > AUDIO_FULL_SCALE - 1) s = AUDIO_FULL_SCALE - 1;
+    else if (s < -AUDIO_FULL_SCALE) s = -AUDIO_FULL_SCALE;
+    o[i] = (int32_t)((uint32_t)s << 8);
+  }
+  return count * sizeof(int32_t);
+}
@@ -0,0 +1,68 @@
+/*
+  OutputFormat.h - packs Q8.23 samples into the words the I2S DMA sends
+
+  The last step of the output path, done in the same pass that fills the
+  DMA buffer:
+
+    16 bit   rounded to the 16 bit LSB, optionally dithered, saturated,
+             two samples per 32 bit word
+    24 bit   the full Q8.23 word, saturated at full scale, MSB aligned in
+             a 32 bit slot (how the ESP32 I2S sends 24 bit audio)
+    32 bit   the same 24 significant bits in a 32 bit slot, for DACs that
+             only take 32 bit frames
+
+  Whether the data starts one bit clock after the word select edge (I2S
+  standard) or on it (left justified) is the I2S driver's
+  communication_format; the words are the same either way.
+
+  Only the 16 bit format throws bits away, so only it dithers:
+    OUTPUT_DITHER_TPDF    +/-1 LSB triangular dither; the rounding error
+                          becomes signal-independent white noise
+    OUTPUT_DITHER_SHAPED  the same plus first-order error feedback, which
+                          tilts that noise towards high frequencies (about
+                          +3 dB total, much less in the midrange)
+  The random numbers are a 32 bit xorshift, one draw per sample for both
+  uniform halves.  Dither stops after a block of digital silence, so a
+  paused stream stays silent instead of hissing.
+*/
+
+#ifndef OUTPUTFORMAT_H_
+#define OUTPUTFORMAT_H_
+
+#include "AudioBlock.h"
+
+enum OutputDither : uint8_t {
+  OUTPUT_DITHER_NONE,
+  OUTPUT_DITHER_TPDF,
+  OUTPUT_DITHER_SHAPED
+};
+
+class OutputFormat {
+  public:
+    OutputFormat();
+
+    // setup; the I2S driver must be configured for the same width
+    bool setBits(uint8_t bits);                 // 16, 24 or 32
+    uint8_t bits() const { return _bits; }
+    size_t bytesPerSample() const { return _bits == 16 ? 2 : 4; }
+    static const char *ditherName(OutputDither dither);
+
+    // any task
+    void setDither(OutputDither dither) { _dither = dither; }
+    OutputDither dither() const { return _dither; }
+
+    // audio task: count interleaved samples (frames * channels) in, bytes of DMA data out
+    size_t pack(const int32_t *in, size_t frames, uint8_t channels, void *out);
+    void reset();
+
+  private:
+    template <OutputDither mode> void pack16(const int32_t *in, size_t frames, uint8_t channels, int16_t *out);
+
+    uint8_t _bits;
+    volatile OutputDither _dither;
+    uint32_t _seed;
+    bool _active;                               // last block was not digital silence
+    int32_t _error[AUDIO_MAX_CHANNELS];         // noise shaping feedback, Q8.23
+};
+
+#endif
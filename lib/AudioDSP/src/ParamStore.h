@@ -0,0 +1,56 @@
+/*
+  ParamStore.h - lock-free handover of parameter sets from a control task to the audio task
+
+  A set (filter coefficients, a table row, ...) is never changed once the
+  audio task can see it.  The writer fills the set edit() returns, which
+  nobody else touches, and publish() hands it over with one atomic
+  exchange.  The audio task calls acquire() at the start of a block: if a
+  set was published since, it becomes current() and the one it replaces
+  stays readable as previous() until the next acquire(), so the block can
+  run both and cross-fade from the old output to the new one.  Neither
+  side ever waits for the other.
+
+  There are four slots: the writer's, the published one, and the audio
+  task's current and previous ones.  A writer that publishes faster than
+  the audio task acquires just replaces the set waiting in between, so
+  only the latest reaches the audio.  One task writes, one task reads.
+*/
+
+#ifndef PARAMSTORE_H_
+#define PARAMSTORE_H_
+
+#include <stdint.h>
+#include <atomic>
+
+template <typename T>
+class ParamStore {
+  public:
+    ParamStore() : _slots(), _back(0), _middle(1), _front(2), _retired(3) {}
+
+    // writer: build a complete set in edit(), then publish() it
+    T &edit() { return _slots[_back]; }
+    void publish() {
+      _back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+    }
+
+    // audio task, once per block before it reads current() or previous()
+    bool acquire() {
+      if (!(_middle.load(std::memory_order_acquire) & FRESH)) return false;
+      const uint8_t fresh = _middle.exchange(_retired, std::memory_order_acq_rel) & ~FRESH;
+      _retired = _front;
+      _front = fresh;
+      return true;
+    }
+    const T &current() const { return _slots[_front]; }
+    const T &previous() const { return _slots[_retired]; }     // what current() replaced at the last acquire()
+
+  private:
+    static const uint8_t FRESH = 0x80;                          // in _middle: a set acquire() has not taken
+
+    T _slots[4];
+    uint8_t _back;                                              // writer side
+    std::atomic<uint8_t> _middle;
+    uint8_t _front, _retired;                                   // audio side
+};
+
+#endif
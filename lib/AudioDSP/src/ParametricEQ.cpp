@@ -0,0 +1,228 @@
+/*
+  ParametricEQ.cpp - cascaded biquad parametric/shelving equalizer stage
+
+  Filter designs are the RBJ audio EQ cookbook ones.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ParametricEQ.h"
+
+static const char *const eqTypeNames[] = { "peak", "lowshelf", "highshelf", "lowpass", "highpass" };
+
+static int32_t toCoef(float x) {
+  return (int32_t)lrintf(x * (float)(1 << EQ_COEF_SHIFT));
+}
+
+static float clampf(float x, float lo, float hi) {
+  return x < lo ? lo : (x > hi ? hi : x);
+}
+
+ParametricEQ::ParametricEQ() : _dirty(true), _designedRate(0), _sampleRate(44100), _running(false) {
+  _lock = portMUX_INITIALIZER_UNLOCKED;
+  memset(&_state, 0, sizeof(_state));
+  for (uint8_t i = 0; i < EQ_MAX_BANDS; i++) _bands[i] = { EQ_PEAK, false, 1000.0f, 0.0f, 0.707f };
+}
+
+// ----------------------------------------------------------------
+//                      -audio side
+// ----------------------------------------------------------------
+
+void ParametricEQ::begin(uint32_t sampleRate, uint8_t channels) {
+  (void)channels;
+  _sampleRate = sampleRate;         // update() notices and redesigns for the new rate
+  reset();
+}
+
+void ParametricEQ::reset() {
+  memset(&_state, 0, sizeof(_state));
+  _running = false;
+}
+
+void ParametricEQ::process(AudioBlock &block) {
+  bool fade = false;
+  if (_coeffs.acquire()) {
+    // the block as the old coefficients would have left it, from a copy of their state, to fade from; nothing
+    // to fade from before the first block
+    if (_running) {
+      memcpy(_old, block.samples, (size_t)block.frames * block.channels * sizeof(int32_t));
+      const EqCoeffs &old = _coeffs.previous();
+      if (applies(old)) {
+        EqState state = _state;
+        filter(old, state, _old, block.frames, block.channels);
+      }
+      fade = true;
+    }
+    // bands that are off now start from silence if they are switched back on
+    const uint32_t mask = _coeffs.current().activeMask;
+    for (uint8_t b = 0; b < EQ_MAX_BANDS; b++) {
+      if (mask & (1u << b)) continue;
+      for (uint8_t ch = 0; ch < AUDIO_MAX_CHANNELS; ch++) _state.s1[ch][b] = _state.s2[ch][b] = 0;
+    }
+  }
+
+  const EqCoeffs &c = _coeffs.current();
+  if (applies(c)) filter(c, _state, block.samples, block.frames, block.channels);
+  if (fade) audioBlockCrossfade(block, _old);
+  _running = true;
+}
+
+void ParametricEQ::filter(const EqCoeffs &c, EqState &state, int32_t *samples, uint16_t frames, uint8_t channels) {
+  for (uint8_t b = 0; b < EQ_MAX_BANDS; b++) {
+    if (!(c.activeMask & (1u << b))) continue;
+    // 32 bit operands so every product is a single 32x32->64 multiply
+    const int32_t b0 = c.b0[b], b1 = c.b1[b], b2 = c.b2[b], a1 = c.a1[b], a2 = c.a2[b];
+
+    for (uint8_t ch = 0; ch < channels; ch++) {
+      int64_t s1 = state.s1[ch][b];
+      int64_t s2 = state.s2[ch][b];
+      int32_t *s = samples + ch;
+      for (size_t i = 0; i < frames; i++, s += channels) {
+        const int32_t x = *s;
+        int64_t acc = ((int64_t)b0 * x + s1) >> EQ_COEF_SHIFT;
+        if (acc > INT32_MAX) acc = INT32_MAX;
+        else if (acc < INT32_MIN) acc = INT32_MIN;
+        const int32_t y = (int32_t)acc;
+        s1 = (int64_t)b1 * x - (int64_t)a1 * y + s2;
+        s2 = (int64_t)b2 * x - (int64_t)a2 * y;
+        *s = y;
+      }
+      state.s1[ch][b] = s1;
+      state.s2[ch][b] = s2;
+    }
+  }
+}
+
+// ----------------------------------------------------------------
+//                      -control side
+// ----------------------------------------------------------------
+
+const char *ParametricEQ::typeName(EqBandType type) {
+  return type <= EQ_HIGH_PASS ? eqTypeNames[type] : "";
+}
+
+bool ParametricEQ::typeFromName(const char *name, EqBandType &type) {
+  for (uint8_t i = 0; i <= EQ_HIGH_PASS; i++) {
+    if (strcmp(name, eqTypeNames[i]) == 0) {
+      type = (EqBandType)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParametricEQ::setBand(uint8_t index, const EqBand &band) {
+  if (index >= EQ_MAX_BANDS) return false;
+  EqBand b = band;
+  b.freq = clampf(b.freq, 10.0f, 24000.0f);
+  b.gainDb = clampf(b.gainDb, EQ_GAIN_MIN_DB, EQ_GAIN_MAX_DB);
+  b.q = clampf(b.q, EQ_Q_MIN, EQ_Q_MAX);
+  portENTER_CRITICAL(&_lock);
+  _bands[index] = b;
+  _dirty = true;
+  portEXIT_CRITICAL(&_lock);
+  return true;
+}
+
+EqBand ParametricEQ::band(uint8_t index) const {
+  if (index >= EQ_MAX_BANDS) index = EQ_MAX_BANDS - 1;
+  portENTER_CRITICAL(&_lock);
+  EqBand b = _bands[index];
+  portEXIT_CRITICAL(&_lock);
+  return b;
+}
+
+void ParametricEQ::setFlat() {
+  portENTER_CRITICAL(&_lock);
+  for (uint8_t i = 0; i < EQ_MAX_BANDS; i++) _bands[i].gainDb = 0.0f;
+  _dirty = true;
+  portEXIT_CRITICAL(&_lock);
+}
+
+bool ParametricEQ::update() {
+  const uint32_t rate = _sampleRate;
+  EqBand bands[EQ_MAX_BANDS];
+  portENTER_CRITICAL(&_lock);
+  bool dirty = _dirty || _designedRate != rate;
+  memcpy(bands, _bands, sizeof(bands));
+  _dirty = false;
+  portEXIT_CRITICAL(&_lock);
+  if (!dirty) return false;
+
+  EqCoeffs &c = _coeffs.edit();
+  c.activeMask = 0;
+  c.sampleRate = rate;
+  for (uint8_t i = 0; i < EQ_MAX_BANDS; i++) design(bands[i], rate, c, i);
+
+  _coeffs.publish();
+  _designedRate = rate;
+  return true;
+}
+
+void ParametricEQ::design(const EqBand &band, uint32_t sampleRate, EqCoeffs &c, uint8_t index) {
+  c.b0[index] = 1 << EQ_COEF_SHIFT;
+  c.b1[index] = c.b2[index] = c.a1[index] = c.a2[index] = 0;
+  if (!band.enabled) return;
+  const bool shaping = band.type == EQ_PEAK || band.type == EQ_LOW_SHELF || band.type == EQ_HIGH_SHELF;
+  if (shaping && fabsf(band.gainDb) < 0.05f) return;        // flat; skip it on the audio task
+
+  const float freq = clampf(band.freq, 10.0f, 0.45f * sampleRate);
+  const float w0 = 2.0f * (float)M_PI * freq / sampleRate;
+  const float cw = cosf(w0);
+  const float alpha = sinf(w0) / (2.0f * band.q);
+  const float A = powf(10.0f, band.gainDb / 40.0f);
+  const float sqA2a = 2.0f * sqrtf(A) * alpha;
+  float b0, b1, b2, a0, a1, a2;
+
+  switch (band.type) {
+    case EQ_LOW_SHELF:
+      b0 = A * ((A + 1) - (A - 1) * cw + sqA2a);
+      b1 = 2 * A * ((A - 1) - (A + 1) * cw);
+      b2 = A * ((A + 1) - (A - 1) * cw - sqA2a);
+      a0 = (A + 1) + (A - 1) * cw + sqA2a;
+      a1 = -2 * ((A - 1) + (A + 1) * cw);
+      a2 = (A + 1) + (A - 1) * cw - sqA2a;
+      break;
+    case EQ_HIGH_SHELF:
+      b0 = A * ((A + 1) + (A - 1) * cw + sqA2a);
+      b1 = -2 * A * ((A - 1) + (A + 1) * cw);
+      b2 = A * ((A + 1) + (A - 1) * cw - sqA2a);
+      a0 = (A + 1) - (A - 1) * cw + sqA2a;
+      a1 = 2 * ((A - 1) - (A + 1) * cw);
+      a2 = (A + 1) - (A - 1) * cw - sqA2a;
+      break;
+    case EQ_LOW_PASS:
+      b0 = (1 - cw) / 2;
+      b1 = 1 - cw;
+      b2 = (1 - cw) / 2;
+      a0 = 1 + alpha;
+      a1 = -2 * cw;
+      a2 = 1 - alpha;
+      break;
+    case EQ_HIGH_PASS:
+      b0 = (1 + cw) / 2;
+      b1 = -(1 + cw);
+      b2 = (1 + cw) / 2;
+      a0 = 1 + alpha;
+      a1 = -2 * cw;
+      a2 = 1 - alpha;
+      break;
+    case EQ_PEAK:
+    default:
+      b0 = 1 + alpha * A;
+      b1 = -2 * cw;
+      b2 = 1 - alpha * A;
+      a0 = 1 + alpha / A;
+      a1 = -2 * cw;
+      a2 = 1 - alpha / A;
+      break;
+  }
+
+  c.b0[index] = toCoef(b0 / a0);
+  c.b1[index] = toCoef(b1 / a0);
+  c.b2[index] = toCoef(b2 / a0);
+  c.a1[index] = toCoef(a1 / a0);
+  c.a2[index] = toCoef(a2 / a0);
+  c.activeMask |= 1u << index;
+}
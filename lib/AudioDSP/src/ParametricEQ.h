@@ -0,0 +1,104 @@
+/*
+  ParametricEQ.h - cascaded biquad parametric/shelving equalizer stage
+
+  Each band is one biquad in transposed direct form II, run in fixed point:
+  Q3.28 coefficients against Q8.23 samples with 64 bit state, so low
+  frequency bands keep their precision.  Coefficients and state are laid
+  out as structure-of-arrays (one array per coefficient, one state row per
+  channel) and the block is processed band by band, so each pass keeps its
+  five coefficients and the channel's two state words in registers.
+
+  Coefficients are never computed on the audio task.  setBand() only stores
+  the band settings; update(), called from a control task (loop()), turns
+  them into coefficients for the current sample rate and publishes them in
+  a ParamStore that process() checks once per block.  The block that picks
+  up new coefficients runs through the old ones as well and cross-fades
+  from one output to the other, so a band switched on or moved across the
+  spectrum does not click.  Until coefficients for a new sample rate have
+  been published the stage passes audio through unchanged.
+*/
+
+#ifndef PARAMETRICEQ_H_
+#define PARAMETRICEQ_H_
+
+#include <Arduino.h>
+
+#include "AudioStage.h"
+#include "ParamStore.h"
+
+#define EQ_MAX_BANDS        5
+#define EQ_COEF_SHIFT       28                  // Q3.28: coefficients up to +/-8
+#define EQ_GAIN_MIN_DB      -12.0f
+#define EQ_GAIN_MAX_DB      12.0f
+#define EQ_Q_MIN            0.1f
+#define EQ_Q_MAX            10.0f
+
+enum EqBandType : uint8_t {
+  EQ_PEAK,
+  EQ_LOW_SHELF,
+  EQ_HIGH_SHELF,
+  EQ_LOW_PASS,
+  EQ_HIGH_PASS
+};
+
+struct EqBand {
+  EqBandType type;
+  bool enabled;
+  float freq;                 // Hz; centre, corner or shelf midpoint
+  float gainDb;               // ignored by the pass filters
+  float q;                    // for shelves this sets the slope (0.707 = steepest without overshoot)
+};
+
+struct EqCoeffs {
+  int32_t b0[EQ_MAX_BANDS];
+  int32_t b1[EQ_MAX_BANDS];
+  int32_t b2[EQ_MAX_BANDS];
+  int32_t a1[EQ_MAX_BANDS];
+  int32_t a2[EQ_MAX_BANDS];
+  uint32_t activeMask;        // bands that change the signal
+  uint32_t sampleRate;        // rate the coefficients were designed for
+};
+
+struct EqState {
+  int64_t s1[AUDIO_MAX_CHANNELS][EQ_MAX_BANDS];
+  int64_t s2[AUDIO_MAX_CHANNELS][EQ_MAX_BANDS];
+};
+
+class ParametricEQ : public AudioStage {
+  public:
+    ParametricEQ();
+
+    const char *name() const override { return "eq"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // control side; setBand() may be called from any task, update() from one task only
+    static const char *typeName(EqBandType type);
+    static bool typeFromName(const char *name, EqBandType &type);
+    bool setBand(uint8_t index, const EqBand &band);    // false if out of range
+    EqBand band(uint8_t index) const;
+    void setFlat();
+    bool update();                                      // true if new coefficients were published
+
+  private:
+    static void design(const EqBand &band, uint32_t sampleRate, EqCoeffs &c, uint8_t index);
+    static void filter(const EqCoeffs &c, EqState &state, int32_t *samples, uint16_t frames, uint8_t channels);
+    bool applies(const EqCoeffs &c) const { return c.activeMask && c.sampleRate == _sampleRate; }
+
+    // control side
+    EqBand _bands[EQ_MAX_BANDS];
+    bool _dirty;
+    uint32_t _designedRate;                             // rate of the last published coefficients
+    mutable portMUX_TYPE _lock;
+
+    ParamStore<EqCoeffs> _coeffs;
+
+    // audio side
+    volatile uint32_t _sampleRate;
+    bool _running;                                      // has filtered audio since reset(): changes fade
+    EqState _state;
+    int32_t _old[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];     // the block through the replaced coefficients
+};
+
+#endif
@@ -0,0 +1,98 @@
+/*
+  PcmMonitor.cpp - tap at the end of the DSP chain for listening in remotely
+*/
+
+#include <string.h>
+
+#include "PcmMonitor.h"
+
+PcmMonitor::PcmMonitor()
+  : _fill(0), _phase(0), _factor(4), _channels(2), _inputChannels(2), _sampleRate(44100), _sequence(0),
+    _decimation(4), _mono(false), _written(0), _read(0), _dropped(0) {
+  setBypass(true);
+  startFrame();
+}
+
+void PcmMonitor::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _sampleRate = sampleRate;
+  _inputChannels = channels;
+  reset();
+}
+
+void PcmMonitor::reset() {
+  startFrame();
+}
+
+void PcmMonitor::setDecimation(uint8_t factor) {
+  if (factor < 1) factor = 1;
+  if (factor > MONITOR_MAX_DECIMATION) factor = MONITOR_MAX_DECIMATION;
+  _decimation = factor;
+}
+
+void PcmMonitor::setMono(bool mono) {
+  _mono = mono;
+}
+
+// latch the settings and point at the slot after the last published frame, which the sender never holds
+void PcmMonitor::startFrame() {
+  _fill = 0;
+  _phase = 0;
+  _sum[0] = _sum[1] = 0;
+  _factor = _decimation;
+  _channels = _mono || _inputChannels == 1 ? 1 : 2;
+  _out = (int16_t *)(_slots[_written.load(std::memory_order_relaxed) % MONITOR_SLOTS] + sizeof(MonitorHeader));
+}
+
+static inline int16_t toInt16(int64_t sum, int32_t divisor) {
+  int32_t v = (int32_t)(sum / divisor);
+  v = (v + (1 << (AUDIO_SAMPLE_SHIFT - 1))) >> AUDIO_SAMPLE_SHIFT;
+  return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+}
+
+void PcmMonitor::process(AudioBlock &block) {
+  const uint8_t ch = block.channels;
+  const int32_t *s = block.samples;
+
+  for (uint16_t i = 0; i < block.frames; i++, s += ch) {
+    _sum[0] += s[0];
+    if (ch == 2) _sum[1] += s[1];
+    if (++_phase < _factor) continue;
+
+    if (_channels == 1) {
+      _out[_fill] = ch == 2 ? toInt16(_sum[0] + _sum[1], 2 * _factor) : toInt16(_sum[0], _factor);
+    } else {
+      _out[2 * _fill] = toInt16(_sum[0], _factor);
+      _out[2 * _fill + 1] = toInt16(_sum[1], _factor);
+    }
+    _sum[0] = _sum[1] = 0;
+    _phase = 0;
+
+    if (++_fill == MONITOR_FRAME_FRAMES) {
+      const uint32_t written = _written.load(std::memory_order_relaxed);
+      MonitorHeader header = { _sequence++, _sampleRate / _factor, _fill, _channels, 0 };
+      if (written - _read.load(std::memory_order_acquire) < MONITOR_SLOTS - 1) {
+        memcpy(_slots[written % MONITOR_SLOTS], &header, sizeof(header));
+        _written.store(written + 1, std::memory_order_release);
+      } else {
+        _dropped = _dropped + 1;          // the sender is behind: collect into the same slot again
+      }
+      startFrame();
+    }
+  }
+}
+
+const uint8_t *PcmMonitor::peek(size_t &bytes) {
+  const uint32_t read = _read.load(std::memory_order_relaxed);
+  if (read == _written.load(std::memory_order_acquire)) return NULL;
+  const uint8_t *frame = _slots[read % MONITOR_SLOTS];
+  MonitorHeader header;
+  memcpy(&header, frame, sizeof(header));
+  bytes = sizeof(header) + (size_t)header.frames * header.channels * sizeof(int16_t);
+  return frame;
+}
+
+void PcmMonitor::release() {
+  const uint32_t read = _read.load(std::memory_order_relaxed);
+  if (read != _written.load(std::memory_order_acquire)) _read.store(read + 1, std::memory_order_release);
+}
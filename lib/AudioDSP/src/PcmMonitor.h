@@ -0,0 +1,91 @@
+/*
+  PcmMonitor.h - tap at the end of the DSP chain for listening in remotely
+
+  As a stage it leaves the audio untouched: process() decimates the block
+  by decimation() (box average), optionally mixes it to mono, rounds it to
+  16 bit and collects MONITOR_FRAME_FRAMES output frames into one of
+  MONITOR_SLOTS frame slots.  A frame goes out as one message, already in
+  wire format: a MonitorHeader followed by interleaved little-endian int16
+  samples.
+
+  The slots form a single-producer single-consumer queue, one slot always
+  being filled.  When the sender falls MONITOR_SLOTS - 1 frames behind, the
+  tap drops the frame it just collected and counts it in droppedFrames(),
+  so the audio task never waits on the network.  Every collected frame
+  takes a sequence number, dropped or not, so a listener sees gaps.
+
+  The sender (one task) calls peek() for the oldest complete frame, copies
+  it out and calls release().  Decimation and mono changes take effect at
+  the next frame; each header says what its samples are.
+
+  Leave the stage bypassed while nobody listens; it costs nothing then.
+*/
+
+#ifndef PCMMONITOR_H_
+#define PCMMONITOR_H_
+
+#include <atomic>
+
+#include "AudioStage.h"
+
+#define MONITOR_FRAME_FRAMES    256             // per message; 23 ms at 44.1 kHz / 4
+#define MONITOR_SLOTS           4               // the sender may fall one less than this behind
+#define MONITOR_MAX_DECIMATION  8
+
+struct MonitorHeader {
+  uint32_t sequence;          // frames collected so far, dropped ones included
+  uint32_t sampleRate;        // of the samples that follow
+  uint16_t frames;
+  uint8_t channels;           // 1 or 2
+  uint8_t reserved;
+};
+
+#define MONITOR_FRAME_BYTES     (sizeof(MonitorHeader) + MONITOR_FRAME_FRAMES * AUDIO_MAX_CHANNELS * sizeof(int16_t))
+
+class PcmMonitor : public AudioStage {
+  public:
+    PcmMonitor();
+
+    const char *name() const override { return "monitor"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // control side
+    void setDecimation(uint8_t factor);                 // 1..MONITOR_MAX_DECIMATION
+    void setMono(bool mono);
+    uint8_t decimation() const { return _decimation; }
+    bool mono() const { return _mono; }
+
+    // sender side, one task only
+    const uint8_t *peek(size_t &bytes);                 // oldest complete frame, NULL if none
+    void release();                                     // done with the frame peek() returned
+    uint32_t droppedFrames() const { return _dropped; }
+    void resetStats() { _dropped = 0; }
+
+  private:
+    void startFrame();
+
+    // audio side
+    int16_t *_out;                                      // samples of the frame being collected
+    uint16_t _fill;                                     // output frames collected
+    uint8_t _phase;
+    int64_t _sum[AUDIO_MAX_CHANNELS];                   // decimator accumulators
+    uint8_t _factor;                                    // decimation of the frame being collected
+    uint8_t _channels;                                  // output channels of the frame being collected
+    uint8_t _inputChannels;
+    uint32_t _sampleRate;
+    uint32_t _sequence;
+
+    // as set
+    volatile uint8_t _decimation;
+    volatile bool _mono;
+
+    // handover: slot n % MONITOR_SLOTS holds frame n for _read <= n < _written, slot _written is being filled
+    alignas(4) uint8_t _slots[MONITOR_SLOTS][MONITOR_FRAME_BYTES];
+    std::atomic<uint32_t> _written;
+    std::atomic<uint32_t> _read;
+    volatile uint32_t _dropped;
+};
+
+#endif
@@ -0,0 +1,200 @@
+/*
+  Resampler.cpp - polyphase windowed-sinc sample rate converter
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Resampler.h"
+
+struct ResamplerPreset {
+  const char *name;
+  uint8_t taps;
+  uint16_t phases;
+  float attenuationDb;
+};
+
+static const ResamplerPreset presets[] = {
+  { "linear", 2, 0, 0.0f },
+  { "low", 16, 32, 50.0f },
+  { "medium", 32, 64, 70.0f },
+  { "high", 64, 128, 90.0f },
+};
+
+// zeroth order modified Bessel function of the first kind, for the Kaiser window
+static double besselI0(double x) {
+  double sum = 1.0, term = 1.0;
+  for (int k = 1; k < 40; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+    if (term < sum * 1e-12) break;
+  }
+  return sum;
+}
+
+Resampler::Resampler()
+  : _quality(RESAMPLER_LINEAR), _taps(2), _phases(0), _channels(2), _table(NULL), _history(NULL),
+    _historyFrames(0), _historyCapacity(0), _pos(0), _step(1ULL << 32), _inRate(44100), _outRate(44100), _ppm(0) {
+}
+
+Resampler::~Resampler() {
+  end();
+}
+
+const char *Resampler::qualityName(ResamplerQuality quality) {
+  return quality <= RESAMPLER_HIGH ? presets[quality].name : "";
+}
+
+bool Resampler::begin(ResamplerQuality quality, uint8_t channels) {
+  end();
+  if (quality > RESAMPLER_HIGH) quality = RESAMPLER_HIGH;
+  const ResamplerPreset &p = presets[quality];
+  _quality = quality;
+  _taps = p.taps;
+  _phases = p.phases;
+  _channels = channels;
+
+  _historyCapacity = _taps + AUDIO_BLOCK_FRAMES + 2;
+  _history = (int32_t *)malloc(_historyCapacity * _channels * sizeof(int32_t));
+  if (_phases) _table = (int32_t *)malloc(tableBytes());
+  if (!_history || (_phases && !_table)) {
+    end();
+    return false;
+  }
+
+  if (_phases) {
+    // Kaiser design: transition width from the tap count and attenuation, stopband edge at 0.5
+    const double A = p.attenuationDb;
+    const double beta = A > 50.0 ? 0.1102 * (A - 8.7) : 0.5842 * pow(A - 21.0, 0.4) + 0.07886 * (A - 21.0);
+    const double transition = (A - 8.0) / (2.285 * 2.0 * M_PI * _taps);
+    const double fc = 0.5 - transition / 2.0;                  // cycles per input sample
+    const double half = _taps / 2.0;
+    const double i0beta = besselI0(beta);
+    double row[RESAMPLER_MAX_TAPS];
+
+    for (int ph = 0; ph <= _phases; ph++) {
+      double sum = 0.0;
+      for (int j = 0; j < _taps; j++) {
+        double t = (j - (half - 1.0)) - (double)ph / _phases;   // distance of tap j from the output point
+        double r = t / half;
+        double w = (r * r < 1.0) ? besselI0(beta * sqrt(1.0 - r * r)) / i0beta : 0.0;
+        double x = 2.0 * fc * t;
+        double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+        row[j] = 2.0 * fc * sinc * w;
+        sum += row[j];
+      }
+      // unity gain at DC for every phase; put the rounding error on the largest tap
+      int32_t *out = _table + (size_t)ph * _taps;
+      int64_t total = 0;
+      int peak = 0;
+      for (int j = 0; j < _taps; j++) {
+        out[j] = (int32_t)llrint(row[j] / sum * RESAMPLER_COEF_ONE);
+        total += out[j];
+        if (out[j] > out[peak]) peak = j;
+      }
+      out[peak] += (int32_t)(RESAMPLER_COEF_ONE - total);
+    }
+  }
+
+  setRates(_inRate, _outRate);
+  return true;
+}
+
+void Resampler::end() {
+  free(_table);
+  free(_history);
+  _table = NULL;
+  _history = NULL;
+  _historyCapacity = 0;
+  _historyFrames = 0;
+}
+
+void Resampler::setRates(uint32_t inRate, uint32_t outRate) {
+  _inRate = inRate;
+  _outRate = outRate;
+  updateStep();
+  reset();
+}
+
+void Resampler::setRatioAdjust(int32_t ppm) {
+  _ppm = ppm;
+  updateStep();
+}
+
+void Resampler::updateStep() {
+  uint64_t step = ((uint64_t)_inRate << 32) / _outRate;
+  _step = step + (int64_t)step / 1000000 * _ppm;
+}
+
+void Resampler::reset() {
+  if (!_history) return;
+  // the first output frame lines up with the first input frame
+  const size_t lead = _taps / 2 - 1;
+  memset(_history, 0, lead * _channels * sizeof(int32_t));
+  _historyFrames = lead;
+  _pos = (uint64_t)lead << 32;
+}
+
+size_t Resampler::process(const AudioBlock &block, int32_t *out) {
+  if (!_history) return 0;
+  const uint8_t ch = _channels;
+
+  size_t frames = block.frames;
+  if (frames > _historyCapacity - _historyFrames) frames = _historyCapacity - _historyFrames;
+  memcpy(_history + _historyFrames * ch, block.samples, frames * ch * sizeof(int32_t));
+  _historyFrames += frames;
+
+  const size_t lead = _taps / 2 - 1;
+  size_t produced = 0;
+  uint64_t pos = _pos;
+
+  if (!_phases) {
+    while ((pos >> 32) + 1 < _historyFrames && produced < RESAMPLER_MAX_OUT) {
+      const int32_t *x = _history + (size_t)(pos >> 32) * ch;
+      const int32_t frac = (int32_t)((pos & 0xFFFFFFFFu) >> 1);              // Q31
+      for (uint8_t c = 0; c < ch; c++) out[c] = x[c] + (int32_t)(((int64_t)(x[ch + c] - x[c]) * frac) >> 31);
+      out += ch;
+      produced++;
+      pos += _step;
+    }
+  } else {
+    int32_t coef[RESAMPLER_MAX_TAPS];
+    const uint8_t taps = _taps;
+    while ((pos >> 32) + taps / 2 < _historyFrames && produced < RESAMPLER_MAX_OUT) {
+      // phase row and the position between it and the next row, Q16
+      const uint64_t scaled = (pos & 0xFFFFFFFFu) * _phases;
+      const int32_t *row = _table + (size_t)(scaled >> 32) * taps;
+      const int32_t mix = (int32_t)((scaled >> 16) & 0xFFFF);
+      for (uint8_t j = 0; j < taps; j++) coef[j] = row[j] + (int32_t)(((int64_t)(row[taps + j] - row[j]) * mix) >> 16);
+
+      const int32_t *x = _history + ((size_t)(pos >> 32) - lead) * ch;
+      if (ch == 2) {
+        int64_t accL = 0, accR = 0;
+        for (uint8_t j = 0; j < taps; j++) {
+          accL += (int64_t)coef[j] * x[2 * j];
+          accR += (int64_t)coef[j] * x[2 * j + 1];
+        }
+        out[0] = (int32_t)((accL + (1 << (RESAMPLER_COEF_SHIFT - 1))) >> RESAMPLER_COEF_SHIFT);
+        out[1] = (int32_t)((accR + (1 << (RESAMPLER_COEF_SHIFT - 1))) >> RESAMPLER_COEF_SHIFT);
+      } else {
+        for (uint8_t c = 0; c < ch; c++) {
+          int64_t acc = 0;
+          for (uint8_t j = 0; j < taps; j++) acc += (int64_t)coef[j] * x[j * ch + c];
+          out[c] = (int32_t)((acc + (1 << (RESAMPLER_COEF_SHIFT - 1))) >> RESAMPLER_COEF_SHIFT);
+        }
+      }
+      out += ch;
+      produced++;
+      pos += _step;
+    }
+  }
+
+  // keep what the next output frames still need
+  size_t drop = (size_t)(pos >> 32) - lead;
+  if (drop > _historyFrames) drop = _historyFrames;
+  memmove(_history, _history + drop * ch, (_historyFrames - drop) * ch * sizeof(int32_t));
+  _historyFrames -= drop;
+  _pos = pos - ((uint64_t)drop << 32);
+  return produced;
+}
@@ -0,0 +1,90 @@
+/*
+  Resampler.h - polyphase windowed-sinc sample rate converter
+
+  Converts a stream of Q8.23 blocks from the source rate to a fixed output
+  rate, so the I2S clock can stay put whatever the phone negotiates.  The
+  output position advances through the input with a 32.32 fixed-point step,
+  so any ratio works and setRatioAdjust() can trim it by parts per million
+  without a redesign.
+
+  The kernel is a Kaiser-windowed sinc stored as a Q1.30 polyphase table,
+  interpolated linearly between neighbouring phases once per output frame
+  and then applied to every channel.  It is designed once in begin() with
+  its stopband starting at the input Nyquist frequency, which serves
+  upsampling of any ratio and downsampling by up to ~10% (48 -> 44.1 kHz);
+  what folds back on the way down lands above 20 kHz.
+
+  Presets trade CPU and RAM for stopband depth and passband width (at
+  44.1 kHz in; table is the heap tableBytes() takes, (phases + 1) x taps
+  x 4 bytes; SNR as measured by bench/resampler on a 1 kHz tone):
+    RESAMPLER_LINEAR   2 taps, plain linear interpolation,     no table, ~55 dB
+    RESAMPLER_LOW     16 taps,  32 phases, flat to ~14 kHz,  2112 bytes, ~58 dB
+    RESAMPLER_MEDIUM  32 taps,  64 phases, flat to ~16 kHz,  8320 bytes, ~78 dB
+    RESAMPLER_HIGH    64 taps, 128 phases, flat to ~18 kHz, 33024 bytes, ~95 dB
+*/
+
+#ifndef RESAMPLER_H_
+#define RESAMPLER_H_
+
+#include "AudioBlock.h"
+
+#define RESAMPLER_MAX_RATIO     4               // output/input rate
+#define RESAMPLER_MAX_TAPS      64
+#define RESAMPLER_COEF_SHIFT    30              // kernel table is Q1.30
+#define RESAMPLER_COEF_ONE      (1L << RESAMPLER_COEF_SHIFT)
+#define RESAMPLER_MAX_OUT       (AUDIO_BLOCK_FRAMES * RESAMPLER_MAX_RATIO + 2)   // frames per process() call
+
+enum ResamplerQuality : uint8_t {
+  RESAMPLER_LINEAR,
+  RESAMPLER_LOW,
+  RESAMPLER_MEDIUM,
+  RESAMPLER_HIGH
+};
+
+class Resampler {
+  public:
+    Resampler();
+    ~Resampler();
+
+    // allocates the kernel table and history; call from setup, not from the audio task
+    bool begin(ResamplerQuality quality, uint8_t channels = 2);
+    void end();
+    static const char *qualityName(ResamplerQuality quality);
+
+    // audio task
+    void setRates(uint32_t inRate, uint32_t outRate);   // clears the history
+    void setRatioAdjust(int32_t ppm);                   // fine trim of the step for clock drift
+    void reset();
+    bool passthrough() const { return _inRate == _outRate && _ppm == 0; }
+
+    // converts block.frames input frames; returns the number of frames written to out
+    // (at most RESAMPLER_MAX_OUT, interleaved like the input)
+    size_t process(const AudioBlock &block, int32_t *out);
+
+    ResamplerQuality quality() const { return _quality; }
+    uint8_t taps() const { return _taps; }
+    uint16_t phases() const { return _phases; }
+    size_t tableBytes() const { return _phases ? (size_t)(_phases + 1) * _taps * sizeof(int32_t) : 0; }
+    uint32_t inRate() const { return _inRate; }
+    uint32_t outRate() const { return _outRate; }
+    uint32_t latencyFrames() const { return _taps / 2; }     // input frames of look-ahead
+
+  private:
+    void updateStep();
+
+    ResamplerQuality _quality;
+    uint8_t _taps;
+    uint16_t _phases;
+    uint8_t _channels;
+    int32_t *_table;            // (_phases + 1) rows of _taps, Q1.30
+    int32_t *_history;          // interleaved input frames not yet fully used
+    size_t _historyFrames;      // frames currently held
+    size_t _historyCapacity;
+    uint64_t _pos;              // 32.32 position of the next output frame in _history
+    uint64_t _step;             // 32.32 input frames per output frame
+    uint32_t _inRate;
+    uint32_t _outRate;
+    int32_t _ppm;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+  SilenceDetector.cpp - tells when the output can be shut down
+*/
+
+#include <math.h>
+
+#include "SilenceDetector.h"
+
+SilenceDetector::SilenceDetector() : _hangoverMs(SILENCE_HANGOVER_MS), _lastSound(0) {
+  setThreshold(SILENCE_PEAK_DB, SILENCE_RMS_DB);
+}
+
+void SilenceDetector::setThreshold(float peakDb, float rmsDb) {
+  if (peakDb > 0.0f) peakDb = 0.0f;
+  if (rmsDb > peakDb) rmsDb = peakDb;
+  _peakDb = peakDb;
+  _rmsDb = rmsDb;
+  _peakLimit = (int32_t)(AUDIO_FULL_SCALE * powf(10.0f, peakDb / 20.0f));
+  const float rms = 32768.0f * powf(10.0f, rmsDb / 20.0f);
+  _energyLimit = (uint32_t)lrintf(rms * rms * 256.0f);
+}
+
+void SilenceDetector::setHangover(uint32_t ms) {
+  _hangoverMs = ms;
+}
+
+bool SilenceDetector::process(const AudioBlock &block, uint32_t nowMs) {
+  const int32_t limit = _peakLimit;
+  const size_t count = (size_t)block.frames * block.channels;
+  const int32_t *s = block.samples;
+  uint64_t energy = 0;
+  bool silent = true;
+  for (size_t i = 0; i < count; i++) {
+    const int32_t v = s[i];
+    if (v > limit || v < -limit) {
+      silent = false;
+      break;
+    }
+    const int32_t x = v >> AUDIO_SAMPLE_SHIFT;
+    energy += (uint64_t)((int64_t)x * x);
+  }
+  if (silent && count && (energy << 8) > (uint64_t)_energyLimit * count) silent = false;
+  if (!silent) _lastSound = nowMs;
+  return silent;
+}
+
+void SilenceDetector::restart(uint32_t nowMs) {
+  _lastSound = nowMs;
+}
+
+bool SilenceDetector::idle(uint32_t nowMs) const {
+  const uint32_t hangover = _hangoverMs;
+  return hangover && nowMs - _lastSound >= hangover;
+}
@@ -0,0 +1,53 @@
+/*
+  SilenceDetector.h - tells when the output can be shut down
+
+  Phones keep an A2DP stream open while paused, and many send digital
+  silence all the while, so the I2S DMA and the CPU would run flat out to
+  play zeros.  process() classifies each block as silent when both its
+  peak and its RMS are at or below the thresholds (dBFS).  The RMS check
+  lets a little dither or decoder noise count as silence without raising
+  the peak threshold into quiet music.
+
+  idle() turns true once nothing audible has gone by for the hangover.
+  That is counted in milliseconds rather than blocks, so time spent waiting
+  for a stream counts too.  The consumer shuts its output down then and
+  keeps classifying; the first block that is not silent ends the idle
+  period at once.  A hangover of 0 never idles.
+
+  Thresholds and hangover may be set from any task.
+*/
+
+#ifndef SILENCEDETECTOR_H_
+#define SILENCEDETECTOR_H_
+
+#include "AudioBlock.h"
+
+#define SILENCE_PEAK_DB         -80.0f          // 3 LSB at 16 bit
+#define SILENCE_RMS_DB          -90.0f
+#define SILENCE_HANGOVER_MS     3000
+
+class SilenceDetector {
+  public:
+    SilenceDetector();
+
+    void setThreshold(float peakDb, float rmsDb);
+    void setHangover(uint32_t ms);              // 0 = never idle
+    float peakThreshold() const { return _peakDb; }
+    float rmsThreshold() const { return _rmsDb; }
+    uint32_t hangover() const { return _hangoverMs; }
+
+    // consumer
+    bool process(const AudioBlock &block, uint32_t nowMs);     // true if the block is silent
+    void restart(uint32_t nowMs);               // start the hangover again from now
+    bool idle(uint32_t nowMs) const;            // silent for the whole hangover
+
+  private:
+    volatile int32_t _peakLimit;                // Q8.23 magnitude
+    volatile uint32_t _energyLimit;             // mean square at 16 bit scale, Q8
+    volatile uint32_t _hangoverMs;
+    float _peakDb;
+    float _rmsDb;
+    uint32_t _lastSound;                        // ms
+};
+
+#endif
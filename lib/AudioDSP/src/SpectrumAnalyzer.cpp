@@ -0,0 +1,148 @@
+/*
+  SpectrumAnalyzer.cpp - tap on the DSP chain feeding a log-spaced bar display
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "SpectrumAnalyzer.h"
+
+#define SPECTRUM_HALF   (SPECTRUM_FFT_SIZE / 2)
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+  : _writing(0), _fill(0), _sum(0), _phase(0), _rate(44100 / SPECTRUM_DECIMATION), _ready(false), _designedRate(0),
+    _analyzed(0) {
+  _frameRate[0] = _frameRate[1] = _rate;
+  memset((void *)_levels, 0, sizeof(_levels));
+
+  // periodic Hann window and the twiddles shared by the half-size FFT and the split pass
+  for (int i = 0; i < SPECTRUM_FFT_SIZE; i++) _window[i] = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / SPECTRUM_FFT_SIZE);
+  for (int k = 0; k < SPECTRUM_HALF; k++) {
+    _cos[k] = cosf(2.0f * (float)M_PI * k / SPECTRUM_FFT_SIZE);
+    _sin[k] = -sinf(2.0f * (float)M_PI * k / SPECTRUM_FFT_SIZE);
+  }
+  // a full-scale sine peaks at A * N / 4 through the Hann window
+  const float peak = 32768.0f * SPECTRUM_FFT_SIZE / 4.0f;
+  _fullScale = peak * peak;
+  setBypass(true);
+}
+
+void SpectrumAnalyzer::begin(uint32_t sampleRate, uint8_t channels) {
+  AudioStage::begin(sampleRate, channels);
+  _rate = sampleRate / SPECTRUM_DECIMATION;
+  reset();
+}
+
+void SpectrumAnalyzer::reset() {
+  _fill = 0;
+  _sum = 0;
+  _phase = 0;
+}
+
+void SpectrumAnalyzer::process(AudioBlock &block) {
+  const uint8_t ch = block.channels;
+  const int32_t *s = block.samples;
+  int16_t *frame = _frame[_writing];
+
+  for (uint16_t i = 0; i < block.frames; i++, s += ch) {
+    _sum += ch == 2 ? (s[0] >> 1) + (s[1] >> 1) : s[0];
+    if (++_phase < SPECTRUM_DECIMATION) continue;
+
+    int64_t v = (_sum / SPECTRUM_DECIMATION) >> AUDIO_SAMPLE_SHIFT;
+    if (v > INT16_MAX) v = INT16_MAX;
+    else if (v < INT16_MIN) v = INT16_MIN;
+    frame[_fill++] = (int16_t)v;
+    _sum = 0;
+    _phase = 0;
+
+    if (_fill == SPECTRUM_FFT_SIZE) {
+      _fill = 0;
+      if (!_ready.load(std::memory_order_acquire)) {
+        // hand the frame over and fill the other buffer; if analysis is still busy collect this one again
+        _frameRate[_writing] = _rate;
+        _writing ^= 1;
+        frame = _frame[_writing];
+        _ready.store(true, std::memory_order_release);
+      }
+    }
+  }
+}
+
+void SpectrumAnalyzer::design(uint32_t rate) {
+  const float binHz = (float)rate / SPECTRUM_FFT_SIZE;
+  const float ratio = (rate / 2.0f) / SPECTRUM_MIN_HZ;
+  uint16_t last = 0;
+  for (int i = 0; i <= SPECTRUM_BARS; i++) {
+    float f = SPECTRUM_MIN_HZ * powf(ratio, (float)i / SPECTRUM_BARS);
+    uint16_t bin = (uint16_t)lrintf(f / binHz);
+    if (bin <= last) bin = last + 1;                      // every bar gets at least one bin
+    if (bin > SPECTRUM_HALF) bin = SPECTRUM_HALF;
+    _barBin[i] = last = bin;
+  }
+  _designedRate = rate;
+}
+
+// in-place radix-2 complex FFT of SPECTRUM_HALF points
+void SpectrumAnalyzer::fft(float *re, float *im) {
+  for (int i = 1, j = 0; i < SPECTRUM_HALF; i++) {
+    int bit = SPECTRUM_HALF >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j |= bit;
+    if (i < j) {
+      float t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+  for (int len = 2; len <= SPECTRUM_HALF; len <<= 1) {
+    const int stride = SPECTRUM_FFT_SIZE / len;             // twiddle step in the N point table
+    for (int start = 0; start < SPECTRUM_HALF; start += len) {
+      for (int k = 0; k < len / 2; k++) {
+        const float wr = _cos[k * stride], wi = _sin[k * stride];
+        const int a = start + k, b = a + len / 2;
+        const float tr = re[b] * wr - im[b] * wi;
+        const float ti = re[b] * wi + im[b] * wr;
+        re[b] = re[a] - tr;
+        im[b] = im[a] - ti;
+        re[a] += tr;
+        im[a] += ti;
+      }
+    }
+  }
+}
+
+bool SpectrumAnalyzer::analyze() {
+  if (!_ready.load(std::memory_order_acquire)) return false;
+  const uint8_t buffer = _writing ^ 1;                      // not touched by process() until _ready is cleared
+  const int16_t *x = _frame[buffer];
+  if (_frameRate[buffer] != _designedRate) design(_frameRate[buffer]);
+
+  // pack the even/odd samples as one complex sequence of half the length
+  for (int n = 0; n < SPECTRUM_HALF; n++) {
+    _re[n] = x[2 * n] * _window[2 * n];
+    _im[n] = x[2 * n + 1] * _window[2 * n + 1];
+  }
+  _ready.store(false, std::memory_order_release);           // the samples are copied out
+  fft(_re, _im);
+
+  // split into the real signal's spectrum and sum the power of each bar
+  float power[SPECTRUM_BARS];
+  memset(power, 0, sizeof(power));
+  int bar = 0;
+  for (int k = 1; k < SPECTRUM_HALF && bar < SPECTRUM_BARS; k++) {
+    const int m = SPECTRUM_HALF - k;
+    const float er = 0.5f * (_re[k] + _re[m]), ei = 0.5f * (_im[k] - _im[m]);
+    const float or_ = 0.5f * (_im[k] + _im[m]), oi = -0.5f * (_re[k] - _re[m]);
+    const float xr = er + or_ * _cos[k] - oi * _sin[k];
+    const float xi = ei + or_ * _sin[k] + oi * _cos[k];
+    while (bar < SPECTRUM_BARS && k >= _barBin[bar + 1]) bar++;
+    if (bar < SPECTRUM_BARS && k >= _barBin[bar]) power[bar] += xr * xr + xi * xi;
+  }
+
+  for (int i = 0; i < SPECTRUM_BARS; i++) {
+    float db = power[i] > 0.0f ? 10.0f * log10f(power[i] / _fullScale) : -SPECTRUM_RANGE_DB;
+    float level = (db + SPECTRUM_RANGE_DB) * (255.0f / SPECTRUM_RANGE_DB);
+    _levels[i] = level <= 0.0f ? 0 : level >= 255.0f ? 255 : (uint8_t)level;
+  }
+  _analyzed = _analyzed + 1;
+  return true;
+}
@@ -0,0 +1,82 @@
+/*
+  SpectrumAnalyzer.h - tap on the DSP chain feeding a log-spaced bar display
+
+  As a stage it leaves the audio untouched: process() mixes the block to
+  mono, decimates it by SPECTRUM_DECIMATION (box average) and collects
+  SPECTRUM_FFT_SIZE samples into one of two frame buffers.  A full frame is
+  handed over only if the analysis side has finished the previous one,
+  otherwise it is dropped and collection starts again, so the audio task
+  never waits for the FFT.
+
+  analyze() runs on a task of its own, normally on the other core: Hann
+  window, real FFT (a half-size complex FFT plus a split pass, in float),
+  then the power is summed into SPECTRUM_BARS log-spaced bands between
+  SPECTRUM_MIN_HZ and the decimated Nyquist frequency.  Bar levels are
+  0..255 for -SPECTRUM_RANGE_DB..0 dB relative to a full-scale sine, and are
+  read with levels() by the display code at whatever rate it can draw.
+
+  Leave the stage bypassed while nothing is displayed; it costs nothing
+  then.
+*/
+
+#ifndef SPECTRUMANALYZER_H_
+#define SPECTRUMANALYZER_H_
+
+#include <atomic>
+
+#include "AudioStage.h"
+
+#define SPECTRUM_FFT_SIZE       512             // at 22.05 kHz: 43 Hz bins, a frame every 23 ms
+#define SPECTRUM_DECIMATION     2
+#define SPECTRUM_BARS           32
+#define SPECTRUM_MIN_HZ         40.0f
+#define SPECTRUM_RANGE_DB       60.0f
+
+class SpectrumAnalyzer : public AudioStage {
+  public:
+    SpectrumAnalyzer();
+
+    const char *name() const override { return "spectrum"; }
+    void begin(uint32_t sampleRate, uint8_t channels) override;
+    void reset() override;
+    void process(AudioBlock &block) override;
+
+    // analysis side, one task only
+    bool frameReady() const { return _ready.load(std::memory_order_acquire); }
+    bool analyze();                                     // true if the levels were updated
+
+    // display side
+    const volatile uint8_t *levels() const { return _levels; }
+    uint32_t frames() const { return _analyzed; }       // frames analyzed so far
+
+  private:
+    void design(uint32_t rate);
+    void fft(float *re, float *im);
+
+    // audio side
+    int16_t _frame[2][SPECTRUM_FFT_SIZE];
+    uint8_t _writing;                                   // buffer being filled
+    uint16_t _fill;
+    int64_t _sum;                                       // decimator accumulator
+    uint8_t _phase;
+    volatile uint32_t _rate;                            // decimated rate
+    uint32_t _frameRate[2];                             // rate each buffer was collected at
+
+    // handover: set with a full frame in _frame[_writing ^ 1], cleared once analyze() has copied it out
+    std::atomic<bool> _ready;
+
+    // analysis side
+    float _window[SPECTRUM_FFT_SIZE];
+    float _cos[SPECTRUM_FFT_SIZE / 2];
+    float _sin[SPECTRUM_FFT_SIZE / 2];
+    float _re[SPECTRUM_FFT_SIZE / 2];
+    float _im[SPECTRUM_FFT_SIZE / 2];
+    uint16_t _barBin[SPECTRUM_BARS + 1];                // first bin of each bar, plus the end
+    uint32_t _designedRate;
+    float _fullScale;                                   // power of a full-scale sine's bin
+
+    volatile uint8_t _levels[SPECTRUM_BARS];
+    volatile uint32_t _analyzed;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Generates lib/AudioDSP/src/LoudnessTable.h.
+
+One pair of shelving biquads (RBJ cookbook, Q3.28) per a2dp volume step and
+supported sample rate, so the device never designs a filter: a volume change
+is a table lookup.  The volume law must match audioPathSetVolume(): 0 mutes,
+1..127 are equal dB steps from -RANGE_DB to 0 dB.
+
+The boost follows the gap between the equal-loudness contours at the
+listening level and at full volume, coarsely: the ear loses bass much faster
+than treble as the level drops.
+
+    python3 lib/AudioDSP/tools/loudness_table.py > lib/AudioDSP/src/LoudnessTable.h
+"""
+
+import math
+
+RANGE_DB = 60.0
+RATES = (44100, 48000)
+BASS_HZ, BASS_DB_PER_DB, BASS_MAX_DB = 120.0, 0.35, 15.0
+TREBLE_HZ, TREBLE_DB_PER_DB, TREBLE_MAX_DB = 8000.0, 0.1, 5.0
+SHELF_Q = 0.707
+COEF_SHIFT = 28
+
+
+def attenuation(volume):
+    return 0.0 if volume == 0 else RANGE_DB * (127 - volume) / 126.0
+
+
+def shelf(low, freq, gain_db, rate):
+    a = 10.0 ** (gain_db / 40.0)
+    w0 = 2.0 * math.pi * freq / rate
+    cw = math.cos(w0)
+    alpha = math.sin(w0) / (2.0 * SHELF_Q)
+    s = 2.0 * math.sqrt(a) * alpha
+    sign = -1.0 if low else 1.0
+    b0 = a * ((a + 1) + sign * (a - 1) * cw + s)
+    b1 = -sign * 2 * a * ((a - 1) + sign * (a + 1) * cw)
+    b2 = a * ((a + 1) + sign * (a - 1) * cw - s)
+    a0 = (a + 1) - sign * (a - 1) * cw + s
+    a1 = sign * 2 * ((a - 1) - sign * (a + 1) * cw)
+    a2 = (a + 1) - sign * (a - 1) * cw - s
+    return [round(v / a0 * (1 << COEF_SHIFT)) for v in (b0, b1, b2, a1, a2)]
+
+
+def main():
+    print("/*")
+    print("  LoudnessTable.h - generated by lib/AudioDSP/tools/loudness_table.py, do not edit")
+    print("")
+    print("  Per sample rate and a2dp volume step: low shelf %g Hz, high shelf %g Hz," % (BASS_HZ, TREBLE_HZ))
+    print("  Q3.28 b0 b1 b2 a1 a2.  Volume law: 0 mutes, 1..127 span -%g..0 dB." % RANGE_DB)
+    print("*/")
+    print("")
+    print("#ifndef LOUDNESSTABLE_H_")
+    print("#define LOUDNESSTABLE_H_")
+    print("")
+    print("#define LOUDNESS_VOLUME_RANGE_DB %d" % RANGE_DB)
+    print("#define LOUDNESS_RATE_COUNT      %d" % len(RATES))
+    print("")
+    print("static const uint32_t loudnessRates[LOUDNESS_RATE_COUNT] = { %s };" % ", ".join(str(r) for r in RATES))
+    print("")
+    print("static const LoudnessCoeffs loudnessTable[LOUDNESS_RATE_COUNT][LOUDNESS_STEPS] = {")
+    for rate in RATES:
+        print("  {")
+        for volume in range(128):
+            att = attenuation(volume)
+            bass = min(att * BASS_DB_PER_DB, BASS_MAX_DB)
+            treble = min(att * TREBLE_DB_PER_DB, TREBLE_MAX_DB)
+            low = shelf(True, BASS_HZ, bass, rate)
+            high = shelf(False, TREBLE_HZ, treble, rate)
+            level = "mute" if volume == 0 else "%5.1f dB" % -att
+            print("    { { %s }, { %s } },    // %3d: %s, bass %+5.1f, treble %+4.1f"
+                  % (", ".join(str(v) for v in low), ", ".join(str(v) for v in high), volume, level, bass, treble))
+        print("  },")
+    print("};")
+    print("")
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
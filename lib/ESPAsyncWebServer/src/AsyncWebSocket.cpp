@@ -986,6 +986,22 @@ void AsyncWebSocket::binaryAll(AsyncWebSocketMessageBuffer * buffer)
   _cleanBuffers(); 
 }
 
+size_t AsyncWebSocket::binaryAll(AsyncWebSocketMessageBuffer * buffer, size_t maxQueued)
+{
+  if (!buffer) return 0;
+  size_t queued = 0;
+  buffer->lock();
+  for(const auto& c: _clients){
+    if(c->status() == WS_CONNECTED && c->queueLength() < maxQueued){
+      c->binary(buffer);
+      queued++;
+    }
+  }
+  buffer->unlock();
+  _cleanBuffers();
+  return queued;
+}
+
 void AsyncWebSocket::message(uint32_t id, AsyncWebSocketMessage *message){
   AsyncWebSocketClient * c = client(id);
   if(c)
@@ -1221,11 +1237,8 @@ void AsyncWebSocket::_cleanBuffers()
 {
   AsyncWebLockGuard l(_lock);
 
-  for(AsyncWebSocketMessageBuffer * c: _buffers){
-    if(c && c->canDelete()){
-        _buffers.remove(c);
-    }
-  }
+  // remove() frees the list node, so don't keep iterating over it
+  while(_buffers.remove_first([](AsyncWebSocketMessageBuffer * c){ return c && c->canDelete(); }));
 }
 
 AsyncWebSocket::AsyncWebSocketClientLinkedList AsyncWebSocket::getClients() const {
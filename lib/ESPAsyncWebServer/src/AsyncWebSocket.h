@@ -227,6 +227,7 @@ class AsyncWebSocketClient {
     void binary(AsyncWebSocketMessageBuffer *buffer); 
 
     bool canSend() { return _messageQueue.length() < WS_MAX_QUEUED_MESSAGES; }
+    size_t queueLength() { return _messageQueue.length(); }
 
     //system callbacks (do not call)
     void _onAck(size_t len, uint32_t time);
@@ -300,6 +301,7 @@ class AsyncWebSocket: public AsyncWebHandler {
     void binaryAll(const String &message);
     void binaryAll(const __FlashStringHelper *message, size_t len);
     void binaryAll(AsyncWebSocketMessageBuffer * buffer); 
+    size_t binaryAll(AsyncWebSocketMessageBuffer * buffer, size_t maxQueued); // skips clients with maxQueued messages waiting; returns clients queued to
 
     void message(uint32_t id, AsyncWebSocketMessage *message);
     void messageAll(AsyncWebSocketMultiMessage *message);
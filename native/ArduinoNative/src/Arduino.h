@@ -0,0 +1,156 @@
+/*
+  Arduino.h - host (Linux) stand-in for the Arduino-ESP32 core
+
+  Only the parts of the core that esp-Music and its libraries actually use are
+  provided.  Time comes from the host monotonic clock, gpio pins are simulated
+  in memory (see nativeSetPin()) and Serial writes to stdout.
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "pgmspace.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "esp32-hal-log.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT             0x01
+#define OUTPUT            0x03
+#define PULLUP            0x04
+#define INPUT_PULLUP      0x05
+#define PULLDOWN          0x08
+#define INPUT_PULLDOWN    0x09
+
+#define RISING    0x01
+#define FALLING   0x02
+#define CHANGE    0x03
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PI          3.1415926535897932384626433832795
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+
+#define NATIVE_GPIO_COUNT 40
+
+#define digitalPinToInterrupt(p)  (((p) < NATIVE_GPIO_COUNT) ? (p) : -1)
+#define NOT_AN_INTERRUPT          -1
+
+// fast-pin access used by the SPI display drivers; writes land in a dummy register
+extern volatile uint32_t nativeGpioRegs[2];
+#define digitalPinToPort(pin)     (((pin) > 31) ? 1 : 0)
+#define digitalPinToBitMask(pin)  (1UL << (((pin) > 31) ? ((pin) - 32) : (pin)))
+#define portOutputRegister(port)  (&nativeGpioRegs[port])
+#define portInputRegister(port)   (&nativeGpioRegs[port])
+#define portModeRegister(port)    (&nativeGpioRegs[port])
+
+#define _min(a,b) ((a)<(b)?(a):(b))
+#define _max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+#define _BV(b) (1UL << (b))
+
+#define interrupts()
+#define noInterrupts()
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define ICACHE_RAM_ATTR
+
+typedef void (*voidFuncPtr)(void);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, voidFuncPtr handler, int mode);
+void detachInterrupt(uint8_t pin);
+
+void ets_printf(const char *fmt, ...);
+bool psramFound(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+// host-only: drive a simulated input pin, firing any attached interrupt
+void nativeSetPin(uint8_t pin, uint8_t val);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+uint16_t makeWord(uint16_t w);
+uint16_t makeWord(uint8_t h, uint8_t l);
+
+using std::abs;
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+// size_t is 32 bits on the board, so min(size_t, unsigned) is unambiguous
+// there; these keep the same mixed-type calls compiling on a 64-bit host
+template<class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template<class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+using ::round;
+
+#include "WString.h"
+#include "Stream.h"
+#include "Printable.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+void setup(void);
+void loop(void);
+
+#endif // Arduino_h
@@ -0,0 +1,33 @@
+/*
+  AsyncElegantOTA.h - host stand-in for ayushsharma82/AsyncElegantOTA
+
+  There is no flash to update on the host; /update answers 501 so the route
+  is still visible to anything probing the web UI.
+*/
+
+#ifndef AsyncElegantOTA_h
+#define AsyncElegantOTA_h
+
+#include "Arduino.h"
+#include "ESPAsyncWebServer.h"
+
+class AsyncElegantOtaClass {
+  public:
+    void begin(AsyncWebServer *server, const char *username = "", const char *password = "") {
+      (void)username;
+      (void)password;
+      _server = server;
+      _server->on("/update", HTTP_ANY, [](AsyncWebServerRequest *request) {
+        request->send(501, "text/plain", "OTA is not available in the native build");
+      });
+    }
+    void loop() {}
+    void restart() { ESP.restart(); }
+
+  private:
+    AsyncWebServer *_server = nullptr;
+};
+
+inline AsyncElegantOtaClass AsyncElegantOTA;
+
+#endif
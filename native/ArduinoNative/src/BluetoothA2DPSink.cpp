@@ -0,0 +1,132 @@
+/*
+  BluetoothA2DPSink.cpp - host stand-in for pschatzmann/ESP32-A2DP's sink
+*/
+
+#include "BluetoothA2DPSink.h"
+
+BluetoothA2DPSink::BluetoothA2DPSink()
+  : bt_name(""), i2s_port(I2S_NUM_0), is_i2s_output(true), is_started(false), volume_value(0),
+    avrc_metadata_flags(ESP_AVRC_MD_ATTR_TITLE | ESP_AVRC_MD_ATTR_ARTIST | ESP_AVRC_MD_ATTR_ALBUM | ESP_AVRC_MD_ATTR_PLAYING_TIME),
+    connection_state(ESP_A2D_CONNECTION_STATE_DISCONNECTED), audio_state(ESP_A2D_AUDIO_STATE_STOPPED),
+    stream_reader(NULL), data_received(NULL), volume_change_callback(NULL), sample_rate_callback(NULL), avrc_metadata_callback(NULL),
+    avrc_rn_playstatus_callback(NULL), avrc_rn_play_pos_callback(NULL), avrc_rn_play_pos_interval(10),
+    connection_state_callback(NULL), connection_state_obj(NULL), audio_state_callback(NULL), audio_state_obj(NULL) {
+  pin_config = { I2S_PIN_NO_CHANGE, 26, 25, 22, I2S_PIN_NO_CHANGE };
+  // same defaults as the library
+  i2s_config.mode = I2S_MODE_MASTER | I2S_MODE_TX;
+  i2s_config.sample_rate = 44100;
+  i2s_config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  i2s_config.channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT;
+  i2s_config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  i2s_config.intr_alloc_flags = 0;
+  i2s_config.dma_buf_count = 8;
+  i2s_config.dma_buf_len = 64;
+  i2s_config.use_apll = false;
+  i2s_config.tx_desc_auto_clear = true;
+  i2s_config.fixed_mclk = 0;
+}
+
+void BluetoothA2DPSink::start(const char *name, bool auto_reconect) {
+  (void)auto_reconect;
+  bt_name = name;
+  if (is_i2s_output) {
+    i2s_driver_install(i2s_port, &i2s_config, 0, NULL);
+    i2s_set_pin(i2s_port, &pin_config);
+  }
+  is_started = true;
+}
+
+void BluetoothA2DPSink::end(bool release_memory) {
+  (void)release_memory;
+  native_disconnect();
+  if (is_i2s_output) i2s_driver_uninstall(i2s_port);
+  is_started = false;
+}
+
+void BluetoothA2DPSink::set_volume(uint8_t volume) {
+  // the library's AVRCP absolute volume range is 0..127
+  volume_value = volume > 127 ? 127 : volume;
+}
+
+void BluetoothA2DPSink::play() {
+  if (is_connected()) set_audio_state(ESP_A2D_AUDIO_STATE_STARTED);
+}
+
+void BluetoothA2DPSink::pause() {
+  if (is_connected()) set_audio_state(ESP_A2D_AUDIO_STATE_REMOTE_SUSPEND);
+}
+
+void BluetoothA2DPSink::stop() {
+  if (is_connected()) set_audio_state(ESP_A2D_AUDIO_STATE_STOPPED);
+}
+
+void BluetoothA2DPSink::set_stream_reader(void (*callBack)(const uint8_t *, uint32_t), bool i2s_output) {
+  stream_reader = callBack;
+  is_i2s_output = i2s_output;
+}
+
+void BluetoothA2DPSink::set_connection_state(esp_a2d_connection_state_t state) {
+  connection_state = state;
+  if (connection_state_callback) connection_state_callback(state, connection_state_obj);
+}
+
+void BluetoothA2DPSink::set_audio_state(esp_a2d_audio_state_t state) {
+  audio_state = state;
+  if (audio_state_callback) audio_state_callback(state, audio_state_obj);
+}
+
+void BluetoothA2DPSink::native_connect(uint16_t rate) {
+  set_connection_state(ESP_A2D_CONNECTION_STATE_CONNECTED);
+  native_set_sample_rate(rate);
+  set_audio_state(ESP_A2D_AUDIO_STATE_STARTED);
+}
+
+void BluetoothA2DPSink::native_disconnect() {
+  if (connection_state == ESP_A2D_CONNECTION_STATE_DISCONNECTED) return;
+  set_audio_state(ESP_A2D_AUDIO_STATE_STOPPED);
+  set_connection_state(ESP_A2D_CONNECTION_STATE_DISCONNECTED);
+}
+
+void BluetoothA2DPSink::native_set_sample_rate(uint16_t rate) {
+  i2s_config.sample_rate = rate;
+  if (is_i2s_output && is_started) i2s_set_clk(i2s_port, rate, i2s_config.bits_per_sample, I2S_CHANNEL_STEREO);
+  if (sample_rate_callback) sample_rate_callback(rate);
+}
+
+void BluetoothA2DPSink::native_set_metadata(uint8_t attr, const char *text) {
+  if (avrc_metadata_callback && (avrc_metadata_flags & attr)) avrc_metadata_callback(attr, (const uint8_t *)text);
+}
+
+void BluetoothA2DPSink::native_set_playstatus(esp_avrc_playback_stat_t playback) {
+  if (avrc_rn_playstatus_callback) avrc_rn_playstatus_callback(playback);
+}
+
+void BluetoothA2DPSink::native_set_play_pos(uint32_t play_pos) {
+  if (avrc_rn_play_pos_callback) avrc_rn_play_pos_callback(play_pos);
+}
+
+// the library calls the volume change callback for changes the phone makes, not for set_volume()
+void BluetoothA2DPSink::native_set_remote_volume(uint8_t volume) {
+  volume_value = volume > 127 ? 127 : volume;
+  if (volume_change_callback) volume_change_callback(volume_value);
+}
+
+void BluetoothA2DPSink::native_write_data(const uint8_t *data, uint32_t len) {
+  if (audio_state != ESP_A2D_AUDIO_STATE_STARTED) return;
+  if (stream_reader) stream_reader(data, len);
+  if (is_i2s_output) {
+    // the library scales 16 bit stereo samples by volume/127 before I2S
+    static int16_t scaled[1024];
+    const int16_t *in = (const int16_t *)data;
+    uint32_t samples = len / 2;
+    while (samples) {
+      uint32_t n = samples > 1024 ? 1024 : samples;
+      for (uint32_t i = 0; i < n; i++) scaled[i] = (int16_t)((int32_t)in[i] * volume_value / 127);
+      size_t written;
+      i2s_write(i2s_port, scaled, n * 2, &written, portMAX_DELAY);
+      in += n;
+      samples -= n;
+    }
+  }
+  if (data_received) data_received();
+}
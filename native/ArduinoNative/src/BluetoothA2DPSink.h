@@ -0,0 +1,135 @@
+/*
+  BluetoothA2DPSink.h - host stand-in for pschatzmann/ESP32-A2DP's sink
+
+  Same public calls as the library, minus the Bluetooth stack.  A harness
+  plays the part of the phone through the native_* methods: it "connects",
+  announces the sample rate and pushes PCM exactly as the A2DP data callback
+  would, so everything downstream (stream reader, volume, I2S) runs unchanged.
+*/
+
+#ifndef BLUETOOTHA2DPSINK_H_
+#define BLUETOOTHA2DPSINK_H_
+
+#include "Arduino.h"
+#include "driver/i2s.h"
+
+typedef enum {
+    ESP_A2D_CONNECTION_STATE_DISCONNECTED = 0,
+    ESP_A2D_CONNECTION_STATE_CONNECTING,
+    ESP_A2D_CONNECTION_STATE_CONNECTED,
+    ESP_A2D_CONNECTION_STATE_DISCONNECTING
+} esp_a2d_connection_state_t;
+
+typedef enum {
+    ESP_A2D_AUDIO_STATE_REMOTE_SUSPEND = 0,
+    ESP_A2D_AUDIO_STATE_STOPPED,
+    ESP_A2D_AUDIO_STATE_STARTED,
+} esp_a2d_audio_state_t;
+
+typedef enum {
+    ESP_AVRC_MD_ATTR_TITLE = 0x1,
+    ESP_AVRC_MD_ATTR_ARTIST = 0x2,
+    ESP_AVRC_MD_ATTR_ALBUM = 0x4,
+    ESP_AVRC_MD_ATTR_TRACK_NUM = 0x8,
+    ESP_AVRC_MD_ATTR_NUM_TRACKS = 0x10,
+    ESP_AVRC_MD_ATTR_GENRE = 0x20,
+    ESP_AVRC_MD_ATTR_PLAYING_TIME = 0x40
+} esp_avrc_md_attr_mask_t;
+
+typedef enum {
+    ESP_AVRC_PLAYBACK_STOPPED = 0,
+    ESP_AVRC_PLAYBACK_PLAYING = 1,
+    ESP_AVRC_PLAYBACK_PAUSED = 2,
+    ESP_AVRC_PLAYBACK_FWD_SEEK = 3,
+    ESP_AVRC_PLAYBACK_REV_SEEK = 4,
+    ESP_AVRC_PLAYBACK_ERROR = 0xFF,
+} esp_avrc_playback_stat_t;
+
+class BluetoothA2DPSink {
+  public:
+    BluetoothA2DPSink();
+    virtual ~BluetoothA2DPSink() {}
+
+    virtual void set_pin_config(i2s_pin_config_t pin_config) { this->pin_config = pin_config; }
+    virtual void set_i2s_port(i2s_port_t i2s_num) { this->i2s_port = i2s_num; }
+    virtual void set_i2s_config(i2s_config_t i2s_config) { this->i2s_config = i2s_config; }
+    virtual void set_bits_per_sample(int bps) { i2s_config.bits_per_sample = (i2s_bits_per_sample_t)bps; }
+
+    virtual void start(const char *name, bool auto_reconect);
+    virtual void start(const char *name) { start(name, true); }
+    virtual void end(bool release_memory = false);
+
+    virtual bool is_connected() { return connection_state == ESP_A2D_CONNECTION_STATE_CONNECTED; }
+    virtual esp_a2d_connection_state_t get_connection_state() { return connection_state; }
+    virtual esp_a2d_audio_state_t get_audio_state() { return audio_state; }
+    virtual uint16_t sample_rate() { return (uint16_t)i2s_config.sample_rate; }
+
+    virtual void set_volume(uint8_t volume);
+    virtual int get_volume() { return volume_value; }
+
+    virtual void play();
+    virtual void pause();
+    virtual void stop();
+    virtual void next() {}
+    virtual void previous() {}
+
+    virtual void set_stream_reader(void (*callBack)(const uint8_t *, uint32_t), bool i2s_output = true);
+    virtual void set_on_data_received(void (*callBack)()) { data_received = callBack; }
+    virtual void set_on_volumechange(void (*callBack)(int)) { volume_change_callback = callBack; }
+    virtual void set_sample_rate_callback(void (*callback)(uint16_t rate)) { sample_rate_callback = callback; }
+    virtual void set_avrc_metadata_callback(void (*callback)(uint8_t, const uint8_t *)) { avrc_metadata_callback = callback; }
+    virtual void set_avrc_metadata_attribute_mask(int flags) { avrc_metadata_flags = flags; }
+    virtual void set_avrc_rn_playstatus_callback(void (*callback)(esp_avrc_playback_stat_t playback)) { avrc_rn_playstatus_callback = callback; }
+    virtual void set_avrc_rn_play_pos_callback(void (*callback)(uint32_t play_pos), uint16_t notif_interval = 10) {
+      avrc_rn_play_pos_callback = callback;
+      avrc_rn_play_pos_interval = notif_interval;
+    }
+    virtual void set_on_connection_state_changed(void (*callBack)(esp_a2d_connection_state_t state, void *), void *obj = nullptr) {
+      connection_state_callback = callBack;
+      connection_state_obj = obj;
+    }
+    virtual void set_on_audio_state_changed(void (*callBack)(esp_a2d_audio_state_t state, void *), void *obj = nullptr) {
+      audio_state_callback = callBack;
+      audio_state_obj = obj;
+    }
+
+    // host-only: the harness plays the phone
+    void native_connect(uint16_t rate = 44100);
+    void native_disconnect();
+    void native_set_sample_rate(uint16_t rate);
+    void native_set_metadata(uint8_t attr, const char *text);
+    void native_set_playstatus(esp_avrc_playback_stat_t playback);
+    void native_set_play_pos(uint32_t play_pos);                  // ms into the track
+    void native_set_remote_volume(uint8_t volume);                // AVRCP absolute volume from the phone, 0..127
+    void native_write_data(const uint8_t *data, uint32_t len);   // one decoded SBC frame worth of PCM
+
+  protected:
+    const char *bt_name;
+    i2s_port_t i2s_port;
+    i2s_pin_config_t pin_config;
+    i2s_config_t i2s_config;
+    bool is_i2s_output;
+    bool is_started;
+    uint8_t volume_value;
+    int avrc_metadata_flags;
+    esp_a2d_connection_state_t connection_state;
+    esp_a2d_audio_state_t audio_state;
+
+    void (*stream_reader)(const uint8_t *, uint32_t);
+    void (*data_received)();
+    void (*volume_change_callback)(int volume);
+    void (*sample_rate_callback)(uint16_t rate);
+    void (*avrc_metadata_callback)(uint8_t, const uint8_t *);
+    void (*avrc_rn_playstatus_callback)(esp_avrc_playback_stat_t playback);
+    void (*avrc_rn_play_pos_callback)(uint32_t play_pos);
+    uint16_t avrc_rn_play_pos_interval;                         // seconds between position notifications
+    void (*connection_state_callback)(esp_a2d_connection_state_t state, void *);
+    void *connection_state_obj;
+    void (*audio_state_callback)(esp_a2d_audio_state_t state, void *);
+    void *audio_state_obj;
+
+    void set_connection_state(esp_a2d_connection_state_t state);
+    void set_audio_state(esp_a2d_audio_state_t state);
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*
+  EEPROM.cpp - host stand-in for the Arduino-ESP32 EEPROM emulation
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "EEPROM.h"
+
+EEPROMClass::EEPROMClass(void) : _data(NULL), _size(0), _dirty(false), _commits(0) {
+}
+
+EEPROMClass::~EEPROMClass() {
+  end();
+}
+
+bool EEPROMClass::begin(size_t size) {
+  if (!size) return false;
+  if (_data && size == _size) return true;
+  free(_data);
+  _data = (uint8_t *)malloc(size);
+  if (!_data) return false;
+  // erased flash reads back as 0xFF, like a fresh nvs partition
+  memset(_data, 0xFF, size);
+  _size = size;
+  _dirty = false;
+  const char *path = getenv("ESP_NATIVE_EEPROM");
+  if (path) {
+    FILE *f = fopen(path, "rb");
+    if (f) {
+      size_t n = fread(_data, 1, _size, f);
+      (void)n;
+      fclose(f);
+    }
+  }
+  return true;
+}
+
+uint8_t EEPROMClass::read(int address) {
+  if (address < 0 || (size_t)address >= _size) return 0;
+  return _data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address < 0 || (size_t)address >= _size) return;
+  if (_data[address] != value) {
+    _data[address] = value;
+    _dirty = true;
+  }
+}
+
+bool EEPROMClass::commit() {
+  if (!_data) return false;
+  if (!_dirty) return true;
+  _commits++;
+  _dirty = false;
+  const char *path = getenv("ESP_NATIVE_EEPROM");
+  if (!path) return true;
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(_data, 1, _size, f) == _size;
+  fclose(f);
+  return ok;
+}
+
+void EEPROMClass::end() {
+  if (!_data) return;
+  commit();
+  free(_data);
+  _data = NULL;
+  _size = 0;
+}
+
+EEPROMClass EEPROM;
@@ -0,0 +1,60 @@
+/*
+  EEPROM.h - host stand-in for the Arduino-ESP32 EEPROM emulation
+
+  Backed by RAM.  If the ESP_NATIVE_EEPROM environment variable names a file,
+  begin() loads it and commit() writes it back so settings survive restarts
+  of the host binary just like they survive a reboot of the board.
+*/
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class EEPROMClass {
+  public:
+    EEPROMClass(void);
+    ~EEPROMClass(void);
+
+    bool begin(size_t size);
+    uint8_t read(int address);
+    void write(int address, uint8_t val);
+    uint16_t length() { return (uint16_t)_size; }
+    bool commit();
+    void end();
+
+    uint8_t *getDataPtr() { _dirty = true; return _data; }
+    const uint8_t *getConstDataPtr() const { return _data; }
+
+    template<typename T>
+    T &get(int address, T &t) {
+      if (address < 0 || address + sizeof(T) > _size) return t;
+      memcpy((uint8_t *)&t, _data + address, sizeof(T));
+      return t;
+    }
+
+    template<typename T>
+    const T &put(int address, const T &t) {
+      if (address < 0 || address + sizeof(T) > _size) return t;
+      if (memcmp(_data + address, (const uint8_t *)&t, sizeof(T)) != 0) {
+        memcpy(_data + address, (const uint8_t *)&t, sizeof(T));
+        _dirty = true;
+      }
+      return t;
+    }
+
+    // host-only: number of commit() calls that actually had data to write
+    uint32_t commitCount() const { return _commits; }
+
+  protected:
+    uint8_t *_data;
+    size_t _size;
+    bool _dirty;
+    uint32_t _commits;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,27 @@
+/*
+  Esp.h - host stand-in for the EspClass chip helpers
+*/
+
+#ifndef ESP_H
+#define ESP_H
+
+#include <stdint.h>
+
+class EspClass {
+  public:
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getFreePsram() { return 0; }
+    uint32_t getPsramSize() { return 0; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount();
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    const char * getSdkVersion() { return "native"; }
+    void restart();
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,283 @@
+/*
+  FS.cpp - host stand-in for the Arduino-ESP32 virtual file system
+*/
+
+#include <stdio.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FS.h"
+#include "SPIFFS.h"
+
+using namespace fs;
+
+namespace fs
+{
+
+class FileImpl
+{
+public:
+    FileImpl(const std::string &root, const std::string &path, FILE *f, DIR *d)
+        : _root(root), _path(path), _f(f), _d(d)
+    {
+        size_t slash = _path.find_last_of('/');
+        _name = (slash == std::string::npos) ? _path : _path.substr(slash + 1);
+    }
+    ~FileImpl() { close(); }
+
+    void close()
+    {
+        if (_f) fclose(_f);
+        if (_d) closedir(_d);
+        _f = NULL;
+        _d = NULL;
+    }
+
+    std::string _root;
+    std::string _path;
+    std::string _name;
+    FILE *_f;
+    DIR *_d;
+};
+
+}
+
+// ----------------------------------------------------------------
+//                          -File
+// ----------------------------------------------------------------
+
+size_t File::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+    if (!_p || !_p->_f) return 0;
+    return fwrite(buf, 1, size, _p->_f);
+}
+
+int File::available()
+{
+    if (!_p || !_p->_f) return 0;
+    long pos = ftell(_p->_f);
+    return (pos < 0) ? 0 : (int)(size() - (size_t)pos);
+}
+
+int File::read()
+{
+    if (!_p || !_p->_f) return -1;
+    return fgetc(_p->_f);
+}
+
+size_t File::read(uint8_t* buf, size_t size)
+{
+    if (!_p || !_p->_f) return 0;
+    return fread(buf, 1, size, _p->_f);
+}
+
+int File::peek()
+{
+    if (!_p || !_p->_f) return -1;
+    int c = fgetc(_p->_f);
+    if (c != EOF) ungetc(c, _p->_f);
+    return c;
+}
+
+void File::flush()
+{
+    if (_p && _p->_f) fflush(_p->_f);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    if (!_p || !_p->_f) return false;
+    int whence = (mode == SeekCur) ? SEEK_CUR : (mode == SeekEnd) ? SEEK_END : SEEK_SET;
+    return fseek(_p->_f, pos, whence) == 0;
+}
+
+size_t File::position() const
+{
+    if (!_p || !_p->_f) return 0;
+    long pos = ftell(_p->_f);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const
+{
+    if (!_p || !_p->_f) return 0;
+    struct stat st;
+    fflush(_p->_f);
+    if (fstat(fileno(_p->_f), &st) != 0) return 0;
+    return (size_t)st.st_size;
+}
+
+void File::close()
+{
+    if (_p) {
+        _p->close();
+        _p = NULL;
+    }
+}
+
+File::operator bool() const
+{
+    return !!_p && (_p->_f || _p->_d);
+}
+
+time_t File::getLastWrite()
+{
+    if (!_p) return 0;
+    struct stat st;
+    if (stat((_p->_root + _p->_path).c_str(), &st) != 0) return 0;
+    return st.st_mtime;
+}
+
+const char* File::path() const
+{
+    return _p ? _p->_path.c_str() : NULL;
+}
+
+const char* File::name() const
+{
+    return _p ? _p->_name.c_str() : NULL;
+}
+
+boolean File::isDirectory(void)
+{
+    return _p && _p->_d;
+}
+
+File File::openNextFile(const char* mode)
+{
+    if (!_p || !_p->_d) return File();
+    struct dirent *e;
+    while ((e = readdir(_p->_d)) != NULL) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        std::string child = _p->_path;
+        if (child.empty() || child[child.size() - 1] != '/') child += "/";
+        child += e->d_name;
+        return FS(_p->_root).open(child.c_str(), mode);
+    }
+    return File();
+}
+
+void File::rewindDirectory(void)
+{
+    if (_p && _p->_d) rewinddir(_p->_d);
+}
+
+// ----------------------------------------------------------------
+//                          -FS
+// ----------------------------------------------------------------
+
+std::string FS::hostPath(const char *path) const
+{
+    std::string p = path ? path : "/";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return _root + p;
+}
+
+File FS::open(const char* path, const char* mode, const bool create)
+{
+    if (!path || path[0] != '/') {
+        log_e("%s does not start with /", path ? path : "(null)");
+        return File();
+    }
+    std::string host = hostPath(path);
+    struct stat st;
+    if (stat(host.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR *d = opendir(host.c_str());
+        if (!d) return File();
+        return File(std::make_shared<FileImpl>(_root, path, (FILE *)NULL, d));
+    }
+    if (create && mode[0] != 'r') {
+        std::string dir = host.substr(0, host.find_last_of('/'));
+        for (size_t i = _root.size() + 1; i <= dir.size(); i++) {
+            if (i == dir.size() || dir[i] == '/') ::mkdir(dir.substr(0, i).c_str(), 0755);
+        }
+    }
+    std::string m = mode;
+    if (m.find('b') == std::string::npos) m += "b";
+    FILE *f = fopen(host.c_str(), m.c_str());
+    if (!f) return File();
+    return File(std::make_shared<FileImpl>(_root, path, f, (DIR *)NULL));
+}
+
+bool FS::exists(const char* path)
+{
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path)
+{
+    return ::unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo)
+{
+    return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char *path)
+{
+    return ::mkdir(hostPath(path).c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool FS::rmdir(const char *path)
+{
+    return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+// ----------------------------------------------------------------
+//                          -SPIFFS
+// ----------------------------------------------------------------
+
+SPIFFSFS::SPIFFSFS() : FS("data")
+{
+}
+
+bool SPIFFSFS::begin(bool formatOnFail, const char * basePath, uint8_t maxOpenFiles, const char * partitionLabel)
+{
+    (void)basePath;
+    (void)maxOpenFiles;
+    (void)partitionLabel;
+    const char *root = getenv("ESP_NATIVE_SPIFFS");
+    if (root) _root = root;
+    struct stat st;
+    if (stat(_root.c_str(), &st) == 0) return S_ISDIR(st.st_mode);
+    return formatOnFail && ::mkdir(_root.c_str(), 0755) == 0;
+}
+
+bool SPIFFSFS::format()
+{
+    return true;
+}
+
+size_t SPIFFSFS::totalBytes()
+{
+    return 0x20000;     // spiffs partition size in partitions.csv
+}
+
+size_t SPIFFSFS::usedBytes()
+{
+    size_t used = 0;
+    DIR *d = opendir(_root.c_str());
+    if (!d) return 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        struct stat st;
+        if (stat((_root + "/" + e->d_name).c_str(), &st) == 0 && S_ISREG(st.st_mode)) used += st.st_size;
+    }
+    closedir(d);
+    return used;
+}
+
+void SPIFFSFS::end()
+{
+}
+
+fs::SPIFFSFS SPIFFS;
@@ -0,0 +1,45 @@
+/*
+  HardwareSerial.cpp - host stand-in; Serial reads stdin and writes stdout
+*/
+
+#include <stdio.h>
+#include <unistd.h>
+#include <poll.h>
+
+#include "HardwareSerial.h"
+
+HardwareSerial Serial(0);
+
+static int _peeked = -1;
+
+int HardwareSerial::available(void) {
+  if (_peeked >= 0) return 1;
+  struct pollfd p = { STDIN_FILENO, POLLIN, 0 };
+  return (poll(&p, 1, 0) > 0 && (p.revents & POLLIN)) ? 1 : 0;
+}
+
+int HardwareSerial::peek(void) {
+  if (_peeked < 0 && available()) {
+    unsigned char c;
+    if (::read(STDIN_FILENO, &c, 1) == 1) _peeked = c;
+  }
+  return _peeked;
+}
+
+int HardwareSerial::read(void) {
+  int c = peek();
+  _peeked = -1;
+  return c;
+}
+
+void HardwareSerial::flush(void) {
+  fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
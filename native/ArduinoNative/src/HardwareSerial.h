@@ -0,0 +1,39 @@
+/*
+  HardwareSerial.h - host stand-in; Serial reads stdin and writes stdout
+*/
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include <inttypes.h>
+#include "Stream.h"
+
+class HardwareSerial: public Stream {
+  public:
+    HardwareSerial(int uart_nr) : _uart_nr(uart_nr), _baud(0) {}
+
+    void begin(unsigned long baud, uint32_t config = 0, int8_t rxPin = -1, int8_t txPin = -1, bool invert = false, unsigned long timeout_ms = 20000UL) {
+      (void)config; (void)rxPin; (void)txPin; (void)invert; (void)timeout_ms;
+      _baud = baud;
+    }
+    void end() { _baud = 0; }
+
+    int available(void) override;
+    int peek(void) override;
+    int read(void) override;
+    void flush(void) override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    uint32_t baudRate() { return _baud; }
+    operator bool() const { return true; }
+
+  protected:
+    int _uart_nr;
+    unsigned long _baud;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,110 @@
+/*
+  NativeHeap.cpp - counting malloc for host benchmarks
+*/
+
+#include <errno.h>
+#include <malloc.h>
+#include <atomic>
+
+#include "NativeHeap.h"
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+void *__libc_memalign(size_t alignment, size_t size);
+}
+
+static std::atomic<uint64_t> heapAllocs(0);
+static std::atomic<uint64_t> heapReallocs(0);
+static std::atomic<uint64_t> heapFrees(0);
+static std::atomic<size_t> heapLive(0);
+static std::atomic<size_t> heapPeak(0);
+
+static void heapAdd(void *p) {
+  size_t size = malloc_usable_size(p);
+  size_t live = heapLive.fetch_add(size, std::memory_order_relaxed) + size;
+  size_t peak = heapPeak.load(std::memory_order_relaxed);
+  while (live > peak && !heapPeak.compare_exchange_weak(peak, live));
+}
+
+static void heapRemove(void *p) {
+  heapLive.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+}
+
+extern "C" void *malloc(size_t size) {
+  void *p = __libc_malloc(size);
+  if (p) {
+    heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    heapAdd(p);
+  }
+  return p;
+}
+
+extern "C" void *calloc(size_t n, size_t size) {
+  void *p = __libc_calloc(n, size);
+  if (p) {
+    heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    heapAdd(p);
+  }
+  return p;
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+  if (!ptr) return malloc(size);
+  size_t old = malloc_usable_size(ptr);
+  void *p = __libc_realloc(ptr, size);
+  if (p) {
+    heapReallocs.fetch_add(1, std::memory_order_relaxed);
+    heapLive.fetch_sub(old, std::memory_order_relaxed);
+    heapAdd(p);
+  } else if (size == 0) {
+    heapFrees.fetch_add(1, std::memory_order_relaxed);
+    heapLive.fetch_sub(old, std::memory_order_relaxed);
+  }
+  return p;
+}
+
+extern "C" void free(void *ptr) {
+  if (!ptr) return;
+  heapFrees.fetch_add(1, std::memory_order_relaxed);
+  heapRemove(ptr);
+  __libc_free(ptr);
+}
+
+// aligned allocations are released through free() too, so they must be counted
+extern "C" void *memalign(size_t alignment, size_t size) {
+  void *p = __libc_memalign(alignment, size);
+  if (p) {
+    heapAllocs.fetch_add(1, std::memory_order_relaxed);
+    heapAdd(p);
+  }
+  return p;
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) {
+  return memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **memptr, size_t alignment, size_t size) {
+  if (alignment < sizeof(void *) || (alignment & (alignment - 1))) return EINVAL;
+  void *p = memalign(alignment, size);
+  if (!p) return ENOMEM;
+  *memptr = p;
+  return 0;
+}
+
+NativeHeapStats nativeHeapStats() {
+  NativeHeapStats s;
+  s.allocs = heapAllocs.load();
+  s.reallocs = heapReallocs.load();
+  s.frees = heapFrees.load();
+  s.liveBytes = heapLive.load();
+  s.peakBytes = heapPeak.load();
+  return s;
+}
+
+void nativeHeapResetPeak() {
+  heapPeak.store(heapLive.load());
+}
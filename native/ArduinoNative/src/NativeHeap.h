@@ -0,0 +1,26 @@
+/*
+  NativeHeap.h - heap accounting for host benchmarks
+
+  Host programs get malloc/free/calloc/realloc as counting wrappers around
+  glibc, so String, new/delete and library allocations are all seen.  The
+  counters are relaxed atomics and cost a few ns per call.
+*/
+
+#ifndef NativeHeap_h
+#define NativeHeap_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct NativeHeapStats {
+  uint64_t allocs;      // successful malloc/calloc/realloc(NULL) calls
+  uint64_t reallocs;    // realloc of an existing block
+  uint64_t frees;
+  size_t   liveBytes;   // usable size of all blocks currently allocated
+  size_t   peakBytes;   // high-water mark of liveBytes since the last reset
+};
+
+NativeHeapStats nativeHeapStats();
+void nativeHeapResetPeak();
+
+#endif
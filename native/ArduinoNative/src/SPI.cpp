@@ -0,0 +1,7 @@
+/*
+  SPI.cpp - host stand-in for the Arduino-ESP32 SPIClass
+*/
+
+#include "SPI.h"
+
+SPIClass SPI(VSPI);
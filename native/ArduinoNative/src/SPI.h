@@ -0,0 +1,74 @@
+/*
+  SPI.h - host stand-in for the Arduino-ESP32 SPIClass
+
+  Nothing in esp-Music uses SPI; this only exists so the display libraries
+  (which support SPI panels too) compile.  Transfers are discarded.
+*/
+
+#ifndef _SPI_H_INCLUDED
+#define _SPI_H_INCLUDED
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+#define SPI_LSBFIRST 0
+#define SPI_MSBFIRST 1
+
+#define SPI_CLOCK_DIV2 0x00101001
+
+#define FSPI 1
+#define HSPI 2
+#define VSPI 3
+
+class SPISettings {
+  public:
+    SPISettings() : _clock(1000000), _bitOrder(1), _dataMode(SPI_MODE0) {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : _clock(clock), _bitOrder(bitOrder), _dataMode(dataMode) {}
+    uint32_t _clock;
+    uint8_t  _bitOrder;
+    uint8_t  _dataMode;
+};
+
+class SPIClass {
+  public:
+    SPIClass(uint8_t spi_bus = HSPI) : _spi_num(spi_bus), _freq(1000000) {}
+    bool begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) { (void)sck; (void)miso; (void)mosi; (void)ss; return true; }
+    void end() {}
+
+    void setHwCs(bool use) { (void)use; }
+    void setBitOrder(uint8_t bitOrder) { (void)bitOrder; }
+    void setDataMode(uint8_t dataMode) { (void)dataMode; }
+    void setFrequency(uint32_t freq) { _freq = freq; }
+    void setClockDivider(uint32_t clockDiv) { (void)clockDiv; }
+    uint32_t getClockDivider() { return 0; }
+
+    void beginTransaction(SPISettings settings) { _freq = settings._clock; }
+    void endTransaction(void) {}
+    void transfer(void *data, uint32_t size) { (void)data; (void)size; }
+    uint8_t transfer(uint8_t data) { (void)data; return 0; }
+    uint16_t transfer16(uint16_t data) { (void)data; return 0; }
+    uint32_t transfer32(uint32_t data) { (void)data; return 0; }
+
+    void transferBytes(const uint8_t *data, uint8_t *out, uint32_t size) { (void)data; if (out) for (uint32_t i = 0; i < size; i++) out[i] = 0; }
+    void transferBits(uint32_t data, uint32_t *out, uint8_t bits) { (void)data; (void)bits; if (out) *out = 0; }
+
+    void write(uint8_t data) { (void)data; }
+    void write16(uint16_t data) { (void)data; }
+    void write32(uint32_t data) { (void)data; }
+    void writeBytes(const uint8_t *data, uint32_t size) { (void)data; (void)size; }
+    void writePixels(const void *data, uint32_t size) { (void)data; (void)size; }
+    void writePattern(const uint8_t *data, uint8_t size, uint32_t repeat) { (void)data; (void)size; (void)repeat; }
+
+  private:
+    uint8_t _spi_num;
+    uint32_t _freq;
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,30 @@
+/*
+  SPIFFS.h - host stand-in for the ESP32 SPIFFS partition
+
+  Rooted at $ESP_NATIVE_SPIFFS, or ./data (the PlatformIO uploadfs folder).
+*/
+
+#ifndef _SPIFFS_H_
+#define _SPIFFS_H_
+
+#include "FS.h"
+
+namespace fs
+{
+
+class SPIFFSFS : public FS
+{
+public:
+    SPIFFSFS();
+    bool begin(bool formatOnFail = false, const char * basePath = "/spiffs", uint8_t maxOpenFiles = 10, const char * partitionLabel = NULL);
+    bool format();
+    size_t totalBytes();
+    size_t usedBytes();
+    void end();
+};
+
+}
+
+extern fs::SPIFFSFS SPIFFS;
+
+#endif
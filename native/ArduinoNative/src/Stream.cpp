@@ -0,0 +1,105 @@
+/*
+  Stream.cpp - host stand-in for the Arduino Stream base class
+*/
+
+#include "Arduino.h"
+#include "Stream.h"
+
+int Stream::timedRead() {
+  int c;
+  _startMillis = millis();
+  do {
+    c = read();
+    if (c >= 0) return c;
+  } while (millis() - _startMillis < _timeout);
+  return -1;
+}
+
+int Stream::timedPeek() {
+  int c;
+  _startMillis = millis();
+  do {
+    c = peek();
+    if (c >= 0) return c;
+  } while (millis() - _startMillis < _timeout);
+  return -1;
+}
+
+bool Stream::find(const char *target) {
+  return find(target, strlen(target));
+}
+
+bool Stream::find(const char *target, size_t length) {
+  size_t index = 0;
+  int c;
+  if (length == 0) return true;
+  while ((c = timedRead()) > 0) {
+    if ((char)c == target[index]) {
+      if (++index >= length) return true;
+    } else {
+      index = ((char)c == target[0]) ? 1 : 0;
+    }
+  }
+  return false;
+}
+
+bool Stream::findUntil(const char *target, const char *terminator) {
+  size_t tlen = strlen(target), termLen = terminator ? strlen(terminator) : 0;
+  size_t index = 0, termIndex = 0;
+  int c;
+  while ((c = timedRead()) > 0) {
+    if ((char)c == target[index]) {
+      if (++index >= tlen) return true;
+    } else {
+      index = 0;
+    }
+    if (termLen > 0 && (char)c == terminator[termIndex]) {
+      if (++termIndex >= termLen) return false;
+    } else {
+      termIndex = 0;
+    }
+  }
+  return false;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    int c = timedRead();
+    if (c < 0) break;
+    *buffer++ = (char)c;
+    count++;
+  }
+  return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length) {
+  size_t index = 0;
+  while (index < length) {
+    int c = timedRead();
+    if (c < 0 || c == terminator) break;
+    *buffer++ = (char)c;
+    index++;
+  }
+  return index;
+}
+
+String Stream::readString() {
+  String ret;
+  int c = timedRead();
+  while (c >= 0) {
+    ret += (char)c;
+    c = timedRead();
+  }
+  return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String ret;
+  int c = timedRead();
+  while (c >= 0 && c != terminator) {
+    ret += (char)c;
+    c = timedRead();
+  }
+  return ret;
+}
@@ -0,0 +1,42 @@
+/*
+  Stream.h - host stand-in for the Arduino Stream base class
+*/
+
+#ifndef Stream_h
+#define Stream_h
+
+#include <inttypes.h>
+#include "Print.h"
+
+class Stream: public Print {
+  protected:
+    unsigned long _timeout;
+    unsigned long _startMillis;
+    int timedRead();
+    int timedPeek();
+
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    Stream() : _timeout(1000), _startMillis(0) {}
+    virtual ~Stream() {}
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout(void) { return _timeout; }
+
+    bool find(const char *target);
+    bool find(const char *target, size_t length);
+    bool findUntil(const char *target, const char *terminator);
+
+    virtual size_t readBytes(char *buffer, size_t length);
+    virtual size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+    size_t readBytesUntil(char terminator, uint8_t *buffer, size_t length) { return readBytesUntil(terminator, (char *)buffer, length); }
+
+    virtual String readString();
+    String readStringUntil(char terminator);
+};
+
+#endif
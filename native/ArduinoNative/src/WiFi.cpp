@@ -0,0 +1,7 @@
+/*
+  WiFi.cpp - host stand-in for the Arduino-ESP32 WiFi class
+*/
+
+#include "WiFi.h"
+
+WiFiClass WiFi;
@@ -0,0 +1,67 @@
+/*
+  WiFi.h - host stand-in for the Arduino-ESP32 WiFi class
+
+  The host is always "connected"; the station address is the loopback
+  interface so the web server is reachable at http://127.0.0.1/.
+*/
+
+#ifndef WiFi_h
+#define WiFi_h
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+typedef enum {
+    WL_NO_SHIELD        = 255,
+    WL_IDLE_STATUS      = 0,
+    WL_NO_SSID_AVAIL    = 1,
+    WL_SCAN_COMPLETED   = 2,
+    WL_CONNECTED        = 3,
+    WL_CONNECT_FAILED   = 4,
+    WL_CONNECTION_LOST  = 5,
+    WL_DISCONNECTED     = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+class WiFiClass
+{
+  public:
+    WiFiClass() : _ssid(""), _status(WL_IDLE_STATUS), _mode(WIFI_OFF) {}
+
+    wl_status_t begin(const char* ssid, const char *passphrase = NULL, int32_t channel = 0, const uint8_t* bssid = NULL, bool connect = true) {
+      (void)passphrase; (void)channel; (void)bssid; (void)connect;
+      _ssid = ssid ? ssid : "";
+      _mode = WIFI_STA;
+      _status = WL_CONNECTED;
+      return _status;
+    }
+    bool disconnect(bool wifioff = false) { if (wifioff) _mode = WIFI_OFF; _status = WL_DISCONNECTED; return true; }
+    bool setAutoReconnect(bool autoReconnect) { (void)autoReconnect; return true; }
+    bool persistent(bool persistent) { (void)persistent; return true; }
+    bool mode(wifi_mode_t m) { _mode = m; return true; }
+    wifi_mode_t getMode() { return _mode; }
+    bool setSleep(bool enabled) { (void)enabled; return true; }
+
+    wl_status_t status() { return _status; }
+    bool isConnected() { return _status == WL_CONNECTED; }
+    String SSID() const { return _ssid; }
+    int8_t RSSI() { return -40; }
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    IPAddress softAPIP() { return IPAddress(127, 0, 0, 1); }
+    String macAddress() { return String("02:00:00:00:00:01"); }
+
+  private:
+    String _ssid;
+    wl_status_t _status;
+    wifi_mode_t _mode;
+};
+
+extern WiFiClass WiFi;
+
+#endif
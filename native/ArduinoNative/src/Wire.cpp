@@ -0,0 +1,104 @@
+/*
+  Wire.cpp - host stand-in for the Arduino-ESP32 TwoWire (I2C) class
+*/
+
+#include "Arduino.h"
+#include "Wire.h"
+
+TwoWire::TwoWire(uint8_t bus_num)
+  : _num(bus_num), _clock(100000), _timeOutMillis(50), _txAddress(0), _txLength(0),
+    _rxIndex(0), _rxLength(0), _busTiming(false) {
+  resetStats();
+}
+
+TwoWire::~TwoWire() {
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+  (void)sda;
+  (void)scl;
+  if (frequency) _clock = frequency;
+  return true;
+}
+
+bool TwoWire::begin(uint8_t slaveAddr, int sda, int scl, uint32_t frequency) {
+  (void)slaveAddr;
+  return begin(sda, scl, frequency);
+}
+
+bool TwoWire::end() {
+  return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+  if (frequency) _clock = frequency;
+  return true;
+}
+
+void TwoWire::beginTransmission(uint16_t address) {
+  _txAddress = address;
+  _txLength = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  (void)sendStop;
+  // start + address byte + payload, 9 clocks per byte (8 data + ack), + stop
+  uint32_t clocks = 1 + 9 * (uint32_t)(1 + _txLength) + 1;
+  uint32_t us = (uint32_t)(((uint64_t)clocks * 1000000ULL + _clock - 1) / _clock);
+  _stats.transmissions++;
+  _stats.bytes += _txLength;
+  _stats.busMicros += us;
+  if (_observer) _observer((uint8_t)_txAddress, _txBuffer, _txLength);
+  if (_busTiming) delayMicroseconds(us);
+  _txLength = 0;
+  return 0;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop) {
+  (void)address;
+  (void)sendStop;
+  // nothing answers on the host bus
+  (void)size;
+  _rxIndex = 0;
+  _rxLength = 0;
+  return 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (_txLength >= I2C_BUFFER_LENGTH) return 0;
+  _txBuffer[_txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  for (size_t i = 0; i < quantity; ++i) {
+    if (!write(data[i])) return i;
+  }
+  return quantity;
+}
+
+int TwoWire::available(void) {
+  return (int)(_rxLength - _rxIndex);
+}
+
+int TwoWire::read(void) {
+  return -1;
+}
+
+int TwoWire::peek(void) {
+  return -1;
+}
+
+void TwoWire::flush(void) {
+  _txLength = 0;
+  _rxIndex = _rxLength = 0;
+}
+
+void TwoWire::resetStats() {
+  _stats.transmissions = 0;
+  _stats.bytes = 0;
+  _stats.busMicros = 0;
+}
+
+TwoWire Wire = TwoWire(0);
+TwoWire Wire1 = TwoWire(1);
@@ -0,0 +1,87 @@
+/*
+  Wire.h - host stand-in for the Arduino-ESP32 TwoWire (I2C) class
+
+  No bus exists on the host.  Every transmission is counted (bytes, frames
+  and the time it would occupy the bus at the configured clock) and can be
+  handed to an observer, so display drivers can be profiled and their output
+  checked off the board.
+*/
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <stdint.h>
+#include <functional>
+
+#include "Stream.h"
+
+#define I2C_BUFFER_LENGTH 128
+
+typedef std::function<void(uint8_t address, const uint8_t *data, size_t len)> WireTransmitObserver;
+
+struct WireStats {
+  uint32_t transmissions;       // completed endTransmission() calls
+  uint32_t bytes;               // payload bytes written, address bytes excluded
+  uint64_t busMicros;           // time the traffic would take on the wire
+};
+
+class TwoWire: public Stream {
+  public:
+    TwoWire(uint8_t bus_num);
+    ~TwoWire();
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool begin(uint8_t slaveAddr, int sda, int scl, uint32_t frequency);
+    bool end();
+
+    bool setClock(uint32_t frequency);
+    uint32_t getClock() { return _clock; }
+    void setTimeOut(uint16_t timeOutMillis) { _timeOutMillis = timeOutMillis; }
+    uint16_t getTimeOut() { return _timeOutMillis; }
+
+    void beginTransmission(uint16_t address);
+    void beginTransmission(uint8_t address) { beginTransmission((uint16_t)address); }
+    void beginTransmission(int address) { beginTransmission((uint16_t)address); }
+    uint8_t endTransmission(bool sendStop);
+    uint8_t endTransmission(void) { return endTransmission(true); }
+
+    size_t requestFrom(uint16_t address, size_t size, bool sendStop);
+    uint8_t requestFrom(uint16_t address, uint8_t size, bool sendStop) { return (uint8_t)requestFrom(address, (size_t)size, sendStop); }
+    uint8_t requestFrom(uint16_t address, uint8_t size, uint8_t sendStop) { return requestFrom(address, size, (bool)sendStop); }
+    uint8_t requestFrom(uint16_t address, uint8_t size) { return requestFrom(address, size, true); }
+    uint8_t requestFrom(uint8_t address, uint8_t size, uint8_t sendStop) { return requestFrom((uint16_t)address, size, (bool)sendStop); }
+    uint8_t requestFrom(uint8_t address, uint8_t size) { return requestFrom((uint16_t)address, size, true); }
+    uint8_t requestFrom(int address, int size) { return requestFrom((uint16_t)address, (uint8_t)size, true); }
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *data, size_t quantity) override;
+    using Print::write;
+    int available(void) override;
+    int read(void) override;
+    int peek(void) override;
+    void flush(void) override;
+
+    // host-only instrumentation
+    void onTransmit(WireTransmitObserver observer) { _observer = observer; }
+    void setBusTiming(bool enable) { _busTiming = enable; }   // sleep for the simulated bus time
+    const WireStats &stats() const { return _stats; }
+    void resetStats();
+
+  protected:
+    uint8_t _num;
+    uint32_t _clock;
+    uint16_t _timeOutMillis;
+    uint16_t _txAddress;
+    uint8_t _txBuffer[I2C_BUFFER_LENGTH];
+    size_t _txLength;
+    size_t _rxIndex;
+    size_t _rxLength;
+    bool _busTiming;
+    WireStats _stats;
+    WireTransmitObserver _observer;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
@@ -0,0 +1,114 @@
+/*
+  driver/i2s.h - host stand-in for the ESP-IDF legacy I2S driver
+
+  i2s_write() behaves like the real DMA-backed driver: it accepts data until
+  the configured DMA buffers are full and then blocks for as long as the
+  hardware would need to play them out at the configured sample rate.  An
+  optional observer receives every byte "played", so harnesses can capture
+  the device's output.
+*/
+
+#ifndef _DRIVER_I2S_H_
+#define _DRIVER_I2S_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+#include "freertos/FreeRTOS.h"
+
+typedef int esp_err_t;
+#define ESP_OK                  0
+#define ESP_FAIL                -1
+#define ESP_ERR_INVALID_ARG     0x102
+#define ESP_ERR_INVALID_STATE   0x103
+
+#define I2S_PIN_NO_CHANGE       (-1)
+
+typedef enum {
+    I2S_NUM_0 = 0,
+    I2S_NUM_1 = 1,
+    I2S_NUM_MAX,
+} i2s_port_t;
+
+typedef enum {
+    I2S_BITS_PER_SAMPLE_8BIT    = 8,
+    I2S_BITS_PER_SAMPLE_16BIT   = 16,
+    I2S_BITS_PER_SAMPLE_24BIT   = 24,
+    I2S_BITS_PER_SAMPLE_32BIT   = 32,
+} i2s_bits_per_sample_t;
+
+typedef enum {
+    I2S_CHANNEL_MONO        = 1,
+    I2S_CHANNEL_STEREO      = 2
+} i2s_channel_t;
+
+typedef enum {
+    I2S_CHANNEL_FMT_RIGHT_LEFT = 0x00,
+    I2S_CHANNEL_FMT_ALL_RIGHT,
+    I2S_CHANNEL_FMT_ALL_LEFT,
+    I2S_CHANNEL_FMT_ONLY_RIGHT,
+    I2S_CHANNEL_FMT_ONLY_LEFT,
+} i2s_channel_fmt_t;
+
+typedef enum {
+    I2S_COMM_FORMAT_STAND_I2S       = 0X01,
+    I2S_COMM_FORMAT_STAND_MSB       = 0X03,
+    I2S_COMM_FORMAT_STAND_PCM_SHORT = 0x04,
+    I2S_COMM_FORMAT_STAND_PCM_LONG  = 0x0C,
+    I2S_COMM_FORMAT_I2S             = 0x01,
+    I2S_COMM_FORMAT_I2S_MSB         = 0x01,
+    I2S_COMM_FORMAT_I2S_LSB         = 0x02,
+} i2s_comm_format_t;
+
+typedef enum {
+    I2S_MODE_MASTER       = 1,
+    I2S_MODE_SLAVE        = 2,
+    I2S_MODE_TX           = 4,
+    I2S_MODE_RX           = 8,
+    I2S_MODE_DAC_BUILT_IN = 16,
+} i2s_mode_t;
+
+#define ESP_INTR_FLAG_LEVEL1    (1<<1)
+
+typedef struct {
+    int mck_io_num;
+    int bck_io_num;
+    int ws_io_num;
+    int data_out_num;
+    int data_in_num;
+} i2s_pin_config_t;
+
+typedef struct {
+    int mode;
+    uint32_t sample_rate;
+    i2s_bits_per_sample_t bits_per_sample;
+    i2s_channel_fmt_t channel_format;
+    int communication_format;
+    int intr_alloc_flags;
+    int dma_buf_count;
+    int dma_buf_len;
+    bool use_apll;
+    bool tx_desc_auto_clear;
+    int fixed_mclk;
+} i2s_config_t;
+
+typedef void *QueueHandle_i2s_t;
+
+esp_err_t i2s_driver_install(i2s_port_t i2s_num, const i2s_config_t *i2s_config, int queue_size, void *i2s_queue);
+esp_err_t i2s_driver_uninstall(i2s_port_t i2s_num);
+esp_err_t i2s_set_pin(i2s_port_t i2s_num, const i2s_pin_config_t *pin);
+esp_err_t i2s_set_clk(i2s_port_t i2s_num, uint32_t rate, i2s_bits_per_sample_t bits, i2s_channel_t ch);
+esp_err_t i2s_set_sample_rates(i2s_port_t i2s_num, uint32_t rate);
+esp_err_t i2s_start(i2s_port_t i2s_num);
+esp_err_t i2s_stop(i2s_port_t i2s_num);
+esp_err_t i2s_zero_dma_buffer(i2s_port_t i2s_num);
+esp_err_t i2s_write(i2s_port_t i2s_num, const void *src, size_t size, size_t *bytes_written, TickType_t ticks_to_wait);
+
+// host-only instrumentation
+typedef std::function<void(i2s_port_t port, const uint8_t *data, size_t len)> I2SWriteObserver;
+void i2s_native_set_observer(I2SWriteObserver observer);
+void i2s_native_set_realtime(bool enable);          // false: never block, "play" instantly
+uint64_t i2s_native_bytes_written(i2s_port_t i2s_num);
+
+#endif
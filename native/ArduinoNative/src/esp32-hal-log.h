@@ -0,0 +1,30 @@
+/*
+  esp32-hal-log.h - host stand-in; log macros print to stderr
+*/
+
+#ifndef __ARDUHAL_LOG_H__
+#define __ARDUHAL_LOG_H__
+
+#include <stdio.h>
+
+#ifndef CORE_DEBUG_LEVEL
+#define CORE_DEBUG_LEVEL 1
+#endif
+
+#define ARDUHAL_LOG_LEVEL_NONE    (0)
+#define ARDUHAL_LOG_LEVEL_ERROR   (1)
+#define ARDUHAL_LOG_LEVEL_WARN    (2)
+#define ARDUHAL_LOG_LEVEL_INFO    (3)
+#define ARDUHAL_LOG_LEVEL_DEBUG   (4)
+#define ARDUHAL_LOG_LEVEL_VERBOSE (5)
+
+#define ARDUHAL_LOG(letter, level, format, ...) \
+  do { if (CORE_DEBUG_LEVEL >= (level)) fprintf(stderr, "[" #letter "][%s:%d] %s(): " format "\n", __FILE__, __LINE__, __func__, ##__VA_ARGS__); } while (0)
+
+#define log_e(format, ...) ARDUHAL_LOG(E, ARDUHAL_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#define log_w(format, ...) ARDUHAL_LOG(W, ARDUHAL_LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#define log_i(format, ...) ARDUHAL_LOG(I, ARDUHAL_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define log_d(format, ...) ARDUHAL_LOG(D, ARDUHAL_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#define log_v(format, ...) ARDUHAL_LOG(V, ARDUHAL_LOG_LEVEL_VERBOSE, format, ##__VA_ARGS__)
+
+#endif
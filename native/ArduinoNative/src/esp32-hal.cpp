@@ -0,0 +1,199 @@
+/*
+  esp32-hal.cpp - host stand-in for the Arduino-ESP32 hardware layer
+
+  Time is measured from process start with the monotonic clock.  Gpio pins
+  are a plain array: outputs can be read back and inputs are driven from a
+  test harness with nativeSetPin(), which fires any attached interrupt just
+  like an edge on the real pin would.
+*/
+
+#include <time.h>
+#include <sched.h>
+#include <malloc.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+
+EspClass ESP;
+
+static uint64_t elapsedMicros() {
+  // function-local so millis() is valid from other static constructors too
+  static const struct timespec start = []() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts;
+  }();
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)(ts.tv_sec - start.tv_sec) * 1000000ULL + ((int64_t)ts.tv_nsec - start.tv_nsec) / 1000;
+}
+
+// ----------------------------------------------------------------
+//                          -timing
+// ----------------------------------------------------------------
+
+extern "C" unsigned long millis(void) {
+  return (unsigned long)(elapsedMicros() / 1000ULL);
+}
+
+extern "C" unsigned long micros(void) {
+  return (unsigned long)elapsedMicros();
+}
+
+extern "C" void delay(uint32_t ms) {
+  vTaskDelay(ms / portTICK_PERIOD_MS);
+}
+
+extern "C" void delayMicroseconds(uint32_t us) {
+  struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+  nanosleep(&ts, NULL);
+}
+
+extern "C" void yield(void) {
+  sched_yield();
+}
+
+// ----------------------------------------------------------------
+//                          -gpio
+// ----------------------------------------------------------------
+
+volatile uint32_t nativeGpioRegs[2];
+
+static uint8_t pinModes[NATIVE_GPIO_COUNT];
+static volatile uint8_t pinLevels[NATIVE_GPIO_COUNT];
+static voidFuncPtr pinHandlers[NATIVE_GPIO_COUNT];
+static int pinHandlerModes[NATIVE_GPIO_COUNT];
+static portMUX_TYPE gpioMux = portMUX_INITIALIZER_UNLOCKED;
+
+extern "C" void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= NATIVE_GPIO_COUNT) return;
+  pinModes[pin] = mode;
+  if ((mode & PULLUP) == PULLUP) pinLevels[pin] = HIGH;
+  else if ((mode & PULLDOWN) == PULLDOWN) pinLevels[pin] = LOW;
+}
+
+extern "C" void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin >= NATIVE_GPIO_COUNT) return;
+  pinLevels[pin] = val ? HIGH : LOW;
+}
+
+extern "C" int digitalRead(uint8_t pin) {
+  if (pin >= NATIVE_GPIO_COUNT) return LOW;
+  return pinLevels[pin];
+}
+
+extern "C" int analogRead(uint8_t pin) {
+  (void)pin;
+  return 0;
+}
+
+extern "C" void attachInterrupt(uint8_t pin, voidFuncPtr handler, int mode) {
+  if (pin >= NATIVE_GPIO_COUNT) return;
+  pinHandlers[pin] = handler;
+  pinHandlerModes[pin] = mode;
+}
+
+extern "C" void detachInterrupt(uint8_t pin) {
+  if (pin >= NATIVE_GPIO_COUNT) return;
+  pinHandlers[pin] = NULL;
+}
+
+void nativeSetPin(uint8_t pin, uint8_t val) {
+  if (pin >= NATIVE_GPIO_COUNT) return;
+  uint8_t old = pinLevels[pin];
+  val = val ? HIGH : LOW;
+  pinLevels[pin] = val;
+  if (old == val || !pinHandlers[pin]) return;
+  int mode = pinHandlerModes[pin];
+  if (mode == CHANGE || (mode == RISING && val == HIGH) || (mode == FALLING && val == LOW)) {
+    // interrupts are serialised against each other like on a single core
+    portENTER_CRITICAL(&gpioMux);
+    pinHandlers[pin]();
+    portEXIT_CRITICAL(&gpioMux);
+  }
+}
+
+// ----------------------------------------------------------------
+//                          -misc
+// ----------------------------------------------------------------
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return ::random() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) srandom(seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long dividend = out_max - out_min;
+  const long divisor = in_max - in_min;
+  const long delta = x - in_min;
+  if (divisor == 0) return -1;
+  return (delta * dividend + (divisor / 2)) / divisor + out_min;
+}
+
+uint16_t makeWord(uint16_t w) {
+  return w;
+}
+
+uint16_t makeWord(uint8_t h, uint8_t l) {
+  return (h << 8) | l;
+}
+
+extern "C" bool psramFound(void) {
+  return false;     // esp32dev modules have no PSRAM
+}
+
+extern "C" void ets_printf(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+}
+
+// ----------------------------------------------------------------
+//                          -EspClass
+// ----------------------------------------------------------------
+
+// the board has ~320 KB of DRAM; report what the host allocator has handed out against that
+static const uint32_t nativeHeapSize = 320 * 1024;
+
+uint32_t EspClass::getHeapSize() {
+  return nativeHeapSize;
+}
+
+uint32_t EspClass::getFreeHeap() {
+  struct mallinfo2 mi = mallinfo2();
+  return (mi.uordblks >= nativeHeapSize) ? 0 : nativeHeapSize - (uint32_t)mi.uordblks;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+  return getFreeHeap();
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+  return getFreeHeap();
+}
+
+uint32_t EspClass::getCycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+  return (uint32_t)__rdtsc();
+#else
+  return (uint32_t)(elapsedMicros() * 240);   // nominal 240 MHz core clock
+#endif
+}
+
+void EspClass::restart() {
+  fflush(stdout);
+  _exit(0);
+}
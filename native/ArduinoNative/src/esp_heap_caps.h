@@ -0,0 +1,35 @@
+/*
+  esp_heap_caps.h - host stand-in for the ESP-IDF capability-based allocator
+
+  Every request for internal memory is served by malloc.  There is no PSRAM
+  (see psramFound()), so MALLOC_CAP_SPIRAM requests fail like they do on an
+  esp32dev board and callers exercise their fallback path.
+*/
+
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC         (1 << 0)
+#define MALLOC_CAP_32BIT        (1 << 1)
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_DEFAULT      (1 << 12)
+
+static inline void *heap_caps_malloc(size_t size, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? NULL : malloc(size);
+}
+
+static inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? NULL : calloc(n, size);
+}
+
+static inline void heap_caps_free(void *ptr) {
+  free(ptr);
+}
+
+#endif
@@ -0,0 +1,419 @@
+/*
+  freertos.cpp - host stand-in for the FreeRTOS kernel
+
+  Enough of the kernel for the code in this project: tasks are detached
+  std::threads, notifications/semaphores/queues are built from one mutex and
+  one condition variable each.  Blocking calls honour their tick timeout
+  (1 tick = 1 ms) so timing-sensitive code behaves like it does on the board.
+*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+struct NativeTask {
+  std::string name;
+  TaskFunction_t fn;
+  void *param;
+  BaseType_t core;
+  std::mutex mtx;
+  std::condition_variable cv;
+  uint32_t notifyValue;
+  bool notifyPending;
+};
+
+struct NativeQueue {
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::vector<uint8_t> storage;
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  UBaseType_t head;
+  UBaseType_t count;
+};
+
+struct NativeSemaphore {
+  std::mutex mtx;
+  std::condition_variable cv;
+  UBaseType_t count;
+  UBaseType_t maxCount;
+  bool isMutex;
+  TaskHandle_t holder;
+  UBaseType_t recursion;
+};
+
+static std::recursive_mutex criticalMutex;
+static std::mutex suspendMutex;
+
+static thread_local NativeTask *currentTask = NULL;
+
+// ----------------------------------------------------------------
+//                          -helpers
+// ----------------------------------------------------------------
+
+typedef std::chrono::steady_clock nativeClock;
+
+static nativeClock::time_point deadlineFor(TickType_t ticks) {
+  return nativeClock::now() + std::chrono::milliseconds(ticks);
+}
+
+// wait on cv until pred() holds or the tick timeout expires
+template <typename Pred>
+static bool waitFor(std::condition_variable &cv, std::unique_lock<std::mutex> &lk, TickType_t ticks, Pred pred) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lk, pred);
+    return true;
+  }
+  return cv.wait_until(lk, deadlineFor(ticks), pred);
+}
+
+static NativeTask *selfTask() {
+  if (!currentTask) {
+    // adopt a thread that was not started by xTaskCreate (e.g. main/loopTask)
+    currentTask = new NativeTask();
+    currentTask->name = "loopTask";
+    currentTask->fn = NULL;
+    currentTask->param = NULL;
+    currentTask->core = 1;
+    currentTask->notifyValue = 0;
+    currentTask->notifyPending = false;
+  }
+  return currentTask;
+}
+
+extern "C" void *nativeCurrentTask(void) {
+  return selfTask();
+}
+
+// ----------------------------------------------------------------
+//                          -critical sections
+// ----------------------------------------------------------------
+
+extern "C" void vPortEnterCritical(portMUX_TYPE *mux) {
+  criticalMutex.lock();
+  mux->count++;
+}
+
+extern "C" void vPortExitCritical(portMUX_TYPE *mux) {
+  mux->count--;
+  criticalMutex.unlock();
+}
+
+extern "C" BaseType_t xPortGetCoreID(void) {
+  return selfTask()->core;
+}
+
+// ----------------------------------------------------------------
+//                          -tasks
+// ----------------------------------------------------------------
+
+extern "C" BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth,
+                                              void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pvCreatedTask,
+                                              const BaseType_t xCoreID) {
+  (void)usStackDepth;
+  (void)uxPriority;
+  NativeTask *t = new NativeTask();
+  t->name = pcName ? pcName : "";
+  t->fn = pvTaskCode;
+  t->param = pvParameters;
+  t->core = (xCoreID == tskNO_AFFINITY) ? 0 : xCoreID;
+  t->notifyValue = 0;
+  t->notifyPending = false;
+  if (pvCreatedTask) *pvCreatedTask = t;
+  std::thread([t]() {
+    currentTask = t;
+    pthread_setname_np(pthread_self(), t->name.substr(0, 15).c_str());
+    t->fn(t->param);
+  }).detach();
+  return pdPASS;
+}
+
+extern "C" BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth,
+                                  void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pvCreatedTask) {
+  return xTaskCreatePinnedToCore(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pvCreatedTask, tskNO_AFFINITY);
+}
+
+extern "C" void vTaskDelete(TaskHandle_t xTaskToDelete) {
+  // threads cannot be killed from outside; deleting the calling task ends its thread
+  if (xTaskToDelete == NULL || xTaskToDelete == currentTask) {
+    pthread_exit(NULL);
+  }
+}
+
+extern "C" void vTaskDelay(const TickType_t xTicksToDelay) {
+  if (xTicksToDelay == 0) {
+    sched_yield();
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+}
+
+extern "C" void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement) {
+  *pxPreviousWakeTime += xTimeIncrement;
+  TickType_t now = xTaskGetTickCount();
+  int32_t remaining = (int32_t)(*pxPreviousWakeTime - now);
+  if (remaining > 0) vTaskDelay((TickType_t)remaining);
+}
+
+extern "C" TickType_t xTaskGetTickCount(void) {
+  return (TickType_t)millis();
+}
+
+extern "C" TickType_t xTaskGetTickCountFromISR(void) {
+  return (TickType_t)millis();
+}
+
+extern "C" TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+  return selfTask();
+}
+
+extern "C" const char *pcTaskGetTaskName(TaskHandle_t xTaskToQuery) {
+  NativeTask *t = xTaskToQuery ? xTaskToQuery : selfTask();
+  return t->name.c_str();
+}
+
+extern "C" UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+  (void)xTask;
+  return 0;
+}
+
+extern "C" void vTaskSuspendAll(void) {
+  suspendMutex.lock();
+}
+
+extern "C" BaseType_t xTaskResumeAll(void) {
+  suspendMutex.unlock();
+  return pdFALSE;
+}
+
+extern "C" void taskYIELD(void) {
+  sched_yield();
+}
+
+// ----------------------------------------------------------------
+//                          -notifications
+// ----------------------------------------------------------------
+
+extern "C" BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue) {
+  NativeTask *t = xTaskToNotify;
+  if (!t) return pdFAIL;
+  BaseType_t ret = pdPASS;
+  {
+    std::lock_guard<std::mutex> lk(t->mtx);
+    if (pulPreviousNotificationValue) *pulPreviousNotificationValue = t->notifyValue;
+    switch (eAction) {
+      case eSetBits:                  t->notifyValue |= ulValue; break;
+      case eIncrement:                t->notifyValue++; break;
+      case eSetValueWithOverwrite:    t->notifyValue = ulValue; break;
+      case eSetValueWithoutOverwrite:
+        if (t->notifyPending) ret = pdFAIL;
+        else t->notifyValue = ulValue;
+        break;
+      case eNoAction:                 break;
+    }
+    t->notifyPending = true;
+  }
+  t->cv.notify_all();
+  return ret;
+}
+
+extern "C" BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait) {
+  NativeTask *t = selfTask();
+  std::unique_lock<std::mutex> lk(t->mtx);
+  if (!t->notifyPending) t->notifyValue &= ~ulBitsToClearOnEntry;
+  bool got = waitFor(t->cv, lk, xTicksToWait, [t]() { return t->notifyPending; });
+  if (pulNotificationValue) *pulNotificationValue = t->notifyValue;
+  if (!got) return pdFALSE;
+  t->notifyValue &= ~ulBitsToClearOnExit;
+  t->notifyPending = false;
+  return pdTRUE;
+}
+
+extern "C" uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+  NativeTask *t = selfTask();
+  std::unique_lock<std::mutex> lk(t->mtx);
+  waitFor(t->cv, lk, xTicksToWait, [t]() { return t->notifyValue != 0; });
+  uint32_t value = t->notifyValue;
+  if (value) {
+    t->notifyValue = xClearCountOnExit ? 0 : value - 1;
+  }
+  t->notifyPending = false;
+  return value;
+}
+
+// ----------------------------------------------------------------
+//                          -queues
+// ----------------------------------------------------------------
+
+extern "C" QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+  if (uxQueueLength == 0) return NULL;
+  NativeQueue *q = new NativeQueue();
+  q->length = uxQueueLength;
+  q->itemSize = uxItemSize;
+  q->head = 0;
+  q->count = 0;
+  q->storage.resize((size_t)uxQueueLength * uxItemSize);
+  return q;
+}
+
+extern "C" void vQueueDelete(QueueHandle_t xQueue) {
+  delete xQueue;
+}
+
+extern "C" BaseType_t xQueueGenericSend(QueueHandle_t q, const void * const pvItemToQueue, TickType_t xTicksToWait, BaseType_t xFront, BaseType_t xOverwrite) {
+  std::unique_lock<std::mutex> lk(q->mtx);
+  if (xOverwrite && q->count == q->length) {
+    // only meaningful for length-1 queues: replace the item in place
+    memcpy(&q->storage[(size_t)q->head * q->itemSize], pvItemToQueue, q->itemSize);
+    lk.unlock();
+    q->cv.notify_all();
+    return pdPASS;
+  }
+  if (!waitFor(q->cv, lk, xTicksToWait, [q]() { return q->count < q->length; })) return errQUEUE_FULL;
+  UBaseType_t slot;
+  if (xFront) {
+    q->head = (q->head + q->length - 1) % q->length;
+    slot = q->head;
+  } else {
+    slot = (q->head + q->count) % q->length;
+  }
+  memcpy(&q->storage[(size_t)slot * q->itemSize], pvItemToQueue, q->itemSize);
+  q->count++;
+  lk.unlock();
+  q->cv.notify_all();
+  return pdPASS;
+}
+
+static BaseType_t queueTake(QueueHandle_t q, void * const pvBuffer, TickType_t xTicksToWait, bool remove) {
+  std::unique_lock<std::mutex> lk(q->mtx);
+  if (!waitFor(q->cv, lk, xTicksToWait, [q]() { return q->count > 0; })) return errQUEUE_EMPTY;
+  memcpy(pvBuffer, &q->storage[(size_t)q->head * q->itemSize], q->itemSize);
+  if (remove) {
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    lk.unlock();
+    q->cv.notify_all();
+  }
+  return pdPASS;
+}
+
+extern "C" BaseType_t xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait) {
+  return queueTake(xQueue, pvBuffer, xTicksToWait, true);
+}
+
+extern "C" BaseType_t xQueuePeek(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait) {
+  return queueTake(xQueue, pvBuffer, xTicksToWait, false);
+}
+
+extern "C" UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue) {
+  std::lock_guard<std::mutex> lk(xQueue->mtx);
+  return xQueue->count;
+}
+
+extern "C" UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t xQueue) {
+  std::lock_guard<std::mutex> lk(xQueue->mtx);
+  return xQueue->length - xQueue->count;
+}
+
+extern "C" BaseType_t xQueueReset(QueueHandle_t xQueue) {
+  {
+    std::lock_guard<std::mutex> lk(xQueue->mtx);
+    xQueue->head = 0;
+    xQueue->count = 0;
+  }
+  xQueue->cv.notify_all();
+  return pdPASS;
+}
+
+// ----------------------------------------------------------------
+//                          -semaphores
+// ----------------------------------------------------------------
+
+static NativeSemaphore *newSemaphore(UBaseType_t maxCount, UBaseType_t initial, bool isMutex) {
+  NativeSemaphore *s = new NativeSemaphore();
+  s->count = initial;
+  s->maxCount = maxCount;
+  s->isMutex = isMutex;
+  s->holder = NULL;
+  s->recursion = 0;
+  return s;
+}
+
+extern "C" SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+  return newSemaphore(uxMaxCount, uxInitialCount, false);
+}
+
+extern "C" SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  return newSemaphore(1, 1, true);
+}
+
+extern "C" SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) {
+  return newSemaphore(1, 1, true);
+}
+
+extern "C" void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+  delete xSemaphore;
+}
+
+extern "C" BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t xBlockTime) {
+  std::unique_lock<std::mutex> lk(s->mtx);
+  if (!waitFor(s->cv, lk, xBlockTime, [s]() { return s->count > 0; })) return pdFALSE;
+  s->count--;
+  if (s->isMutex) s->holder = selfTask();
+  return pdTRUE;
+}
+
+extern "C" BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  {
+    std::lock_guard<std::mutex> lk(s->mtx);
+    if (s->count >= s->maxCount) return pdFALSE;
+    s->count++;
+    s->holder = NULL;
+  }
+  s->cv.notify_one();
+  return pdTRUE;
+}
+
+extern "C" BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t xBlockTime) {
+  TaskHandle_t self = selfTask();
+  std::unique_lock<std::mutex> lk(s->mtx);
+  if (s->holder == self) {
+    s->recursion++;
+    return pdTRUE;
+  }
+  if (!waitFor(s->cv, lk, xBlockTime, [s]() { return s->count > 0; })) return pdFALSE;
+  s->count--;
+  s->holder = self;
+  s->recursion = 1;
+  return pdTRUE;
+}
+
+extern "C" BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) {
+  {
+    std::lock_guard<std::mutex> lk(s->mtx);
+    if (s->holder != selfTask()) return pdFALSE;
+    if (--s->recursion > 0) return pdTRUE;
+    s->holder = NULL;
+    s->count++;
+  }
+  s->cv.notify_one();
+  return pdTRUE;
+}
+
+extern "C" UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t s) {
+  std::lock_guard<std::mutex> lk(s->mtx);
+  return s->count;
+}
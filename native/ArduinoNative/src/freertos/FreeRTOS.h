@@ -0,0 +1,64 @@
+/*
+  freertos/FreeRTOS.h - host stand-in for the FreeRTOS kernel types
+
+  Tasks map onto POSIX threads, semaphores and queues onto mutex/condition
+  variable pairs.  Priorities and core affinity are accepted and ignored.
+  One tick is one millisecond, as with the ESP32 Arduino default.
+*/
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t StackType_t;
+
+#define portMAX_DELAY           ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS      ((TickType_t)1)
+#define portTICK_RATE_MS        portTICK_PERIOD_MS
+#define configTICK_RATE_HZ      1000
+#define portNUM_PROCESSORS      2
+#define configMAX_PRIORITIES    25
+#define tskNO_AFFINITY          0x7FFFFFFF
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(xTimeInMs))
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  (pdTRUE)
+#define pdFAIL                  (pdFALSE)
+#define errQUEUE_EMPTY          ((BaseType_t)0)
+#define errQUEUE_FULL           ((BaseType_t)0)
+
+typedef struct {
+  volatile uint32_t owner;
+  volatile uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED  { 0, 0 }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+BaseType_t xPortGetCoreID(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define portENTER_CRITICAL(mux)       vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)        vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)   vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)    vPortExitCritical(mux)
+#define taskENTER_CRITICAL(mux)       vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux)        vPortExitCritical(mux)
+#define portYIELD_FROM_ISR()          do { } while (0)
+#define portYIELD()                   taskYIELD()
+
+#endif
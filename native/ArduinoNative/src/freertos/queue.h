@@ -0,0 +1,39 @@
+/*
+  freertos/queue.h - host stand-in for the FreeRTOS queue API
+*/
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct NativeQueue * QueueHandle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+void vQueueDelete(QueueHandle_t xQueue);
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, BaseType_t xFront, BaseType_t xOverwrite);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue);
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t xQueue);
+BaseType_t xQueueReset(QueueHandle_t xQueue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define xQueueSend(q, item, ticks)                 xQueueGenericSend((q), (item), (ticks), pdFALSE, pdFALSE)
+#define xQueueSendToBack(q, item, ticks)           xQueueGenericSend((q), (item), (ticks), pdFALSE, pdFALSE)
+#define xQueueSendToFront(q, item, ticks)          xQueueGenericSend((q), (item), (ticks), pdTRUE, pdFALSE)
+#define xQueueOverwrite(q, item)                   xQueueGenericSend((q), (item), 0, pdFALSE, pdTRUE)
+#define xQueueSendFromISR(q, item, woken)          xQueueGenericSend((q), (item), 0, pdFALSE, pdFALSE)
+#define xQueueSendToBackFromISR(q, item, woken)    xQueueGenericSend((q), (item), 0, pdFALSE, pdFALSE)
+#define xQueueSendToFrontFromISR(q, item, woken)   xQueueGenericSend((q), (item), 0, pdTRUE, pdFALSE)
+#define xQueueOverwriteFromISR(q, item, woken)     xQueueGenericSend((q), (item), 0, pdFALSE, pdTRUE)
+#define xQueueReceiveFromISR(q, buf, woken)        xQueueReceive((q), (buf), 0)
+
+#endif
@@ -0,0 +1,35 @@
+/*
+  freertos/semphr.h - host stand-in for the FreeRTOS semaphore API
+*/
+
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+typedef struct NativeSemaphore * SemaphoreHandle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t xMutex, TickType_t xBlockTime);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t xMutex);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define xSemaphoreCreateBinary()                    xSemaphoreCreateCounting(1, 0)
+#define xSemaphoreGiveFromISR(sem, woken)           xSemaphoreGive(sem)
+#define xSemaphoreTakeFromISR(sem, woken)           xSemaphoreTake((sem), 0)
+
+#endif
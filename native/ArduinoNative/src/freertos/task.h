@@ -0,0 +1,63 @@
+/*
+  freertos/task.h - host stand-in for the FreeRTOS task API
+*/
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+typedef struct NativeTask * TaskHandle_t;
+
+typedef enum {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite
+} eNotifyAction;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth,
+                                   void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pvCreatedTask,
+                                   const BaseType_t xCoreID);
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth,
+                       void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pvCreatedTask);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+void vTaskDelay(const TickType_t xTicksToDelay);
+void vTaskDelayUntil(TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+const char *pcTaskGetTaskName(TaskHandle_t xTaskToQuery);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+void taskYIELD(void);
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue);
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+// AsyncWebLock compares against the running task's TCB; on the host every
+// thread is its own task so re-entrancy detection keeps working.  The lock
+// declares "extern void *pxCurrentTCB;" before using it, which with the
+// macro below declares this function again.
+void *nativeCurrentTask(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define pxCurrentTCB nativeCurrentTask()
+
+#define xTaskNotify(xTaskToNotify, ulValue, eAction) xTaskGenericNotify((xTaskToNotify), (ulValue), (eAction), NULL)
+#define xTaskNotifyGive(xTaskToNotify) xTaskGenericNotify((xTaskToNotify), 0, eIncrement, NULL)
+#define xTaskNotifyFromISR(xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken) xTaskGenericNotify((xTaskToNotify), (ulValue), (eAction), NULL)
+#define vTaskNotifyGiveFromISR(xTaskToNotify, pxHigherPriorityTaskWoken) ((void)xTaskGenericNotify((xTaskToNotify), 0, eIncrement, NULL))
+
+#endif
@@ -0,0 +1,161 @@
+/*
+  i2s.cpp - host stand-in for the ESP-IDF legacy I2S driver
+*/
+
+#include <mutex>
+
+#include "Arduino.h"
+#include "driver/i2s.h"
+
+struct NativeI2S {
+    bool installed;
+    bool running;
+    i2s_config_t config;
+    uint32_t frameBytes;
+    uint64_t written;           // bytes accepted since install
+    uint64_t playStartMicros;   // time the first sample of the current run started playing
+    uint64_t playedBase;        // bytes already played when the current run started
+};
+
+static NativeI2S ports[I2S_NUM_MAX];
+static std::mutex i2sMutex;
+static I2SWriteObserver observer;
+static bool realtime = true;
+
+static uint32_t frameBytesFor(i2s_bits_per_sample_t bits) {
+    return 2 * (((uint32_t)bits + 15) / 16) * 2;    // stereo, 16 or 32 bit slots
+}
+
+// bytes the simulated DMA engine has consumed by now
+static uint64_t playedBytes(NativeI2S &p) {
+    if (!p.running) return p.playedBase;
+    uint64_t now = (uint64_t)micros();
+    uint64_t us = now - p.playStartMicros;
+    uint64_t played = p.playedBase + us * p.config.sample_rate / 1000000ULL * p.frameBytes;
+    if (played < p.written) return played;
+    // ran dry: the DMA plays silence, which does not make room for later writes
+    p.playedBase = p.written;
+    p.playStartMicros = now;
+    return p.written;
+}
+
+esp_err_t i2s_driver_install(i2s_port_t i2s_num, const i2s_config_t *i2s_config, int queue_size, void *i2s_queue) {
+    (void)queue_size;
+    (void)i2s_queue;
+    if (i2s_num >= I2S_NUM_MAX || !i2s_config) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    NativeI2S &p = ports[i2s_num];
+    p.installed = true;
+    p.running = true;
+    p.config = *i2s_config;
+    p.frameBytes = frameBytesFor(i2s_config->bits_per_sample);
+    p.written = 0;
+    p.playedBase = 0;
+    p.playStartMicros = micros();
+    return ESP_OK;
+}
+
+esp_err_t i2s_driver_uninstall(i2s_port_t i2s_num) {
+    if (i2s_num >= I2S_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    ports[i2s_num].installed = false;
+    ports[i2s_num].running = false;
+    return ESP_OK;
+}
+
+esp_err_t i2s_set_pin(i2s_port_t i2s_num, const i2s_pin_config_t *pin) {
+    (void)pin;
+    return (i2s_num < I2S_NUM_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t i2s_set_clk(i2s_port_t i2s_num, uint32_t rate, i2s_bits_per_sample_t bits, i2s_channel_t ch) {
+    (void)ch;
+    if (i2s_num >= I2S_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    NativeI2S &p = ports[i2s_num];
+    if (!p.installed) return ESP_ERR_INVALID_STATE;
+    // drain what is queued, then restart the clock at the new rate
+    p.playedBase = p.written;
+    p.playStartMicros = micros();
+    p.config.sample_rate = rate;
+    p.config.bits_per_sample = bits;
+    p.frameBytes = frameBytesFor(bits);
+    return ESP_OK;
+}
+
+esp_err_t i2s_set_sample_rates(i2s_port_t i2s_num, uint32_t rate) {
+    if (i2s_num >= I2S_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    return i2s_set_clk(i2s_num, rate, ports[i2s_num].config.bits_per_sample, I2S_CHANNEL_STEREO);
+}
+
+esp_err_t i2s_start(i2s_port_t i2s_num) {
+    if (i2s_num >= I2S_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    NativeI2S &p = ports[i2s_num];
+    if (!p.installed) return ESP_ERR_INVALID_STATE;
+    if (!p.running) {
+        p.running = true;
+        p.playedBase = p.written;
+        p.playStartMicros = micros();
+    }
+    return ESP_OK;
+}
+
+esp_err_t i2s_stop(i2s_port_t i2s_num) {
+    if (i2s_num >= I2S_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    NativeI2S &p = ports[i2s_num];
+    if (!p.installed) return ESP_ERR_INVALID_STATE;
+    p.playedBase = p.written;       // stopping discards whatever is still in DMA
+    p.running = false;
+    return ESP_OK;
+}
+
+esp_err_t i2s_zero_dma_buffer(i2s_port_t i2s_num) {
+    return (i2s_num < I2S_NUM_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t i2s_write(i2s_port_t i2s_num, const void *src, size_t size, size_t *bytes_written, TickType_t ticks_to_wait) {
+    if (i2s_num >= I2S_NUM_MAX) return ESP_ERR_INVALID_ARG;
+    NativeI2S &p = ports[i2s_num];
+    if (!p.installed) return ESP_ERR_INVALID_STATE;
+    uint64_t capacity = (uint64_t)p.config.dma_buf_count * p.config.dma_buf_len * p.frameBytes;
+    uint32_t deadline = millis() + ticks_to_wait;
+    size_t done = 0;
+    while (done < size) {
+        size_t chunk = size - done;
+        {
+            std::lock_guard<std::mutex> lk(i2sMutex);
+            if (realtime && p.running) {
+                uint64_t queued = p.written - playedBytes(p);
+                uint64_t space = (queued >= capacity) ? 0 : capacity - queued;
+                if (chunk > space) chunk = (size_t)space;
+            }
+            if (chunk) {
+                p.written += chunk;
+                if (observer) observer(i2s_num, (const uint8_t *)src + done, chunk);
+                done += chunk;
+                continue;
+            }
+        }
+        if (ticks_to_wait != portMAX_DELAY && (int32_t)(millis() - deadline) >= 0) break;
+        delayMicroseconds(500);
+    }
+    if (bytes_written) *bytes_written = done;
+    return ESP_OK;
+}
+
+void i2s_native_set_observer(I2SWriteObserver o) {
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    observer = o;
+}
+
+void i2s_native_set_realtime(bool enable) {
+    realtime = enable;
+}
+
+uint64_t i2s_native_bytes_written(i2s_port_t i2s_num) {
+    if (i2s_num >= I2S_NUM_MAX) return 0;
+    std::lock_guard<std::mutex> lk(i2sMutex);
+    return ports[i2s_num].written;
+}
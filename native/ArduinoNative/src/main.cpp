@@ -0,0 +1,49 @@
+/*
+  main.cpp - host entry point: setup() once, then loop() until stopped
+
+  Only linked when the program does not bring its own main(), so benchmark
+  binaries can drive setup()/loop() themselves.
+
+  ESP_NATIVE_RUN_MS=<n> stops after n milliseconds and prints how many loop()
+  passes ran, which makes the idle cost of the main loop directly comparable
+  between builds.
+*/
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "Arduino.h"
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) {
+  stopRequested = 1;
+}
+
+int main(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  const char *runEnv = getenv("ESP_NATIVE_RUN_MS");
+  unsigned long runMs = runEnv ? strtoul(runEnv, NULL, 10) : 0;
+
+  setup();
+  unsigned long started = millis();
+  unsigned long long loops = 0;
+  while (!stopRequested) {
+    loop();
+    loops++;
+    if (runMs && millis() - started >= runMs) break;
+  }
+  unsigned long elapsed = millis() - started;
+  fflush(stdout);
+  fprintf(stderr, "\n[native] %llu loop() passes in %lu ms (%.1f us/pass)\n",
+          loops, elapsed, loops ? elapsed * 1000.0 / loops : 0.0);
+  // other tasks (async_tcp, a2dp) are still running; skip static destructors
+  // like a reset on the board would
+  fflush(stderr);
+  _exit(0);
+}
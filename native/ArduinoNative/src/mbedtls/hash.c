@@ -0,0 +1,231 @@
+/*
+  hash.c - host stand-in for the mbedTLS SHA-1 and MD5 digests (RFC 3174, RFC 1321)
+*/
+
+#include <string.h>
+
+#include "sha1.h"
+#include "md5.h"
+
+#define ROL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/* ---------------------------------------------------------------- */
+/*                            -SHA-1                                 */
+/* ---------------------------------------------------------------- */
+
+static void sha1_process(mbedtls_sha1_context *ctx, const unsigned char data[64])
+{
+    uint32_t w[80], a, b, c, d, e, f, k, t;
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)data[i * 4] << 24) | ((uint32_t)data[i * 4 + 1] << 16) |
+               ((uint32_t)data[i * 4 + 2] << 8) | (uint32_t)data[i * 4 + 3];
+    }
+    for (i = 16; i < 80; i++) {
+        w[i] = ROL(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    a = ctx->state[0]; b = ctx->state[1]; c = ctx->state[2]; d = ctx->state[3]; e = ctx->state[4];
+
+    for (i = 0; i < 80; i++) {
+        if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+        else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+        else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+        else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+        t = ROL(a, 5) + f + e + k + w[i];
+        e = d; d = c; c = ROL(b, 30); b = a; a = t;
+    }
+
+    ctx->state[0] += a; ctx->state[1] += b; ctx->state[2] += c; ctx->state[3] += d; ctx->state[4] += e;
+}
+
+void mbedtls_sha1_init(mbedtls_sha1_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha1_free(mbedtls_sha1_context *ctx)
+{
+    if (ctx) memset(ctx, 0, sizeof(*ctx));
+}
+
+int mbedtls_sha1_starts_ret(mbedtls_sha1_context *ctx)
+{
+    ctx->total[0] = ctx->total[1] = 0;
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xEFCDAB89;
+    ctx->state[2] = 0x98BADCFE;
+    ctx->state[3] = 0x10325476;
+    ctx->state[4] = 0xC3D2E1F0;
+    return 0;
+}
+
+int mbedtls_sha1_update_ret(mbedtls_sha1_context *ctx, const unsigned char *input, size_t ilen)
+{
+    size_t left = ctx->total[0] & 0x3F;
+    size_t fill = 64 - left;
+
+    ctx->total[0] += (uint32_t)ilen;
+    if (ctx->total[0] < (uint32_t)ilen) ctx->total[1]++;
+
+    if (left && ilen >= fill) {
+        memcpy(ctx->buffer + left, input, fill);
+        sha1_process(ctx, ctx->buffer);
+        input += fill;
+        ilen -= fill;
+        left = 0;
+    }
+    while (ilen >= 64) {
+        sha1_process(ctx, input);
+        input += 64;
+        ilen -= 64;
+    }
+    if (ilen > 0) memcpy(ctx->buffer + left, input, ilen);
+    return 0;
+}
+
+int mbedtls_sha1_finish_ret(mbedtls_sha1_context *ctx, unsigned char output[20])
+{
+    static const unsigned char padding[64] = { 0x80 };
+    unsigned char msglen[8];
+    uint32_t high = (ctx->total[0] >> 29) | (ctx->total[1] << 3);
+    uint32_t low = ctx->total[0] << 3;
+    size_t last, padn;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        msglen[i] = (unsigned char)(high >> (24 - 8 * i));
+        msglen[i + 4] = (unsigned char)(low >> (24 - 8 * i));
+    }
+    last = ctx->total[0] & 0x3F;
+    padn = (last < 56) ? (56 - last) : (120 - last);
+    mbedtls_sha1_update_ret(ctx, padding, padn);
+    mbedtls_sha1_update_ret(ctx, msglen, 8);
+
+    for (i = 0; i < 5; i++) {
+        output[i * 4]     = (unsigned char)(ctx->state[i] >> 24);
+        output[i * 4 + 1] = (unsigned char)(ctx->state[i] >> 16);
+        output[i * 4 + 2] = (unsigned char)(ctx->state[i] >> 8);
+        output[i * 4 + 3] = (unsigned char)(ctx->state[i]);
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------- */
+/*                            -MD5                                   */
+/* ---------------------------------------------------------------- */
+
+static const uint32_t md5_k[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static const unsigned char md5_r[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+static void md5_process(mbedtls_md5_context *ctx, const unsigned char data[64])
+{
+    uint32_t w[16], a, b, c, d, f, t;
+    int i, g;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = (uint32_t)data[i * 4] | ((uint32_t)data[i * 4 + 1] << 8) |
+               ((uint32_t)data[i * 4 + 2] << 16) | ((uint32_t)data[i * 4 + 3] << 24);
+    }
+
+    a = ctx->state[0]; b = ctx->state[1]; c = ctx->state[2]; d = ctx->state[3];
+
+    for (i = 0; i < 64; i++) {
+        if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+        else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) & 15; }
+        else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) & 15; }
+        else             { f = c ^ (b | ~d);       g = (7 * i) & 15; }
+        t = d; d = c; c = b;
+        b = b + ROL(a + f + md5_k[i] + w[g], md5_r[i]);
+        a = t;
+    }
+
+    ctx->state[0] += a; ctx->state[1] += b; ctx->state[2] += c; ctx->state[3] += d;
+}
+
+void mbedtls_md5_init(mbedtls_md5_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_md5_free(mbedtls_md5_context *ctx)
+{
+    if (ctx) memset(ctx, 0, sizeof(*ctx));
+}
+
+int mbedtls_md5_starts_ret(mbedtls_md5_context *ctx)
+{
+    ctx->total[0] = ctx->total[1] = 0;
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xEFCDAB89;
+    ctx->state[2] = 0x98BADCFE;
+    ctx->state[3] = 0x10325476;
+    return 0;
+}
+
+int mbedtls_md5_update_ret(mbedtls_md5_context *ctx, const unsigned char *input, size_t ilen)
+{
+    size_t left = ctx->total[0] & 0x3F;
+    size_t fill = 64 - left;
+
+    ctx->total[0] += (uint32_t)ilen;
+    if (ctx->total[0] < (uint32_t)ilen) ctx->total[1]++;
+
+    if (left && ilen >= fill) {
+        memcpy(ctx->buffer + left, input, fill);
+        md5_process(ctx, ctx->buffer);
+        input += fill;
+        ilen -= fill;
+        left = 0;
+    }
+    while (ilen >= 64) {
+        md5_process(ctx, input);
+        input += 64;
+        ilen -= 64;
+    }
+    if (ilen > 0) memcpy(ctx->buffer + left, input, ilen);
+    return 0;
+}
+
+int mbedtls_md5_finish_ret(mbedtls_md5_context *ctx, unsigned char output[16])
+{
+    static const unsigned char padding[64] = { 0x80 };
+    unsigned char msglen[8];
+    uint32_t high = (ctx->total[0] >> 29) | (ctx->total[1] << 3);
+    uint32_t low = ctx->total[0] << 3;
+    size_t last, padn;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        msglen[i] = (unsigned char)(low >> (8 * i));
+        msglen[i + 4] = (unsigned char)(high >> (8 * i));
+    }
+    last = ctx->total[0] & 0x3F;
+    padn = (last < 56) ? (56 - last) : (120 - last);
+    mbedtls_md5_update_ret(ctx, padding, padn);
+    mbedtls_md5_update_ret(ctx, msglen, 8);
+
+    for (i = 0; i < 4; i++) {
+        output[i * 4]     = (unsigned char)(ctx->state[i]);
+        output[i * 4 + 1] = (unsigned char)(ctx->state[i] >> 8);
+        output[i * 4 + 2] = (unsigned char)(ctx->state[i] >> 16);
+        output[i * 4 + 3] = (unsigned char)(ctx->state[i] >> 24);
+    }
+    return 0;
+}
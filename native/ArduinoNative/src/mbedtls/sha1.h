@@ -0,0 +1,33 @@
+/*
+  mbedtls/sha1.h - host stand-in for the mbedTLS SHA-1 API bundled with ESP-IDF
+
+  Only the streaming *_ret calls used by AsyncWebSocket's handshake.
+*/
+
+#ifndef MBEDTLS_SHA1_H
+#define MBEDTLS_SHA1_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mbedtls_sha1_context {
+    uint32_t total[2];
+    uint32_t state[5];
+    unsigned char buffer[64];
+} mbedtls_sha1_context;
+
+void mbedtls_sha1_init(mbedtls_sha1_context *ctx);
+void mbedtls_sha1_free(mbedtls_sha1_context *ctx);
+int mbedtls_sha1_starts_ret(mbedtls_sha1_context *ctx);
+int mbedtls_sha1_update_ret(mbedtls_sha1_context *ctx, const unsigned char *input, size_t ilen);
+int mbedtls_sha1_finish_ret(mbedtls_sha1_context *ctx, unsigned char output[20]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,12 @@
+/*
+  sdkconfig.h - host stand-in for the ESP-IDF build configuration
+*/
+
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+#define CONFIG_FREERTOS_HZ 1000
+#define CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ 240
+#define CONFIG_ARDUINO_RUNNING_CORE 1
+
+#endif
@@ -0,0 +1,1001 @@
+/*
+  Asynchronous TCP library for Espressif MCUs - native (host) build
+
+  epoll backend.  Socket state (fd, tx queue, counters) is guarded by one
+  recursive lock that is never held while a user callback runs, so handlers
+  can take their own locks in any order, exactly as with the lwIP thread and
+  the async_tcp task on the board.
+*/
+
+#include "Arduino.h"
+#include "AsyncTCP.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/sockios.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+#include <map>
+#include <mutex>
+
+// lwIP error codes, so handlers see the same values as on the board
+enum {
+    ERR_OK = 0,
+    ERR_MEM = -1,
+    ERR_BUF = -2,
+    ERR_TIMEOUT = -3,
+    ERR_RTE = -4,
+    ERR_INPROGRESS = -5,
+    ERR_VAL = -6,
+    ERR_WOULDBLOCK = -7,
+    ERR_USE = -8,
+    ERR_ALREADY = -9,
+    ERR_ISCONN = -10,
+    ERR_CONN = -11,
+    ERR_IF = -12,
+    ERR_ABRT = -13,
+    ERR_RST = -14,
+    ERR_CLSD = -15,
+    ERR_ARG = -16
+};
+
+// lwIP tcp_state values used by state()
+enum {
+    TCP_STATE_CLOSED = 0,
+    TCP_STATE_LISTEN = 1,
+    TCP_STATE_SYN_SENT = 2,
+    TCP_STATE_ESTABLISHED = 4
+};
+
+#define ASYNC_TCP_POLL_INTERVAL 125     // ms, see onPoll()
+#define ASYNC_TCP_MAX_EVENTS 16
+
+/*
+ * TCP/IP Event Task
+ * */
+
+// never destroyed, and usable from other static constructors: the async task
+// and global AsyncServer/AsyncClient objects outlive static destruction
+static std::recursive_mutex & _async_lock(){
+    static std::recursive_mutex *lock = new std::recursive_mutex;
+    return *lock;
+}
+
+static std::map<uint32_t, AsyncClient *> & _clients(){
+    static std::map<uint32_t, AsyncClient *> *clients = new std::map<uint32_t, AsyncClient *>;
+    return *clients;
+}
+
+static std::map<uint32_t, AsyncServer *> & _servers(){
+    static std::map<uint32_t, AsyncServer *> *servers = new std::map<uint32_t, AsyncServer *>;
+    return *servers;
+}
+static uint32_t _next_id = 1;           // 0 is the wake-up eventfd
+static int _epoll_fd = -1;
+static int _wake_fd = -1;
+static TaskHandle_t _async_service_task_handle = NULL;
+
+typedef std::lock_guard<std::recursive_mutex> AsyncLock;
+
+static void _wake_service_task(){
+    uint64_t one = 1;
+    if(_wake_fd >= 0 && ::write(_wake_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        log_e("eventfd write failed: %d", errno);
+    }
+}
+
+static AsyncClient * _client_by_id(uint32_t id){
+    AsyncLock l(_async_lock());
+    auto it = _clients().find(id);
+    return (it == _clients().end()) ? NULL : it->second;
+}
+
+// the client may have been deleted by the callback that just returned
+static bool _client_alive(uint32_t id, AsyncClient *client){
+    return _client_by_id(id) == client;
+}
+
+static std::vector<uint32_t> _client_ids(){
+    AsyncLock l(_async_lock());
+    std::vector<uint32_t> ids;
+    ids.reserve(_clients().size());
+    for(auto &it : _clients()) {
+        ids.push_back(it.first);
+    }
+    return ids;
+}
+
+static bool _clients_waiting(){
+    AsyncLock l(_async_lock());
+    for(auto &it : _clients()) {
+        if(it.second->fd() >= 0 && it.second->space() < CONFIG_ASYNC_TCP_SND_BUF) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _async_service_task(void *pvParameters){
+    (void)pvParameters;
+    struct epoll_event events[ASYNC_TCP_MAX_EVENTS];
+    uint32_t lastPoll = millis();
+    for(;;){
+        uint32_t now = millis();
+        int timeout = (int)(ASYNC_TCP_POLL_INTERVAL - (now - lastPoll));
+        if(timeout < 0) {
+            timeout = 0;
+        }
+        // nothing tells epoll about acks, so look at the send queues often while data is in flight
+        if(timeout > 1 && _clients_waiting()) {
+            timeout = 1;
+        }
+        int n = epoll_wait(_epoll_fd, events, ASYNC_TCP_MAX_EVENTS, timeout);
+        if(n < 0 && errno != EINTR) {
+            log_e("epoll_wait failed: %d", errno);
+            vTaskDelay(10);
+            continue;
+        }
+        for(int i = 0; i < n; i++){
+            uint32_t id = (uint32_t)events[i].data.u64;
+            if(id == 0){
+                uint64_t count;
+                while(::read(_wake_fd, &count, sizeof(count)) > 0);
+                continue;
+            }
+            AsyncServer *server = NULL;
+            AsyncClient *client = NULL;
+            {
+                AsyncLock l(_async_lock());
+                auto s = _servers().find(id);
+                if(s != _servers().end()) {
+                    server = s->second;
+                } else {
+                    auto c = _clients().find(id);
+                    if(c != _clients().end()) {
+                        client = c->second;
+                    }
+                }
+            }
+            if(server) {
+                server->_accept();
+            } else if(client) {
+                client->_service(events[i].events);
+            }
+        }
+        std::vector<uint32_t> ids = _client_ids();
+        for(uint32_t id : ids){
+            AsyncClient *client = _client_by_id(id);
+            if(client) {
+                client->_checkSent();
+            }
+        }
+        now = millis();
+        if(now - lastPoll >= ASYNC_TCP_POLL_INTERVAL){
+            lastPoll = now;
+            for(uint32_t id : ids){
+                AsyncClient *client = _client_by_id(id);
+                if(client) {
+                    client->_poll(now);
+                }
+            }
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+static bool _start_async_task(){
+    AsyncLock l(_async_lock());
+    if(_async_service_task_handle) {
+        return true;
+    }
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    _wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(_epoll_fd < 0 || _wake_fd < 0) {
+        log_e("epoll setup failed: %d", errno);
+        return false;
+    }
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.u64 = 0;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &ev);
+    xTaskCreatePinnedToCore(_async_service_task, "async_tcp", 8192 * 2, NULL, 3, &_async_service_task_handle, CONFIG_ASYNC_TCP_RUNNING_CORE);
+    return _async_service_task_handle != NULL;
+}
+
+static int8_t _errno_to_err(int err){
+    switch(err){
+        case ECONNREFUSED:
+        case ECONNRESET: return ERR_RST;
+        case EPIPE: return ERR_CLSD;
+        case ETIMEDOUT: return ERR_TIMEOUT;
+        case EHOSTUNREACH:
+        case ENETUNREACH: return ERR_RTE;
+        case EADDRINUSE: return ERR_USE;
+        case ENOMEM:
+        case ENOBUFS: return ERR_MEM;
+        default: return ERR_ABRT;
+    }
+}
+
+/*
+  Async TCP Client
+ */
+
+AsyncClient::AsyncClient(int sockfd)
+: _connect_cb(0)
+, _connect_cb_arg(0)
+, _discard_cb(0)
+, _discard_cb_arg(0)
+, _sent_cb(0)
+, _sent_cb_arg(0)
+, _error_cb(0)
+, _error_cb_arg(0)
+, _recv_cb(0)
+, _recv_cb_arg(0)
+, _pb_cb(0)
+, _pb_cb_arg(0)
+, _timeout_cb(0)
+, _timeout_cb_arg(0)
+, _poll_cb(0)
+, _poll_cb_arg(0)
+, _pcb_busy(false)
+, _pcb_sent_at(0)
+, _ack_pcb(true)
+, _rx_last_packet(0)
+, _rx_since_timeout(0)
+, _ack_timeout(ASYNC_MAX_ACK_TIME)
+, _no_delay(false)
+, prev(NULL)
+, next(NULL)
+{
+    _fd = -1;
+    _state = TCP_STATE_CLOSED;
+    _pending_error = ERR_OK;
+    _tx_unacked = 0;
+    _rx_ack_len = 0;
+    _rx_paused = false;
+
+    AsyncLock l(_async_lock());
+    _id = _next_id++;
+    _clients()[_id] = this;
+    if(sockfd >= 0){
+        _fd = sockfd;
+        _state = TCP_STATE_ESTABLISHED;
+        _rx_last_packet = millis();
+        struct epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u64 = _id;
+        epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _fd, &ev);
+    }
+}
+
+AsyncClient::~AsyncClient(){
+    if(_fd >= 0) {
+        _close();
+    }
+    AsyncLock l(_async_lock());
+    _clients().erase(_id);
+}
+
+/*
+ * Callback Setters
+ * */
+
+void AsyncClient::onConnect(AcConnectHandler cb, void* arg){ _connect_cb = cb; _connect_cb_arg = arg; }
+void AsyncClient::onDisconnect(AcConnectHandler cb, void* arg){ _discard_cb = cb; _discard_cb_arg = arg; }
+void AsyncClient::onAck(AcAckHandler cb, void* arg){ _sent_cb = cb; _sent_cb_arg = arg; }
+void AsyncClient::onError(AcErrorHandler cb, void* arg){ _error_cb = cb; _error_cb_arg = arg; }
+void AsyncClient::onData(AcDataHandler cb, void* arg){ _recv_cb = cb; _recv_cb_arg = arg; }
+void AsyncClient::onPacket(AcPacketHandler cb, void* arg){ _pb_cb = cb; _pb_cb_arg = arg; }
+void AsyncClient::onTimeout(AcTimeoutHandler cb, void* arg){ _timeout_cb = cb; _timeout_cb_arg = arg; }
+void AsyncClient::onPoll(AcConnectHandler cb, void* arg){ _poll_cb = cb; _poll_cb_arg = arg; }
+
+/*
+ * Main Public Methods
+ * */
+
+bool AsyncClient::_connectTo(uint32_t addr, uint16_t port){
+    if(!_start_async_task()){
+        log_e("failed to start task");
+        return false;
+    }
+    AsyncLock l(_async_lock());
+    if(_fd >= 0){
+        log_w("already connected, state %d", _state);
+        return false;
+    }
+    int sock = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(sock < 0){
+        log_e("socket failed: %d", errno);
+        return false;
+    }
+    int one = 1;
+    if(_no_delay) {
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    struct sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = addr;
+    sa.sin_port = htons(port);
+    if(::connect(sock, (struct sockaddr *)&sa, sizeof(sa)) < 0 && errno != EINPROGRESS){
+        log_e("connect failed: %d", errno);
+        ::close(sock);
+        return false;
+    }
+    _fd = sock;
+    _state = TCP_STATE_SYN_SENT;
+    _rx_last_packet = millis();
+    struct epoll_event ev = {};
+    ev.events = EPOLLOUT | EPOLLRDHUP;
+    ev.data.u64 = _id;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _fd, &ev);
+    return true;
+}
+
+bool AsyncClient::connect(IPAddress ip, uint16_t port){
+    return _connectTo((uint32_t)ip, port);
+}
+
+bool AsyncClient::connect(const char* host, uint16_t port){
+    IPAddress addr;
+    if(addr.fromString(host)) {
+        return connect(addr, port);
+    }
+    struct addrinfo hints = {};
+    struct addrinfo *res = NULL;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if(getaddrinfo(host, NULL, &hints, &res) != 0 || !res){
+        log_e("error resolving %s", host);
+        return false;
+    }
+    uint32_t ip = ((struct sockaddr_in *)res->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(res);
+    return _connectTo(ip, port);
+}
+
+void AsyncClient::close(bool now){
+    (void)now;
+    _close();
+}
+
+void AsyncClient::stop() {
+    close(false);
+}
+
+int8_t AsyncClient::abort(){
+    AsyncLock l(_async_lock());
+    if(_fd >= 0){
+        // RST instead of FIN; error and disconnect are reported from the async task like lwIP's err callback
+        struct linger lin = { 1, 0 };
+        setsockopt(_fd, SOL_SOCKET, SO_LINGER, &lin, sizeof(lin));
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, _fd, NULL);
+        ::close(_fd);
+        _fd = -1;
+        _state = TCP_STATE_CLOSED;
+        _tx_buf.clear();
+        _tx_unacked = 0;
+        _pending_error = ERR_ABRT;
+        _wake_service_task();
+    }
+    return ERR_ABRT;
+}
+
+bool AsyncClient::free(){
+    AsyncLock l(_async_lock());
+    if(_fd < 0) {
+        return true;
+    }
+    return _state == TCP_STATE_CLOSED || _state > TCP_STATE_ESTABLISHED;
+}
+
+bool AsyncClient::canSend(){
+    return space() > 0;
+}
+
+size_t AsyncClient::space(){
+    AsyncLock l(_async_lock());
+    if(_fd < 0 || _state != TCP_STATE_ESTABLISHED) {
+        return 0;
+    }
+    size_t used = _tx_buf.size() + _tx_unacked;
+    return (used >= CONFIG_ASYNC_TCP_SND_BUF) ? 0 : CONFIG_ASYNC_TCP_SND_BUF - used;
+}
+
+size_t AsyncClient::add(const char* data, size_t size, uint8_t apiflags) {
+    (void)apiflags;     // data is always copied
+    if(size == 0 || data == NULL) {
+        return 0;
+    }
+    AsyncLock l(_async_lock());
+    size_t room = space();
+    if(!room) {
+        return 0;
+    }
+    size_t will_send = (room < size) ? room : size;
+    _tx_buf.insert(_tx_buf.end(), data, data + will_send);
+    return will_send;
+}
+
+bool AsyncClient::send(){
+    AsyncLock l(_async_lock());
+    if(_fd < 0 || _state != TCP_STATE_ESTABLISHED) {
+        return false;
+    }
+    _flush();
+    if(_fd < 0) {
+        return false;
+    }
+    _pcb_busy = true;
+    _pcb_sent_at = millis();
+    _wake_service_task();
+    return true;
+}
+
+size_t AsyncClient::ack(size_t len){
+    AsyncLock l(_async_lock());
+    if(len > _rx_ack_len) {
+        len = _rx_ack_len;
+    }
+    _rx_ack_len -= len;
+    if(_rx_paused && _rx_ack_len < CONFIG_ASYNC_TCP_WND){
+        _rx_paused = false;
+        _updateEvents();
+    }
+    return len;
+}
+
+void AsyncClient::ackPacket(struct pbuf * pb){
+    (void)pb;
+}
+
+size_t AsyncClient::write(const char* data) {
+    if(data == NULL) {
+        return 0;
+    }
+    return write(data, strlen(data));
+}
+
+size_t AsyncClient::write(const char* data, size_t size, uint8_t apiflags) {
+    size_t will_send = add(data, size, apiflags);
+    if(!will_send || !send()) {
+        return 0;
+    }
+    return will_send;
+}
+
+void AsyncClient::setRxTimeout(uint32_t timeout){
+    _rx_since_timeout = timeout;
+}
+
+uint32_t AsyncClient::getRxTimeout(){
+    return _rx_since_timeout;
+}
+
+uint32_t AsyncClient::getAckTimeout(){
+    return _ack_timeout;
+}
+
+void AsyncClient::setAckTimeout(uint32_t timeout){
+    _ack_timeout = timeout;
+}
+
+void AsyncClient::setNoDelay(bool nodelay){
+    AsyncLock l(_async_lock());
+    _no_delay = nodelay;
+    if(_fd >= 0){
+        int v = nodelay ? 1 : 0;
+        setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v));
+    }
+}
+
+bool AsyncClient::getNoDelay(){
+    return _no_delay;
+}
+
+uint16_t AsyncClient::getMss(){
+    AsyncLock l(_async_lock());
+    return (_fd >= 0) ? CONFIG_ASYNC_TCP_MSS : 0;
+}
+
+uint32_t AsyncClient::getRemoteAddress() {
+    AsyncLock l(_async_lock());
+    struct sockaddr_in sa = {};
+    socklen_t len = sizeof(sa);
+    if(_fd < 0 || getpeername(_fd, (struct sockaddr *)&sa, &len) != 0) {
+        return 0;
+    }
+    return sa.sin_addr.s_addr;
+}
+
+uint16_t AsyncClient::getRemotePort() {
+    AsyncLock l(_async_lock());
+    struct sockaddr_in sa = {};
+    socklen_t len = sizeof(sa);
+    if(_fd < 0 || getpeername(_fd, (struct sockaddr *)&sa, &len) != 0) {
+        return 0;
+    }
+    return ntohs(sa.sin_port);
+}
+
+uint32_t AsyncClient::getLocalAddress() {
+    AsyncLock l(_async_lock());
+    struct sockaddr_in sa = {};
+    socklen_t len = sizeof(sa);
+    if(_fd < 0 || getsockname(_fd, (struct sockaddr *)&sa, &len) != 0) {
+        return 0;
+    }
+    return sa.sin_addr.s_addr;
+}
+
+uint16_t AsyncClient::getLocalPort() {
+    AsyncLock l(_async_lock());
+    struct sockaddr_in sa = {};
+    socklen_t len = sizeof(sa);
+    if(_fd < 0 || getsockname(_fd, (struct sockaddr *)&sa, &len) != 0) {
+        return 0;
+    }
+    return ntohs(sa.sin_port);
+}
+
+IPAddress AsyncClient::remoteIP() {
+    return IPAddress(getRemoteAddress());
+}
+
+uint16_t AsyncClient::remotePort() {
+    return getRemotePort();
+}
+
+IPAddress AsyncClient::localIP() {
+    return IPAddress(getLocalAddress());
+}
+
+uint16_t AsyncClient::localPort() {
+    return getLocalPort();
+}
+
+uint8_t AsyncClient::state() {
+    AsyncLock l(_async_lock());
+    return (_fd >= 0) ? _state : (uint8_t)TCP_STATE_CLOSED;
+}
+
+bool AsyncClient::connected(){
+    return state() == TCP_STATE_ESTABLISHED;
+}
+
+bool AsyncClient::connecting(){
+    uint8_t s = state();
+    return s > TCP_STATE_CLOSED && s < TCP_STATE_ESTABLISHED;
+}
+
+bool AsyncClient::disconnecting(){
+    uint8_t s = state();
+    return s > TCP_STATE_ESTABLISHED && s < 10;
+}
+
+bool AsyncClient::disconnected(){
+    uint8_t s = state();
+    return s == TCP_STATE_CLOSED || s == 10;
+}
+
+bool AsyncClient::freeable(){
+    uint8_t s = state();
+    return s == TCP_STATE_CLOSED || s > TCP_STATE_ESTABLISHED;
+}
+
+const char * AsyncClient::errorToString(int8_t error){
+    switch(error){
+        case ERR_OK: return "OK";
+        case ERR_MEM: return "Out of memory error";
+        case ERR_BUF: return "Buffer error";
+        case ERR_TIMEOUT: return "Timeout";
+        case ERR_RTE: return "Routing problem";
+        case ERR_INPROGRESS: return "Operation in progress";
+        case ERR_VAL: return "Illegal value";
+        case ERR_WOULDBLOCK: return "Operation would block";
+        case ERR_USE: return "Address in use";
+        case ERR_ALREADY: return "Already connected";
+        case ERR_CONN: return "Not connected";
+        case ERR_IF: return "Low-level netif error";
+        case ERR_ABRT: return "Connection aborted";
+        case ERR_RST: return "Connection reset";
+        case ERR_CLSD: return "Connection closed";
+        case ERR_ARG: return "Illegal argument";
+        case -55: return "DNS failed";
+        default: return "UNKNOWN";
+    }
+}
+
+const char * AsyncClient::stateToString(){
+    switch(state()){
+        case 0: return "Closed";
+        case 1: return "Listen";
+        case 2: return "SYN Sent";
+        case 3: return "SYN Received";
+        case 4: return "Established";
+        case 5: return "FIN Wait 1";
+        case 6: return "FIN Wait 2";
+        case 7: return "Close Wait";
+        case 8: return "Closing";
+        case 9: return "Last ACK";
+        case 10: return "Time Wait";
+        default: return "UNKNOWN";
+    }
+}
+
+/*
+ * Main Private Methods
+ * */
+
+// caller holds _async_lock()
+void AsyncClient::_updateEvents(){
+    if(_fd < 0) {
+        return;
+    }
+    struct epoll_event ev = {};
+    ev.events = EPOLLRDHUP;
+    if(!_rx_paused) {
+        ev.events |= EPOLLIN;
+    }
+    if(_state == TCP_STATE_SYN_SENT || !_tx_buf.empty()) {
+        ev.events |= EPOLLOUT;
+    }
+    ev.data.u64 = _id;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, _fd, &ev);
+}
+
+// caller holds _async_lock()
+void AsyncClient::_flush(){
+    size_t written = 0;
+    while(written < _tx_buf.size()){
+        ssize_t n = ::send(_fd, _tx_buf.data() + written, _tx_buf.size() - written, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if(n < 0){
+            if(errno == EINTR) {
+                continue;
+            }
+            if(errno != EAGAIN && errno != EWOULDBLOCK){
+                // reported from the async task, never from inside the caller's send()
+                _pending_error = _errno_to_err(errno);
+                _wake_service_task();
+            }
+            break;
+        }
+        written += n;
+    }
+    if(written){
+        _tx_buf.erase(_tx_buf.begin(), _tx_buf.begin() + written);
+        _tx_unacked += written;
+    }
+    _updateEvents();
+}
+
+int8_t AsyncClient::_close(){
+    {
+        AsyncLock l(_async_lock());
+        if(_fd < 0) {
+            return ERR_OK;
+        }
+        if(!_tx_buf.empty()) {
+            _flush();
+        }
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, _fd, NULL);
+        ::close(_fd);
+        _fd = -1;
+        _state = TCP_STATE_CLOSED;
+        _tx_buf.clear();
+        _tx_unacked = 0;
+        _pending_error = ERR_OK;
+    }
+    if(_discard_cb) {
+        _discard_cb(_discard_cb_arg, this);
+    }
+    return ERR_OK;
+}
+
+void AsyncClient::_error(int8_t err) {
+    {
+        AsyncLock l(_async_lock());
+        if(_fd >= 0){
+            epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, _fd, NULL);
+            ::close(_fd);
+            _fd = -1;
+        }
+        _state = TCP_STATE_CLOSED;
+        _tx_buf.clear();
+        _tx_unacked = 0;
+        _pending_error = ERR_OK;
+    }
+    uint32_t id = _id;
+    if(_error_cb) {
+        _error_cb(_error_cb_arg, this, err);
+    }
+    if(!_client_alive(id, this)) {
+        return;
+    }
+    if(_discard_cb) {
+        _discard_cb(_discard_cb_arg, this);
+    }
+}
+
+void AsyncClient::_sent(size_t len) {
+    _rx_last_packet = millis();
+    _pcb_busy = false;
+    if(_sent_cb) {
+        _sent_cb(_sent_cb_arg, this, len, (millis() - _pcb_sent_at));
+    }
+}
+
+/*
+ * Async Task Callbacks
+ * */
+
+void AsyncClient::_service(uint32_t events){
+    uint32_t id = _id;
+    uint8_t st;
+    {
+        AsyncLock l(_async_lock());
+        if(_fd < 0) {
+            return;
+        }
+        st = _state;
+    }
+
+    if(st == TCP_STATE_SYN_SENT){
+        if(!(events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+            return;
+        }
+        int err = 0;
+        socklen_t len = sizeof(err);
+        {
+            AsyncLock l(_async_lock());
+            getsockopt(_fd, SOL_SOCKET, SO_ERROR, &err, &len);
+            if(!err){
+                _state = TCP_STATE_ESTABLISHED;
+                _rx_last_packet = millis();
+                _pcb_busy = false;
+                _updateEvents();
+            }
+        }
+        if(err){
+            _error(_errno_to_err(err));
+            return;
+        }
+        if(_connect_cb) {
+            _connect_cb(_connect_cb_arg, this);
+        }
+        return;
+    }
+
+    if(events & EPOLLOUT){
+        AsyncLock l(_async_lock());
+        if(_fd >= 0) {
+            _flush();
+        }
+    }
+
+    if(events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)){
+        // one MSS per onData, like one pbuf per _recv; bounded per wake-up so one client can't starve the rest
+        char buf[CONFIG_ASYNC_TCP_MSS];
+        for(int segment = 0; segment < 4; segment++){
+            ssize_t n;
+            {
+                AsyncLock l(_async_lock());
+                if(_fd < 0 || _rx_paused) {
+                    return;
+                }
+                n = ::recv(_fd, buf, sizeof(buf), MSG_DONTWAIT);
+            }
+            if(n < 0){
+                if(errno == EINTR) {
+                    continue;
+                }
+                if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                _error(_errno_to_err(errno));
+                return;
+            }
+            if(n == 0){
+                // FIN from the peer
+                _close();
+                return;
+            }
+            _rx_last_packet = millis();
+            //we should not ack before we assimilate the data
+            _ack_pcb = true;
+            if(_recv_cb) {
+                _recv_cb(_recv_cb_arg, this, buf, n);
+            }
+            if(!_client_alive(id, this)) {
+                return;
+            }
+            if(!_ack_pcb){
+                AsyncLock l(_async_lock());
+                _rx_ack_len += n;
+                if(_rx_ack_len >= CONFIG_ASYNC_TCP_WND){
+                    // receive window is full until the application ack()s
+                    _rx_paused = true;
+                    _updateEvents();
+                }
+            }
+        }
+    }
+}
+
+void AsyncClient::_checkSent(){
+    int8_t err;
+    size_t acked = 0;
+    {
+        AsyncLock l(_async_lock());
+        err = _pending_error;
+        if(err == ERR_OK && _fd >= 0 && _tx_unacked){
+            int outq = 0;
+            if(ioctl(_fd, SIOCOUTQ, &outq) == 0 && (size_t)outq < _tx_unacked){
+                acked = _tx_unacked - outq;
+                _tx_unacked = outq;
+            }
+        }
+    }
+    if(err != ERR_OK){
+        _error(err);
+        return;
+    }
+    if(acked) {
+        _sent(acked);
+    }
+}
+
+void AsyncClient::_poll(uint32_t now){
+    {
+        AsyncLock l(_async_lock());
+        if(_fd < 0 || _state != TCP_STATE_ESTABLISHED) {
+            return;
+        }
+    }
+
+    // ACK Timeout
+    if(_pcb_busy && _ack_timeout && (now - _pcb_sent_at) >= _ack_timeout){
+        _pcb_busy = false;
+        log_w("ack timeout %d", _state);
+        if(_timeout_cb)
+            _timeout_cb(_timeout_cb_arg, this, (now - _pcb_sent_at));
+        return;
+    }
+    // RX Timeout
+    if(_rx_since_timeout && (now - _rx_last_packet) >= (_rx_since_timeout * 1000)){
+        log_w("rx timeout %d", _state);
+        _close();
+        return;
+    }
+    // Everything is fine
+    if(_poll_cb) {
+        _poll_cb(_poll_cb_arg, this);
+    }
+}
+
+/*
+  Async TCP Server
+ */
+
+AsyncServer::AsyncServer(IPAddress addr, uint16_t port)
+: _fd(-1)
+, _id(0)
+, _port(port)
+, _addr(addr)
+, _noDelay(false)
+, _connect_cb(0)
+, _connect_cb_arg(0)
+{}
+
+AsyncServer::AsyncServer(uint16_t port)
+: _fd(-1)
+, _id(0)
+, _port(port)
+, _addr((uint32_t) INADDR_ANY)
+, _noDelay(false)
+, _connect_cb(0)
+, _connect_cb_arg(0)
+{}
+
+AsyncServer::~AsyncServer(){
+    end();
+}
+
+void AsyncServer::onClient(AcConnectHandler cb, void* arg){
+    _connect_cb = cb;
+    _connect_cb_arg = arg;
+}
+
+void AsyncServer::begin(){
+    if(_fd >= 0) {
+        return;
+    }
+
+    if(!_start_async_task()){
+        log_e("failed to start task");
+        return;
+    }
+    int sock = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(sock < 0){
+        log_e("socket failed: %d", errno);
+        return;
+    }
+    int one = 1;
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = (uint32_t) _addr;
+    sa.sin_port = htons(_port);
+    if(::bind(sock, (struct sockaddr *)&sa, sizeof(sa)) != 0){
+        log_e("bind error: %d", errno);
+        ::close(sock);
+        return;
+    }
+
+    static uint8_t backlog = 5;
+    if(::listen(sock, backlog) != 0){
+        log_e("listen error: %d", errno);
+        ::close(sock);
+        return;
+    }
+
+    AsyncLock l(_async_lock());
+    _fd = sock;
+    _id = _next_id++;
+    _servers()[_id] = this;
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.u64 = _id;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _fd, &ev);
+}
+
+void AsyncServer::end(){
+    AsyncLock l(_async_lock());
+    if(_fd >= 0){
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, _fd, NULL);
+        ::close(_fd);
+        _fd = -1;
+        _servers().erase(_id);
+    }
+}
+
+//runs on the async task
+void AsyncServer::_accept(){
+    for(;;){
+        int sock = ::accept4(_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if(sock < 0) {
+            return;
+        }
+        if(_connect_cb){
+            AsyncClient *c = new AsyncClient(sock);
+            if(c){
+                c->setNoDelay(_noDelay);
+                _connect_cb(_connect_cb_arg, c);
+                continue;
+            }
+        }
+        ::close(sock);
+        log_e("FAIL");
+    }
+}
+
+void AsyncServer::setNoDelay(bool nodelay){
+    _noDelay = nodelay;
+}
+
+bool AsyncServer::getNoDelay(){
+    return _noDelay;
+}
+
+uint8_t AsyncServer::status(){
+    return (_fd >= 0) ? TCP_STATE_LISTEN : TCP_STATE_CLOSED;
+}
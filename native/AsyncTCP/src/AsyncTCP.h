@@ -0,0 +1,202 @@
+/*
+  Asynchronous TCP library for Espressif MCUs - native (host) build
+
+  Same public interface and callback behaviour as me-no-dev/AsyncTCP, built
+  on non-blocking Linux sockets and epoll so ESPAsyncWebServer can be driven
+  by real HTTP clients.  One "async_tcp" task owns the epoll loop and runs
+  every callback, like the lwIP event task on the board; add()/send()/close()
+  may be called from any task.
+
+  The board's lwIP limits are modelled so backpressure looks the same:
+  space() never exceeds CONFIG_ASYNC_TCP_SND_BUF minus unacked bytes, onAck
+  fires when the peer has acknowledged data (SIOCOUTQ), onData delivers at
+  most one MSS at a time and ackLater() stops reading once a window of data
+  is held.  onPacket is not supported; set onData instead.
+*/
+
+#ifndef ASYNCTCP_H_
+#define ASYNCTCP_H_
+
+#include "IPAddress.h"
+#include <functional>
+#include <vector>
+
+//If core is not defined, then we are running in Arduino or PIO
+#ifndef CONFIG_ASYNC_TCP_RUNNING_CORE
+#define CONFIG_ASYNC_TCP_RUNNING_CORE -1 //any available core
+#endif
+
+// arduino-esp32 lwIP defaults
+#ifndef CONFIG_ASYNC_TCP_MSS
+#define CONFIG_ASYNC_TCP_MSS 1436
+#endif
+#ifndef CONFIG_ASYNC_TCP_SND_BUF
+#define CONFIG_ASYNC_TCP_SND_BUF 5744
+#endif
+#ifndef CONFIG_ASYNC_TCP_WND
+#define CONFIG_ASYNC_TCP_WND 5744
+#endif
+
+class AsyncClient;
+
+#define ASYNC_MAX_ACK_TIME 5000
+#define ASYNC_WRITE_FLAG_COPY 0x01 //will allocate new buffer to hold the data while sending (else will hold reference to the data given)
+#define ASYNC_WRITE_FLAG_MORE 0x02 //will not send PSH flag, meaning that there should be more data to be sent before the application should react.
+
+struct pbuf;
+
+typedef std::function<void(void*, AsyncClient*)> AcConnectHandler;
+typedef std::function<void(void*, AsyncClient*, size_t len, uint32_t time)> AcAckHandler;
+typedef std::function<void(void*, AsyncClient*, int8_t error)> AcErrorHandler;
+typedef std::function<void(void*, AsyncClient*, void *data, size_t len)> AcDataHandler;
+typedef std::function<void(void*, AsyncClient*, struct pbuf *pb)> AcPacketHandler;
+typedef std::function<void(void*, AsyncClient*, uint32_t time)> AcTimeoutHandler;
+
+class AsyncClient {
+  public:
+    AsyncClient(int sockfd = -1);
+    ~AsyncClient();
+
+    bool operator==(const AsyncClient &other) { return this == &other; }
+    bool operator!=(const AsyncClient &other) { return !(*this == other); }
+
+    bool connect(IPAddress ip, uint16_t port);
+    bool connect(const char* host, uint16_t port);
+    void close(bool now = false);
+    void stop();
+    int8_t abort();
+    bool free();
+
+    bool canSend();//ack is not pending
+    size_t space();//space available in the TCP window
+    size_t add(const char* data, size_t size, uint8_t apiflags=ASYNC_WRITE_FLAG_COPY);//add for sending
+    bool send();//send all data added with the method above
+
+    //write equals add()+send()
+    size_t write(const char* data);
+    size_t write(const char* data, size_t size, uint8_t apiflags=ASYNC_WRITE_FLAG_COPY); //only when canSend() == true
+
+    uint8_t state();
+    bool connecting();
+    bool connected();
+    bool disconnecting();
+    bool disconnected();
+    bool freeable();//disconnected or disconnecting
+
+    uint16_t getMss();
+
+    uint32_t getRxTimeout();
+    void setRxTimeout(uint32_t timeout);//no RX data timeout for the connection in seconds
+
+    uint32_t getAckTimeout();
+    void setAckTimeout(uint32_t timeout);//no ACK timeout for the last sent packet in milliseconds
+
+    void setNoDelay(bool nodelay);
+    bool getNoDelay();
+
+    uint32_t getRemoteAddress();
+    uint16_t getRemotePort();
+    uint32_t getLocalAddress();
+    uint16_t getLocalPort();
+
+    //compatibility
+    IPAddress remoteIP();
+    uint16_t  remotePort();
+    IPAddress localIP();
+    uint16_t  localPort();
+
+    void onConnect(AcConnectHandler cb, void* arg = 0);     //on successful connect
+    void onDisconnect(AcConnectHandler cb, void* arg = 0);  //disconnected
+    void onAck(AcAckHandler cb, void* arg = 0);             //ack received
+    void onError(AcErrorHandler cb, void* arg = 0);         //unsuccessful connect or error
+    void onData(AcDataHandler cb, void* arg = 0);           //data received (called if onPacket is not used)
+    void onPacket(AcPacketHandler cb, void* arg = 0);       //data received
+    void onTimeout(AcTimeoutHandler cb, void* arg = 0);     //ack timeout
+    void onPoll(AcConnectHandler cb, void* arg = 0);        //every 125ms when connected
+
+    void ackPacket(struct pbuf * pb);//ack pbuf from onPacket
+    size_t ack(size_t len); //ack data that you have not acked using the method below
+    void ackLater(){ _ack_pcb = false; } //will not ack the current packet. Call from onData
+
+    const char * errorToString(int8_t error);
+    const char * stateToString();
+
+    //Do not use any of the functions below!
+    void _service(uint32_t events);
+    void _checkSent();
+    void _poll(uint32_t now);
+    int fd(){ return _fd; }
+
+  protected:
+    int _fd;
+    uint32_t _id;
+    uint8_t _state;
+    int8_t _pending_error;
+    std::vector<char> _tx_buf;  // added, not yet handed to the socket
+    size_t _tx_unacked;         // handed to the socket, not yet acked by the peer
+    size_t _rx_ack_len;
+    bool _rx_paused;
+
+    int8_t _close();
+    void _error(int8_t err);
+    void _sent(size_t len);
+    void _flush();
+    void _updateEvents();
+    bool _connectTo(uint32_t addr, uint16_t port);
+
+    AcConnectHandler _connect_cb;
+    void* _connect_cb_arg;
+    AcConnectHandler _discard_cb;
+    void* _discard_cb_arg;
+    AcAckHandler _sent_cb;
+    void* _sent_cb_arg;
+    AcErrorHandler _error_cb;
+    void* _error_cb_arg;
+    AcDataHandler _recv_cb;
+    void* _recv_cb_arg;
+    AcPacketHandler _pb_cb;
+    void* _pb_cb_arg;
+    AcTimeoutHandler _timeout_cb;
+    void* _timeout_cb_arg;
+    AcConnectHandler _poll_cb;
+    void* _poll_cb_arg;
+
+    bool _pcb_busy;
+    uint32_t _pcb_sent_at;
+    bool _ack_pcb;
+    uint32_t _rx_last_packet;
+    uint32_t _rx_since_timeout;
+    uint32_t _ack_timeout;
+    bool _no_delay;
+
+  public:
+    AsyncClient* prev;
+    AsyncClient* next;
+};
+
+class AsyncServer {
+  public:
+    AsyncServer(IPAddress addr, uint16_t port);
+    AsyncServer(uint16_t port);
+    ~AsyncServer();
+    void onClient(AcConnectHandler cb, void* arg);
+    void begin();
+    void end();
+    void setNoDelay(bool nodelay);
+    bool getNoDelay();
+    uint8_t status();
+
+    //Do not use any of the functions below!
+    void _accept();
+
+  protected:
+    int _fd;
+    uint32_t _id;
+    uint16_t _port;
+    IPAddress _addr;
+    bool _noDelay;
+    AcConnectHandler _connect_cb;
+    void* _connect_cb_arg;
+};
+
+#endif /* ASYNCTCP_H_ */
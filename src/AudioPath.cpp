@@ -0,0 +1,609 @@
+/**************************************************************************************************
+ *
+ *      Audio output path: A2DP stream reader -> PCM ring -> I2S writer task (DSP chain) -> I2S
+ *
+ *      The sink's stream reader sees PCM before the library's volume control, so volume is
+ *      applied here, near the end of the chain.  Stages are added in audioPathBegin().
+ *
+ *      Nothing in the chain steps: volume changes ramp over a few ms, and a fade stage after
+ *      the volume fades in when playback starts and out when it is muted or the stream ends,
+ *      timed so the gain reaches zero on the last frame left in the ring.
+ *
+ *      The bluetooth callback never blocks: it copies into the ring and wakes the writer.  The
+ *      writer waits until the ring holds the target latency before it starts playing, so short
+ *      stalls of the bluetooth task (wifi/web traffic) are absorbed by the ring instead of
+ *      starving the DMA.  If the ring does run dry while the phone is streaming that is an
+ *      underrun: while the writer primes again the Concealer continues the audio from before the
+ *      gap, fading it out if the gap is long, and the DMA plays silence (tx_desc_auto_clear) after
+ *      that.  The first block after the gap cross-fades back into the stream.
+ *      While streaming, DriftControl holds the fill at the target through the resampler.
+ *
+ *      The chain runs at the source rate, the resampler takes it to the I2S rate, and the output
+ *      chain (limiter, monitor tap) runs on what the resampler made, so the interpolation cannot
+ *      rebuild peaks above the ceiling after the limiter.  All of it keeps Q8.23; OutputFormat
+ *      rounds, dithers and packs that into the I2S word size in the same pass that fills the DMA
+ *      buffer.
+ *
+ *      After AUDIO_IDLE_HANGOVER_MS of silence, streamed or waited through, the writer stops the
+ *      I2S DMA and releases its PM lock.  It keeps reading the ring at the priming level and
+ *      starts the DMA again, from zeroed buffers, on the first block that is not silent.
+ *
+ **************************************************************************************************/
+
+#include <Arduino.h>
+#include <Concealer.h>
+#include <Convolver.h>
+#include <GainStage.h>
+#include <Limiter.h>
+#include <Loudness.h>
+#include <LoudnessMeter.h>
+#include <MixMatrix.h>
+#include <ParametricEQ.h>
+#include <PcmMonitor.h>
+#include <Resampler.h>
+#include <SilenceDetector.h>
+#include <SpectrumAnalyzer.h>
+
+#include "AudioPath.h"
+
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+
+#define AUDIO_DMA_BUFFERS       8
+#define AUDIO_DMA_BUFFER_FRAMES 64
+#define AUDIO_QUEUED_FRAMES     (AUDIO_DMA_BUFFERS * AUDIO_DMA_BUFFER_FRAMES + AUDIO_BLOCK_FRAMES)   // past the ring while playing
+
+static AudioPipeline pipeline;                     // at the source rate
+static AudioPipeline outputChain;                  // at the I2S rate, after the resampler
+static LoudnessMeter meter;                        // the stream as the phone sends it
+static GainStage normalizeStage("normalize");     // unity until normalization is switched on
+static MixMatrix mixer;                            // stereo as it comes until a preset is picked
+static ParametricEQ equalizer;
+static Convolver room;                             // passes audio through until a filter is loaded
+static SpectrumAnalyzer spectrum;
+static GainStage volumeStage("volume", 0);
+static Loudness loudness;                          // bypassed until switched on from the menu
+static GainStage fadeStage("fade", 0);             // silent until the first stream is primed
+static Limiter limiter;
+static PcmMonitor monitor;                         // bypassed while nobody listens
+static AudioRing ring;
+static Resampler resampler;                         // fixed AUDIO_OUTPUT_RATE and/or drift correction
+static DriftControl drift;
+static OutputFormat output;
+static SilenceDetector silence;
+static Concealer concealer;
+
+static BluetoothA2DPSink *audioSink = NULL;
+static TaskHandle_t writerTask = NULL;
+static TaskHandle_t spectrumTask = NULL;
+static volatile uint32_t pendingRate = 0;           // sample rate change for the writer to apply
+static volatile uint32_t currentRate = 44100;
+static uint32_t outputRate = 0;                     // 0 = I2S follows currentRate
+static volatile uint32_t blocksWritten = 0;
+static volatile uint64_t writerCycles = 0;
+static volatile bool muted = false;
+static bool resampling = false;                     // every block goes through the resampler
+static volatile uint32_t primeFrames = 2048;        // ring fill playback starts at
+static int32_t volumeTable[128];                   // a2dp volume -> Q16 gain
+static volatile bool idle = false;                  // I2S stopped for silence
+static volatile uint32_t stateSince = 0;            // ms the current state began
+static volatile uint32_t activeMs = 0;              // time in earlier periods of each state
+static volatile uint32_t idleMs = 0;
+static volatile uint32_t idleCount = 0;
+static volatile bool normalizing = false;
+static volatile float normalizeTarget = AUDIO_NORMALIZE_TARGET_LUFS;
+static volatile float normalizeDb = 0.0f;           // gain applied for normalization
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t pmLock = NULL;          // CPU at full clock while the DMA runs
+#endif
+
+
+// ----------------------------------------------------------------
+//                      -sink callbacks
+// ----------------------------------------------------------------
+// both run on the bluetooth task
+
+static void audioPathStreamReader(const uint8_t *data, uint32_t length) {
+  ring.write((const int16_t *)data, length / (2 * sizeof(int16_t)));    // a2dp always delivers 16 bit stereo
+  if (writerTask) xTaskNotifyGive(writerTask);
+}
+
+static void audioPathSampleRate(uint16_t rate) {
+  pendingRate = rate;
+  if (writerTask) xTaskNotifyGive(writerTask);
+}
+
+
+// ----------------------------------------------------------------
+//                      -i2s writer task
+// ----------------------------------------------------------------
+
+// the writer primes the ring to the target latency, leaving room above it for bursts; once it
+// plays, the DMA queue and the block in hand hold part of that, so DriftControl aims lower
+static void setLatency(uint32_t rate) {
+  uint32_t frames = (uint32_t)((uint64_t)rate * AUDIO_TARGET_LATENCY_MS / 1000);
+  const uint32_t most = ring.capacity() * 3 / 4;
+  if (frames > most) frames = most;
+  primeFrames = frames;
+  drift.begin(rate, frames > AUDIO_QUEUED_FRAMES + AUDIO_BLOCK_FRAMES ? frames - AUDIO_QUEUED_FRAMES : AUDIO_BLOCK_FRAMES);
+}
+
+// stopping the DMA also drops the I2S driver's APB lock; with ours gone too DFS and light sleep can engage
+static void setIdle(bool enter) {
+  const uint32_t now = millis();
+  if (enter) activeMs = activeMs + (now - stateSince);
+  else idleMs = idleMs + (now - stateSince);
+  stateSince = now;
+  if (enter) {
+    i2s_stop(AUDIO_PATH_I2S_PORT);
+    concealer.reset();                              // blocks dropped while idle leave holes in its history
+#if CONFIG_PM_ENABLE
+    if (pmLock) esp_pm_lock_release(pmLock);
+#endif
+    idleCount = idleCount + 1;
+  } else {
+#if CONFIG_PM_ENABLE
+    if (pmLock) esp_pm_lock_acquire(pmLock);
+#endif
+    i2s_zero_dma_buffer(AUDIO_PATH_I2S_PORT);       // nothing left over from before the stop is replayed
+    i2s_start(AUDIO_PATH_I2S_PORT);
+  }
+  idle = enter;
+}
+
+// chain, resampler, output chain and packing for one block, then on to the DMA; start is the cycle count the
+// block's work began at
+static void playBlock(AudioBlock &block, uint32_t start) {
+  static int32_t converted[RESAMPLER_MAX_OUT * AUDIO_MAX_CHANNELS];
+  static int32_t packed[RESAMPLER_MAX_OUT * AUDIO_MAX_CHANNELS];     // 16 bit pairs or 32 bit slots
+  static AudioBlock part;
+
+  pipeline.process(block);
+  if (spectrumTask && spectrum.frameReady()) xTaskNotifyGive(spectrumTask);
+  size_t bytes = 0;
+  if (resampling && (AUDIO_DRIFT_CORRECTION || !resampler.passthrough())) {
+    // up to RESAMPLER_MAX_OUT frames come out: through the output chain a block at a time
+    const size_t frames = resampler.process(block, converted);
+    part.channels = 2;
+    for (size_t done = 0; done < frames; done += part.frames) {
+      part.frames = frames - done < AUDIO_BLOCK_FRAMES ? frames - done : AUDIO_BLOCK_FRAMES;
+      memcpy(part.samples, converted + done * 2, part.frames * 2 * sizeof(int32_t));
+      outputChain.process(part);
+      bytes += output.pack(part.samples, part.frames, 2, (uint8_t *)packed + bytes);
+    }
+  } else {
+    outputChain.process(block);
+    bytes = output.pack(block.samples, AUDIO_BLOCK_FRAMES, 2, packed);
+  }
+  writerCycles = writerCycles + (uint32_t)(ESP.getCycleCount() - start);
+
+  size_t written;
+  i2s_write(AUDIO_PATH_I2S_PORT, packed, bytes, &written, portMAX_DELAY);
+  blocksWritten = blocksWritten + 1;
+}
+
+static void audioWriterTask(void *arg) {
+  (void)arg;
+  static int16_t pcm[AUDIO_BLOCK_FRAMES * AUDIO_MAX_CHANNELS];
+  static AudioBlock block;
+  bool primed = false;
+
+  for (;;) {
+    if (pendingRate) {
+      uint32_t rate = pendingRate;
+      pendingRate = 0;
+      if (resampling) resampler.setRates(rate, outputRate ? outputRate : rate);
+      if (!outputRate) i2s_set_sample_rates(AUDIO_PATH_I2S_PORT, rate);
+      if (idle) i2s_stop(AUDIO_PATH_I2S_PORT);      // setting the clock restarts the DMA
+      setLatency(rate);
+      drift.clear();
+      concealer.begin(rate);
+      pipeline.begin(rate, 2);
+      pipeline.reset();
+      outputChain.begin(outputRate ? outputRate : rate, 2);
+      outputChain.reset();
+      currentRate = rate;
+    }
+
+    size_t available = ring.available();
+    bool streaming = audioSink->get_audio_state() == ESP_A2D_AUDIO_STATE_STARTED;
+    if (!primed) {
+      // once the phone stops sending, play out whatever is left instead of waiting for more
+      if (available < primeFrames && (streaming || available == 0)) {
+        // a gap in the stream: keep the DMA fed with the audio from before it while the ring fills up again
+        uint32_t start = ESP.getCycleCount();
+        if (!idle && concealer.conceal(block)) {
+          playBlock(block, start);
+          continue;
+        }
+        if (!idle && silence.idle(millis())) setIdle(true);      // the DMA has only been playing zeros
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        continue;
+      }
+      primed = true;
+      if (streaming) muted = false;             // a new stream, also one started from the phone, is heard
+      drift.reset();
+    }
+
+    // a stopped DMA does not pace the writer: hold the ring where it would be after priming
+    if (idle && streaming && available < primeFrames + AUDIO_BLOCK_FRAMES) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+      continue;
+    }
+
+    if (available < AUDIO_BLOCK_FRAMES && streaming) {
+      ring.noteUnderrun();
+      primed = false;
+      continue;
+    }
+
+    // fade in after priming; fade out when muted, or over whatever is left once the phone stops
+    const uint32_t fadeFrames = (uint32_t)((uint64_t)currentRate * AUDIO_FADE_MS / 1000);
+    int32_t fade = GAIN_UNITY;
+    uint32_t fadeRamp = fadeFrames;
+    if (muted) fade = 0;
+    else if (!streaming && available <= fadeFrames) {
+      fade = 0;
+      fadeRamp = available;
+    }
+    if (fade != fadeStage.gain()) {
+      fadeStage.setRampFrames(fadeRamp);
+      fadeStage.setGain(fade);
+    }
+
+    uint32_t start = ESP.getCycleCount();
+    size_t n = ring.read(pcm, AUDIO_BLOCK_FRAMES);
+    if (n < AUDIO_BLOCK_FRAMES) {
+      // end of the stream: pad the last partial block
+      primed = false;
+      concealer.reset();                        // the next stream does not continue this one
+      meter.restart();                          // nor is it measured with it
+      if (!n) continue;
+      memset(pcm + n * 2, 0, (AUDIO_BLOCK_FRAMES - n) * 2 * sizeof(int16_t));
+    }
+    audioBlockFromInt16(block, pcm, AUDIO_BLOCK_FRAMES, 2);
+    const uint32_t now = millis();
+    if (!silence.process(block, now)) {
+      if (idle) {
+        setIdle(false);
+        drift.reset();
+      }
+    } else if (idle) {
+      continue;                                 // nothing to hear: drop it without running the chain
+    } else if (silence.idle(now)) {
+      setIdle(true);
+      continue;
+    }
+    concealer.process(block);
+    if (AUDIO_DRIFT_CORRECTION && streaming) resampler.setRatioAdjust(drift.update(ring.available(), n));
+    playBlock(block, start);
+  }
+}
+
+
+// ----------------------------------------------------------------
+//                      -spectrum task
+// ----------------------------------------------------------------
+// FFTs the frames the spectrum stage collects; low priority on the core the writer does not use
+
+static void audioSpectrumTask(void *arg) {
+  (void)arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    spectrum.analyze();
+  }
+}
+
+
+// ----------------------------------------------------------------
+//                          -setup
+// ----------------------------------------------------------------
+
+bool audioPathBegin(BluetoothA2DPSink &sink, const i2s_pin_config_t &pins, size_t ringFrames, bool psram) {
+  if (!ring.begin(ringFrames, 2, psram)) return false;
+  if (AUDIO_OUTPUT_RATE || AUDIO_DRIFT_CORRECTION) {
+    if (!resampler.begin(AUDIO_RESAMPLER_QUALITY, 2)) return false;
+    outputRate = AUDIO_OUTPUT_RATE;
+    resampler.setRates(44100, outputRate ? outputRate : 44100);
+    resampling = true;
+  }
+  setLatency(44100);
+  silence.setThreshold(AUDIO_SILENCE_PEAK_DB, AUDIO_SILENCE_RMS_DB);
+  silence.setHangover(AUDIO_IDLE_HANGOVER_MS);
+  if (!output.setBits(AUDIO_OUTPUT_BITS)) return false;
+  output.setDither(AUDIO_OUTPUT_DITHER);
+
+  // same settings the library would have used for its own output
+  i2s_config_t config = {};
+  config.mode = I2S_MODE_MASTER | I2S_MODE_TX;
+  config.sample_rate = outputRate ? outputRate : 44100;
+  config.bits_per_sample = (i2s_bits_per_sample_t)AUDIO_OUTPUT_BITS;
+  config.channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT;
+  config.communication_format = AUDIO_OUTPUT_LEFT_JUSTIFIED ? I2S_COMM_FORMAT_STAND_MSB : I2S_COMM_FORMAT_STAND_I2S;
+  config.intr_alloc_flags = 0;
+  config.dma_buf_count = AUDIO_DMA_BUFFERS;
+  config.dma_buf_len = AUDIO_DMA_BUFFER_FRAMES;
+  config.use_apll = false;
+  config.tx_desc_auto_clear = true;             // the DMA plays silence while the writer primes
+  i2s_driver_install(AUDIO_PATH_I2S_PORT, &config, 0, NULL);
+  i2s_set_pin(AUDIO_PATH_I2S_PORT, &pins);
+
+#if CONFIG_PM_ENABLE
+  // full clock while playing; while idle the clock may drop to AUDIO_IDLE_MIN_MHZ and, with tickless idle, sleep
+  esp_pm_config_esp32_t pm = {};
+  pm.max_freq_mhz = CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ;
+  pm.min_freq_mhz = AUDIO_IDLE_MIN_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  pm.light_sleep_enable = true;
+#endif
+  if (esp_pm_configure(&pm) == ESP_OK && esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "audio", &pmLock) == ESP_OK) {
+    esp_pm_lock_acquire(pmLock);
+  }
+#endif
+  stateSince = millis();
+  silence.restart(stateSince);
+
+  // bass/treble shelves and three mid peaks, all flat until set from the menu or web page
+  static const EqBand defaultBands[EQ_MAX_BANDS] = {
+    { EQ_LOW_SHELF, true, 100.0f, 0.0f, 0.707f },
+    { EQ_PEAK, true, 400.0f, 0.0f, 1.0f },
+    { EQ_PEAK, true, 1000.0f, 0.0f, 1.0f },
+    { EQ_PEAK, true, 3000.0f, 0.0f, 1.0f },
+    { EQ_HIGH_SHELF, true, 8000.0f, 0.0f, 0.707f },
+  };
+  for (uint8_t i = 0; i < EQ_MAX_BANDS; i++) equalizer.setBand(i, defaultBands[i]);
+
+  pipeline.begin(44100, 2);
+  pipeline.add(&meter);
+  pipeline.add(&normalizeStage);
+  pipeline.add(&mixer);
+  pipeline.add(&equalizer);
+  pipeline.add(&room);
+  pipeline.add(&spectrum);
+  pipeline.add(&volumeStage);
+  pipeline.add(&loudness);
+  pipeline.add(&fadeStage);
+  outputChain.begin(outputRate ? outputRate : 44100, 2);
+  outputChain.add(&limiter);                    // after the resampler, so nothing after it can push past the ceiling
+  outputChain.add(&monitor);                    // only reads the block: what the DAC gets
+  equalizer.update();
+  fadeStage.setRampTime(AUDIO_FADE_MS);
+  normalizeStage.setRampTime(AUDIO_NORMALIZE_UPDATE_MS);     // each step of the gain glides into the next
+
+  // equal steps in dB from -AUDIO_VOLUME_RANGE_DB at 1 to 0 dB at 127
+  volumeTable[0] = 0;
+  for (int i = 1; i < 128; i++) {
+    float db = -AUDIO_VOLUME_RANGE_DB * (127 - i) / 126.0f;
+    volumeTable[i] = (int32_t)lrintf(GAIN_UNITY * powf(10.0f, db / 20.0f));
+  }
+
+  audioSink = &sink;
+  sink.set_stream_reader(audioPathStreamReader, false);
+  sink.set_sample_rate_callback(audioPathSampleRate);
+  xTaskCreatePinnedToCore(audioSpectrumTask, "spectrum", SPECTRUM_TASK_STACK, NULL,
+                          SPECTRUM_TASK_PRIORITY, &spectrumTask, SPECTRUM_TASK_CORE);
+  if (!room.startWorker(ROOM_TASK_CORE, ROOM_TASK_PRIORITY, ROOM_TASK_STACK)) log_w("no room correction worker");
+  xTaskCreatePinnedToCore(audioWriterTask, "i2s_writer", AUDIO_WRITER_STACK, NULL,
+                          AUDIO_WRITER_PRIORITY, &writerTask, AUDIO_WRITER_CORE);
+  return writerTask != NULL;
+}
+
+void audioPathSetVolume(uint8_t volume) {
+  if (volume > 127) volume = 127;
+  volumeStage.setGain(volumeTable[volume]);
+  loudness.setVolume(volume);
+}
+
+bool audioPathSetLoudness(bool enabled) {
+  if (enabled && Loudness::volumeRangeDb() != AUDIO_VOLUME_RANGE_DB) return false;    // table is for another volume law
+  loudness.setEnabled(enabled);
+  return true;
+}
+
+bool audioPathLoudness() {
+  return loudness.enabled();
+}
+
+void audioPathSetNormalize(bool enabled) {
+  normalizing = enabled;
+}
+
+bool audioPathNormalize() {
+  return normalizing;
+}
+
+void audioPathSetNormalizeTarget(float lufs) {
+  normalizeTarget = lufs < -40.0f ? -40.0f : lufs > -6.0f ? -6.0f : lufs;
+}
+
+float audioPathNormalizeTarget() {
+  return normalizeTarget;
+}
+
+float audioPathNormalizeDb() {
+  return normalizeDb;
+}
+
+// glide the gain toward what takes the stream's integrated loudness to the target; back to 0 dB when switched off
+static void normalizeUpdate() {
+  static uint32_t last = 0;
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - last;
+  if (elapsed < AUDIO_NORMALIZE_UPDATE_MS) return;
+  last = now;
+
+  float want = 0.0f;
+  if (normalizing) {
+    if (meter.integratedSeconds() < AUDIO_NORMALIZE_SETTLE_S) return;    // too little measured yet: hold
+    want = normalizeTarget - meter.integrated();
+    if (want > AUDIO_NORMALIZE_MAX_DB) want = AUDIO_NORMALIZE_MAX_DB;
+    if (want < -AUDIO_NORMALIZE_MAX_DB) want = -AUDIO_NORMALIZE_MAX_DB;
+  }
+  const float step = AUDIO_NORMALIZE_DB_PER_S * (elapsed < 1000 ? elapsed : 1000) / 1000.0f;
+  float db = normalizeDb;
+  db += want > db + step ? step : want < db - step ? -step : want - db;
+  normalizeDb = db;
+  normalizeStage.setGain(db == 0.0f ? GAIN_UNITY : (int32_t)lrintf(GAIN_UNITY * powf(10.0f, db / 20.0f)));
+}
+
+void audioPathMute(bool mute) {
+  muted = mute;
+}
+
+// recompute anything the audio task must not (filter coefficients); call from loop()
+void audioPathUpdate() {
+  equalizer.update();
+  room.update();
+  normalizeUpdate();
+}
+
+// a little endian field of a wav header
+static uint32_t wavField(const uint8_t *p, uint8_t bytes) {
+  uint32_t v = 0;
+  for (uint8_t i = 0; i < bytes; i++) v |= (uint32_t)p[i] << (8 * i);
+  return v;
+}
+
+// mono or stereo wav, 16, 24 or 32 bit PCM or 32 bit float; the first CONVOLVER_MAX_TAPS frames are used
+bool audioPathLoadRoom(fs::FS &fs, const char *path) {
+  File file = fs.open(path, FILE_READ);
+  if (!file) return false;
+  uint8_t header[16];
+  if (file.read(header, 12) != 12 || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4)) {
+    log_e("%s: not a wav file", path);
+    return false;
+  }
+  uint16_t format = 0, channels = 0, bits = 0;
+  uint32_t rate = 0, frames = 0;
+  while (file.read(header, 8) == 8) {
+    const uint32_t size = wavField(header + 4, 4), next = file.position() + size + (size & 1);
+    if (!memcmp(header, "fmt ", 4) && size >= 16 && file.read(header, 16) == 16) {
+      format = wavField(header, 2);
+      channels = wavField(header + 2, 2);
+      rate = wavField(header + 4, 4);
+      bits = wavField(header + 14, 2);
+    } else if (!memcmp(header, "data", 4)) {
+      frames = channels && bits ? size / (channels * (bits / 8)) : 0;
+      break;
+    }
+    file.seek(next);
+  }
+  const bool pcm = format == 1 && (bits == 16 || bits == 24 || bits == 32), ieee = format == 3 && bits == 32;
+  if (!(pcm || ieee) || channels < 1 || channels > 2 || !frames) {
+    log_e("%s: need mono or stereo 16/24/32 bit PCM or float", path);
+    return false;
+  }
+  if (frames > CONVOLVER_MAX_TAPS) {
+    log_w("%s: %u frames, using the first %u", path, (unsigned)frames, (unsigned)CONVOLVER_MAX_TAPS);
+    frames = CONVOLVER_MAX_TAPS;
+  }
+
+  float *ir = (float *)malloc((size_t)frames * channels * sizeof(float));
+  if (!ir) return false;
+  const float *rows[2] = { ir, ir + (channels - 1) * frames };
+  const uint8_t width = bits / 8;
+  bool ok = true;
+  for (uint32_t i = 0; i < frames && ok; i++) {
+    for (uint16_t c = 0; c < channels; c++) {
+      uint8_t sample[4];
+      if (file.read(sample, width) != width) {
+        ok = false;
+        break;
+      }
+      const uint32_t raw = wavField(sample, width);
+      float v;
+      if (ieee) {
+        memcpy(&v, &raw, sizeof(v));
+      } else {
+        v = (float)(int32_t)(raw << (32 - bits)) / 2147483648.0f;     // left aligned, sign from the top bit
+      }
+      ir[c * frames + i] = v;
+    }
+  }
+  if (ok) ok = room.setFilter(rows, channels, frames, rate, AUDIO_RING_PSRAM);
+  free(ir);
+  if (ok) log_i("%s: %u taps, %u channel(s), %u Hz", path, (unsigned)frames, channels, (unsigned)rate);
+  return ok;
+}
+
+void audioPathSetRoom(bool enabled) {
+  room.setBypass(!enabled);
+}
+
+Convolver &audioPathRoom() {
+  return room;
+}
+
+LoudnessMeter &audioPathMeter() {
+  return meter;
+}
+
+MixMatrix &audioPathMixer() {
+  return mixer;
+}
+
+ParametricEQ &audioPathEqualizer() {
+  return equalizer;
+}
+
+AudioPipeline &audioPathPipeline() {
+  return pipeline;
+}
+
+AudioPipeline &audioPathOutputChain() {
+  return outputChain;
+}
+
+Limiter &audioPathLimiter() {
+  return limiter;
+}
+
+SpectrumAnalyzer &audioPathSpectrum() {
+  return spectrum;
+}
+
+PcmMonitor &audioPathMonitor() {
+  return monitor;
+}
+
+OutputFormat &audioPathOutput() {
+  return output;
+}
+
+AudioPathStats audioPathStats() {
+  AudioPathStats s;
+  s.ring = ring.stats();
+  s.sampleRate = currentRate;
+  s.outputRate = outputRate ? outputRate : currentRate;
+  s.blocksWritten = blocksWritten;
+  s.writerCycles = writerCycles;
+  s.latencyMs = (drift.averageFill() + AUDIO_QUEUED_FRAMES) * 1000.0f / currentRate;
+  s.targetLatencyMs = primeFrames * 1000.0f / currentRate;
+  s.driftPpm = drift.driftPpm();
+  s.correctionPpm = drift.correctionPpm();
+  const uint32_t current = millis() - stateSince;
+  s.idle = idle;
+  s.activeSeconds = (activeMs + (s.idle ? 0 : current)) / 1000.0f;
+  s.idleSeconds = (idleMs + (s.idle ? current : 0)) / 1000.0f;
+  s.idleCount = idleCount;
+  s.concealedFrames = concealer.concealedFrames();
+  s.concealedGaps = concealer.gaps();
+  return s;
+}
+
+void audioPathResetStats() {
+  ring.resetStats();
+  blocksWritten = 0;
+  writerCycles = 0;
+  pipeline.resetStats();
+  outputChain.resetStats();
+  limiter.resetStats();
+  monitor.resetStats();
+  concealer.resetStats();
+  room.resetStats();
+  activeMs = 0;
+  idleMs = 0;
+  idleCount = 0;
+  stateSince = millis();
+}
@@ -31,10 +31,12 @@ const char version[4] = "0.2";
 #include <Adafruit_SSD1306.h>
 #include "BluetoothA2DPSink.h"
 #include <EEPROM.h>
+#include <SPIFFS.h>
 #include <WiFi.h>
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
 #include <AsyncElegantOTA.h>
+#include "AudioPath.h"
 
 BluetoothA2DPSink a2dp_sink;
 
@@ -63,31 +65,64 @@ const int iLED = 22;						// onboard indicator led gpio pin
 #define DEBOUNCEDELAY 100					// debounce delay for button inputs
 const int menuTimeout = 10;					// menu inactivity timeout (seconds)
 const bool menuLargeText = 0;				// show larger text when possible (if struggling to read the small text)
-const int maxmenuItems = 12;				// max number of items used in any of the menus (keep as low as possible to save memory)
 const int itemTrigger = 1;					// rotary encoder - counts per tick (varies between encoders usually 1 or 2)
 const int topLine = 18;						// y position of lower area of the display (18 with two colour displays)
 const byte lineSpace1 = 9;					// line spacing for textsize 1 (small text)
 const byte lineSpace2 = 17;					// line spacing for textsize 2 (large text)
 const int displayMaxLines = 5;				// max lines that can be displayed in lower section of display in textsize1 (5 on larger oLeds)
 const int MaxmenuTitleLength = 10;			// max characters per line when using text size 2 (usually 10)
+const int spectrumFrameMs = 40;				// spectrum analyser - fastest redraw (ms)
+const int spectrumI2cBudget = 50;			// spectrum analyser - max % of the time display() may keep the i2c bus busy
+const int spectrumFallRate = 150;			// spectrum analyser - how fast the bars drop (pixels per second)
+const int nowPlayingSettleMs = 200;			// now playing - wait this long after the last metadata change before laying out the text
+const int meterFrameMs = 200;				// loudness meter - redraw interval (ms)
+const int uiMaxFps = 30;					// menus - redraw at most this often, and only when something changed (frames per second)
+const int nowPlayingFrameMs = 250;			// now playing - redraw interval for the position (ms)
+const int loopMaxSleepMs = 100;				// longest loop() waits for an event (audio path housekeeping runs at least this often)
+const int monitorPollMs = 5;				// ...or this while /monitor has listeners (a frame is ~6ms of audio)
+const int uiQueueLength = 16;				// events that may wait for loop() before more are dropped (the first one wakes it)
+const int meterBarFloor = -50;				// loudness meter - LUFS at the left end of the bar
+const int nowPlayingPosInterval = 5;		// now playing - seconds between position reports from the phone (interpolated in between)
+const int phoneVolumeSaveMs = 2000;			// volume from the phone - saved once it has not changed for this long (ms), a slider sends many steps
+const size_t monitorMaxQueued = 2;			// pcm monitor - frames a websocket client may have waiting before it misses one
+const char *roomFile = "/room.wav";		// room correction impulse response on SPIFFS (data/room.wav)
 
 byte volume = 0;
 byte volumeAddr = 0;
+byte loudnessOn = 0;                      // loudness compensation (1 = on)
+byte loudnessAddr = 1;
+byte normalizeOn = 0;                     // loudness normalization (1 = on)
+byte normalizeAddr = 2;
+volatile byte phoneVolume = 0;            // last AVRCP volume from the phone, written by the bluetooth task
+volatile uint32_t phoneVolumeChanges = 0; // counts them, so loop() sees that phoneVolume moved
+
+constexpr const char *eqBandNames[EQ_MAX_BANDS] = { "Bass", "Low Mid", "Mid", "High Mid", "Treble" };   // default bands set in AudioPath.cpp
+byte spectrumHeight[SPECTRUM_BARS];       // spectrum bar heights on the display (pixels)
+uint32_t spectrumInterval = spectrumFrameMs;   // current spectrum redraw interval (ms)
 
 const char *ssid     = "BZ_IOT";
 const char *password = "Password";
 
 AsyncWebServer server(80);
+AsyncWebSocket monitorSocket("/monitor");  // post-DSP pcm for remote listening (see /listen)
+uint32_t monitorSkipped = 0;              // frames not sent to a client that was still busy with older ones
 
 // -------------------------------------------------------------------------------------------------
 
 
 // forward declarations
   void doEncoder();
-  void controlMenu();
+  void defaultMenu();
   void menuActions();
-  void volumeControl();
-  void menuVolume();
+  void menuValueEntered();
+  void audioStatsMessage();
+  void spectrumDisplay();
+  void spectrumUpdate();
+  void meterDisplay();
+  void meterUpdate();
+  void nowPlayingDisplay();
+  void nowPlayingUpdate();
+  void monitorUpdate();
   void reUpdateButton();
   void serviceMenu();
   int serviceValue(bool _blocking);
@@ -100,19 +135,62 @@ AsyncWebServer server(80);
       menu,                                 // a menu is active
       value,                                // 'enter a value' none blocking is active
       message,                              // displaying a message
+      spectrum,                             // the spectrum analyser is running
+      playing,                              // the now playing screen is showing
+      meter,                                // the loudness meter is showing
       blocking                              // a blocking procedure is in progress (see enter value)
   };
   menuModes menuMode = off;                 // default mode at startup is off
 
+  // menus are constant tables (they stay in flash): a menu has a title and its items, an item a label and what
+  // selecting it does - open a submenu, open a value editor or call an action.  Items whose label shows some
+  // state have a text function that writes the label each time the item is drawn.  Menus nest to any depth and
+  // hold any number of items.
+  struct menuDefs;
+  struct menuItemDefs;
+  typedef void (*menuActionFn)(int _arg);
+  typedef void (*menuTextFn)(const menuItemDefs &_item, char *_text, size_t _size);
+
+  struct valueEditors {
+    const char *title;                        // printf format, %s is the label of the item that opened it
+    int low, high, step;
+    int (*get)(int _arg);                     // starting value
+    void (*set)(int _arg, int _value);        // act on the value entered; then back to the menu, unless it shows something else
+  };
+
+  struct menuItemDefs {
+    const char *label;
+    menuTextFn text;                          // label with state, NULL to show the label as it is
+    menuActionFn action;
+    const menuDefs *submenu;
+    const valueEditors *editor;
+    int arg;                                  // passed to the functions, e.g. which band
+  };
+
+  struct menuDefs {
+    const char *title;
+    const menuItemDefs *items;
+    int count;
+    const menuDefs *parent;                   // where "Back" goes
+  };
+
+  template <size_t N>
+  constexpr menuDefs menuDef(const char *_title, const menuItemDefs (&_items)[N], const menuDefs *_parent) {
+    return { _title, _items, (int)N, _parent };
+  }
+
+  const int menuTextLength = 22;              // a line of size 1 text and its terminator
+
   struct oledMenus {
     // menu
-    String menuTitle = "";                    // the title of active mode
-    int noOfmenuItems = 0;                    // number if menu items in the active menu
+    const menuDefs *activeMenu = NULL;        // the menu showing, or that the value editor returns to
     int selectedMenuItem = 0;                 // when a menu item is selected it is flagged here until actioned and cleared
-    int highlightedMenuItem = 0;              // which item is curently highlighted in the menu
-    String menuItems[maxmenuItems+1];         // store for the menu item titles
+    int highlightedMenuItem = 0;              // which item is curently highlighted in the menu (from 1)
     uint32_t lastMenuActivity = 0;            // time the menu last saw any activity (used for timeout)
     // 'enter a value'
+    const valueEditors *editor = NULL;        // the value being entered
+    int editorArg = 0;
+    char valueTitle[menuTextLength] = "";
     int mValueEntered = 0;                    // store for number entered by value entry menu
     int mValueLow = 0;                        // lowest allowed value
     int mValueHigh = 0;                       // highest allowed value
@@ -133,81 +211,638 @@ AsyncWebServer server(80);
   };
   rotaryEncoders rotaryEncoder;
 
+  // ui events: loop() sleeps on the queue until one arrives or something is due
+  enum uiEventTypes : uint8_t {
+    uiEncoderEvent,                           // encoder turned (interrupt)
+    uiButtonEvent,                            // button changed state (interrupt)
+    uiTrackEvent,                             // track info or play state from the phone
+    uiStateEvent                              // settings changed from the web pages or the phone
+  };
+  QueueHandle_t uiEvents = NULL;
+  bool uiDirty = false;                       // the menu on the display is out of date
+  uint32_t uiLastFrame = 0;                   // millis() when the current screen was last drawn
+  menuModes uiFrameMode = off;                // the screen that was drawn then
+
+  // track info from the phone (AVRCP), written by the bluetooth task - hold nowPlayingLock to access
+  struct nowPlayingInfos {
+    char title[64] = "";
+    char artist[64] = "";
+    char album[64] = "";
+    uint32_t durationMs = 0;                  // track length, 0 if the phone does not send it
+    uint32_t positionMs = 0;                  // play position at positionTime
+    uint32_t positionTime = 0;                // millis() when positionMs was valid
+    bool playing = false;
+    uint32_t version = 0;                     // incremented whenever title, artist, album or length change
+    uint32_t changed = 0;                     // millis() of the last change
+  };
+  nowPlayingInfos nowPlaying;
+  portMUX_TYPE nowPlayingLock = portMUX_INITIALIZER_UNLOCKED;
+
+  // now playing screen layout, worked out once per track
+  const int nowPlayingMaxLines = 4;
+  struct nowPlayingLayouts {
+    uint32_t version = 0;                     // nowPlaying.version the layout is for
+    bool valid = false;
+    int lines = 0;
+    String text[nowPlayingMaxLines];
+    int16_t x[nowPlayingMaxLines];
+    int16_t y[nowPlayingMaxLines];
+    uint8_t size[nowPlayingMaxLines];
+    int barShown = 0;                         // progress bar length on the display (pixels)
+    uint32_t secondShown = 0;                 // elapsed time on the display (seconds)
+    int timeWidth = 0;                        // width of the time text on the display (pixels)
+  };
+  nowPlayingLayouts nowPlayingLayout;
+  const int nowPlayingTimeY = 48;             // time text (page 6)
+  const int nowPlayingBarY = 57;              // progress bar outline, 7 pixels high (page 7)
+
 // oled SSD1306 display connected to I2C
   Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 
 
+// ----------------------------------------------------------------
+//                 -ui events and frame pacing
+// ----------------------------------------------------------------
+// the interrupts and the other tasks post events; loop() sleeps on the queue until one arrives or the next
+// frame, timeout or debounce is due, and the screens draw only when uiFrameDue() says so
+
+// from another task (bluetooth, web server)
+void uiPost(uint8_t _event) {
+  if (uiEvents) xQueueSend(uiEvents, &_event, 0);        // if the queue is full loop() is awake anyway
+}
+
+void IRAM_ATTR uiPostFromISR(uint8_t _event) {
+  BaseType_t tWoken = pdFALSE;
+  if (uiEvents) xQueueSendFromISR(uiEvents, &_event, &tWoken);
+  if (tWoken) portYIELD_FROM_ISR();
+}
+
+// shortest time between frames of the current screen (ms)
+uint32_t uiFrameInterval() {
+  if (menuMode == spectrum) return spectrumInterval;
+  if (menuMode == meter) return meterFrameMs;
+  if (menuMode == playing) return nowPlayingFrameMs;
+  return 1000 / uiMaxFps;
+}
+
+// ms until the current screen should be drawn, -1 if it has nothing new to show; the menus are drawn when
+// something changed, the live screens on their own clock, and a screen just opened at once
+int32_t uiFrameWait() {
+  const bool live = (menuMode == spectrum || menuMode == meter || menuMode == playing);
+  if (!live && menuMode != menu && menuMode != value) return -1;
+  if (menuMode != uiFrameMode) return 0;
+  if (!live && !uiDirty) return -1;
+  uint32_t tElapsed = (unsigned long)(millis() - uiLastFrame);
+  uint32_t tInterval = uiFrameInterval();
+  return tElapsed >= tInterval ? 0 : tInterval - tElapsed;
+}
+
+// true if the screen should be drawn now, which the caller then does
+bool uiFrameDue() {
+  if (uiFrameWait() != 0) return false;
+  uiDirty = false;
+  uiFrameMode = menuMode;
+  uiLastFrame = millis();
+  return true;
+}
+
+// sleep until an event arrives or something is due: a frame, the menu timeout or the end of the button
+// debounce; never longer than loopMaxSleepMs so the audio path housekeeping keeps running
+void uiWait() {
+  uint32_t tNow = millis();
+  uint32_t tWait = monitorSocket.count() ? monitorPollMs : loopMaxSleepMs;
+
+  int32_t tFrame = uiFrameWait();
+  if (tFrame >= 0 && (uint32_t)tFrame < tWait) tWait = tFrame;
+  if (menuMode == menu || menuMode == value || menuMode == message) {
+    uint32_t tIdle = (unsigned long)(tNow - oledMenu.lastMenuActivity);
+    uint32_t tTimeout = menuTimeout * 1000 + 1;
+    uint32_t tLeft = tIdle >= tTimeout ? 0 : tTimeout - tIdle;
+    if (tLeft < tWait) tWait = tLeft;
+  }
+  uint32_t tSettle = (unsigned long)(tNow - rotaryEncoder.reLastButtonChange);
+  if (tSettle <= rotaryEncoder.reDebounceDelay) {          // button changed recently: look again once it is stable
+    uint32_t tLeft = rotaryEncoder.reDebounceDelay + 1 - tSettle;
+    if (tLeft < tWait) tWait = tLeft;
+  }
+
+  uint8_t tEvent;
+  if (xQueueReceive(uiEvents, &tEvent, pdMS_TO_TICKS(tWait)) != pdTRUE) return;
+  do {
+    if (tEvent != uiTrackEvent) uiDirty = true;          // the now playing screen redraws on its own clock
+  } while (xQueueReceive(uiEvents, &tEvent, 0) == pdTRUE);
+}
+
+
 // -------------------------------------------------------------------------------------------------
 //                                 The custom menus go below here
 // -------------------------------------------------------------------------------------------------
 
 
+void menuBack(int);
+void openMenu(const menuDefs &_menu, int _highlight = 1);
+
+// label "<name>  On" or "Off"
+void onOffText(bool _on, const menuItemDefs &_item, char *_text, size_t _size) {
+  snprintf(_text, _size, "%-10s%s", _item.label, _on ? "On" : "Off");
+}
+
+void toggleLoudness(int) {
+  loudnessOn = !audioPathLoudness();
+  audioPathSetLoudness(loudnessOn);
+  EEPROM.put(loudnessAddr, loudnessOn);
+  EEPROM.commit();
+}
+
+void toggleNormalize(int) {
+  normalizeOn = !audioPathNormalize();
+  audioPathSetNormalize(normalizeOn);
+  EEPROM.put(normalizeAddr, normalizeOn);
+  EEPROM.commit();
+}
+
+void setVolume(int, int _value) {
+  volume = _value;
+  EEPROM.put(volumeAddr, volume);
+  EEPROM.commit();
+  a2dp_sink.set_volume(volume);
+  audioPathSetVolume(volume);
+  displayMessage("Entered", "\n\nVolume : " + String(volume));
+}
+
+// bands are listed with their current gain
+void eqBandText(const menuItemDefs &_item, char *_text, size_t _size) {
+  int gain = lroundf(audioPathEqualizer().band(_item.arg).gainDb);
+  snprintf(_text, _size, "%s  %s%d dB", _item.label, gain > 0 ? "+" : "", gain);
+}
+
+void setEqGain(int _arg, int _value) {
+  EqBand band = audioPathEqualizer().band(_arg);
+  band.gainDb = _value;
+  audioPathEqualizer().setBand(_arg, band);
+}
+
+constexpr valueEditors volumeEditor = { "Volume", 0, 127, 1, [](int) { return (int)volume; }, setVolume };   // the a2dp range: 127 is 0 dB
+constexpr valueEditors eqGainEditor = { "EQ %s", (int)EQ_GAIN_MIN_DB, (int)EQ_GAIN_MAX_DB, 1,
+                                        [](int _arg) { return (int)lroundf(audioPathEqualizer().band(_arg).gainDb); }, setEqGain };
+
+extern const menuDefs controlMenu;
+
+constexpr menuItemDefs equalizerItems[] = {
+  { "Back", NULL, menuBack, NULL, NULL, 0 },
+  { eqBandNames[0], eqBandText, NULL, NULL, &eqGainEditor, 0 },
+  { eqBandNames[1], eqBandText, NULL, NULL, &eqGainEditor, 1 },
+  { eqBandNames[2], eqBandText, NULL, NULL, &eqGainEditor, 2 },
+  { eqBandNames[3], eqBandText, NULL, NULL, &eqGainEditor, 3 },
+  { eqBandNames[4], eqBandText, NULL, NULL, &eqGainEditor, 4 },
+  { "Flat", NULL, [](int) { audioPathEqualizer().setFlat(); }, NULL, NULL, 0 },
+};
+static_assert(sizeof(equalizerItems) / sizeof(equalizerItems[0]) == EQ_MAX_BANDS + 2, "one item per equalizer band");
+constexpr menuDefs equalizerMenu = menuDef("Equalizer", equalizerItems, &controlMenu);
+
+constexpr menuItemDefs controlItems[] = {
+  { "Exit", NULL, [](int) { resetMenu(); }, NULL, NULL, 0 },
+  { "Pause", NULL, [](int) { audioPathMute(true); a2dp_sink.pause(); }, NULL, NULL, 0 },      // fades out over what is already buffered
+  { "Play", NULL, [](int) { audioPathMute(false); a2dp_sink.play(); }, NULL, NULL, 0 },
+  { "Volume", NULL, NULL, NULL, &volumeEditor, 0 },
+  { "Equalizer", NULL, NULL, &equalizerMenu, NULL, 0 },
+  { "IP Address", NULL, [](int) { displayMessage("IP Address", WiFi.localIP().toString()); }, NULL, NULL, 0 },
+  { "Audio Stats", NULL, [](int) { audioStatsMessage(); }, NULL, NULL, 0 },
+  { "Spectrum", NULL, [](int) { spectrumDisplay(); }, NULL, NULL, 0 },
+  { "Now Playing", NULL, [](int) { nowPlayingDisplay(); }, NULL, NULL, 0 },
+  { "Loudness", [](const menuItemDefs &_item, char *_text, size_t _size) { onOffText(audioPathLoudness(), _item, _text, _size); },
+    toggleLoudness, NULL, NULL, 0 },
+  { "Loudness Meter", NULL, [](int) { meterDisplay(); }, NULL, NULL, 0 },
+  { "Normalize", [](const menuItemDefs &_item, char *_text, size_t _size) { onOffText(audioPathNormalize(), _item, _text, _size); },
+    toggleNormalize, NULL, NULL, 0 },
+};
+constexpr menuDefs controlMenu = menuDef("Control Menu", controlItems, NULL);
+
 // Start the default menu
 void defaultMenu() {
-  controlMenu();
+  openMenu(controlMenu);
 }
 
-void controlMenu() {
-  resetMenu();								// clear any previous menu
-  menuMode = menu;							// enable menu mode
-  oledMenu.noOfmenuItems = 5;				// set the number of items in this menu
-  oledMenu.menuTitle	= "Control Menu";	// menus title (used to identify it)
-  oledMenu.menuItems[1] = "Exit";
-  oledMenu.menuItems[2] = "Pause";			// set the menu items
-  oledMenu.menuItems[3] = "Play";
-  oledMenu.menuItems[4] = "Volume";
-  oledMenu.menuItems[5] = "IP Address";
+//                -----------------------------------------------
+
+void openMenu(const menuDefs &_menu, int _highlight) {
+  resetMenu();                              // clear any previous menu
+  menuMode = menu;                          // enable menu mode
+  oledMenu.activeMenu = &_menu;
+  oledMenu.highlightedMenuItem = _highlight;
+}
+
+// back to the menu this one was opened from, on the item that opened it
+void menuBack(int) {
+  const menuDefs *from = oledMenu.activeMenu;
+  const menuDefs *parent = from ? from->parent : NULL;
+  if (!parent) {
+    resetMenu();
+    return;
+  }
+  int item = 1;
+  for (int i = 0; i < parent->count; i++) {
+    if (parent->items[i].submenu == from) item = i + 1;
+  }
+  openMenu(*parent, item);
+}
+
+void openEditor(const menuItemDefs &_item) {
+  const menuDefs *from = oledMenu.activeMenu;
+  int item = oledMenu.highlightedMenuItem;
+  const valueEditors &editor = *_item.editor;
+  resetMenu();                              // clear any previous menu
+  menuMode = value;                         // enable value entry
+  oledMenu.activeMenu = from;               // where it goes back to
+  oledMenu.highlightedMenuItem = item;
+  oledMenu.editor = &editor;
+  oledMenu.editorArg = _item.arg;
+  snprintf(oledMenu.valueTitle, sizeof(oledMenu.valueTitle), editor.title, _item.label);
+  oledMenu.mValueLow = editor.low;
+  oledMenu.mValueHigh = editor.high;
+  oledMenu.mValueStep = editor.step;
+  oledMenu.mValueEntered = editor.get(_item.arg);
+}
+
+// the value editor's button was pressed
+void menuValueEntered() {
+  const menuDefs *from = oledMenu.activeMenu;
+  int item = oledMenu.highlightedMenuItem;
+  oledMenu.editor->set(oledMenu.editorArg, oledMenu.mValueEntered);
+  if (menuMode == value && from) openMenu(*from, item);   // back to the item that opened the editor
 }
 
+// the label of an item as it is drawn
+void menuItemText(const menuItemDefs &_item, char *_text, size_t _size) {
+  if (_item.text) _item.text(_item, _text, _size);
+  else snprintf(_text, _size, "%s", _item.label);
+}
+
+// act on the selected item: open its submenu or value editor, or call its action; an action that does not leave
+// the menu leaves it showing, so its new state is drawn on the same item
 void menuActions() {
-  if (oledMenu.menuTitle == "Control Menu") {
-    if (oledMenu.selectedMenuItem == 1) {
-      resetMenu();
-    }
-    if (oledMenu.selectedMenuItem == 2) {
-      resetMenu();
-      a2dp_sink.pause();
-      defaultMenu();
-    }
-    if (oledMenu.selectedMenuItem == 3) {
-      resetMenu();
-      a2dp_sink.play();
-      defaultMenu();
-    }
-    if (oledMenu.selectedMenuItem == 4) {
-      resetMenu();
-      volumeControl();
+  if (!oledMenu.selectedMenuItem || !oledMenu.activeMenu) return;
+  const menuItemDefs &item = oledMenu.activeMenu->items[oledMenu.selectedMenuItem - 1];
+  oledMenu.selectedMenuItem = 0;
+  rotaryEncoder.reButtonPressed = 0;
+  if (item.submenu) openMenu(*item.submenu);
+  else if (item.editor) openEditor(item);
+  else if (item.action) item.action(item.arg);
+  uiDirty = true;
+}
+
+//                -----------------------------------------------
+
+
+// audio buffer health since boot (or the last reset from the web page)
+void audioStatsMessage() {
+  AudioPathStats stats = audioPathStats();
+  displayMessage("Audio Stats",
+                 "Buffer " + String(stats.ring.fill) + "/" + String(stats.ring.capacity) +
+                 "\nPeak   " + String(stats.ring.highWater) +
+                 "\nUnderruns " + String(stats.ring.underruns) + " (" + String(stats.concealedFrames) + ")" +
+                 "\nOverruns  " + String(stats.ring.overruns) + " (" + String(stats.ring.droppedFrames) + ")" +
+                 "\nRate   " + String(stats.sampleRate) + " Hz");
+}
+
+//                -----------------------------------------------
+
+// full screen spectrum analyser, runs until the button is pressed
+void spectrumDisplay() {
+  resetMenu();
+  menuMode = spectrum;
+  memset(spectrumHeight, 0, sizeof(spectrumHeight));
+  spectrumInterval = spectrumFrameMs;
+  audioPathSpectrum().setBypass(false);       // start feeding the analyser
+}
+
+// draws the latest bar levels; display() sends only the bytes that changed, but moving bars change most of
+// them, so the redraw interval is stretched until display() uses no more than spectrumI2cBudget % of the time
+void spectrumUpdate() {
+  if (rotaryEncoder.reButtonPressed) {
+    audioPathSpectrum().setBypass(true);
+    defaultMenu();
+    return;
+  }
+  oledMenu.lastMenuActivity = millis();       // no timeout while the analyser is showing
+  uint32_t elapsed = (unsigned long)(millis() - uiLastFrame);
+  if (!uiFrameDue()) return;
+
+  const volatile uint8_t *levels = audioPathSpectrum().levels();
+  const int barWidth = SCREEN_WIDTH / SPECTRUM_BARS;
+  int fall = elapsed * spectrumFallRate / 1000;
+  if (fall < 1) fall = 1;
+  display.clearDisplay();
+  for (int i = 0; i < SPECTRUM_BARS; i++) {
+    int height = levels[i] * SCREEN_HEIGHT / 256;
+    if (height < spectrumHeight[i] - fall) height = spectrumHeight[i] - fall;      // bars rise at once and fall slowly
+    spectrumHeight[i] = height;
+    if (height) display.fillRect(i * barWidth, SCREEN_HEIGHT - height, barWidth - 1, height, WHITE);
+  }
+
+  uint32_t start = micros();
+  display.display();
+  uint32_t busy = (unsigned long)(micros() - start);
+  spectrumInterval = busy * 100 / spectrumI2cBudget / 1000;
+  if (spectrumInterval < spectrumFrameMs) spectrumInterval = spectrumFrameMs;
+}
+
+//                -----------------------------------------------
+
+// loudness meter, runs until the button is pressed
+void meterDisplay() {
+  resetMenu();
+  menuMode = meter;
+}
+
+String formatLufs(float _lufs) {
+  return _lufs <= METER_FLOOR ? String("  --") : String(_lufs, 1);
+}
+
+// momentary loudness large with a bar (the tick is the normalization target), short-term, integrated and the
+// normalization gain below
+void meterUpdate() {
+  if (rotaryEncoder.reButtonPressed) {
+    defaultMenu();
+    return;
+  }
+  oledMenu.lastMenuActivity = millis();       // no timeout while the meter is showing
+  if (!uiFrameDue()) return;
+
+  LoudnessMeter &tMeter = audioPathMeter();
+  const float momentary = tMeter.momentary();
+  display.clearDisplay();
+  display.setTextColor(WHITE);
+  display.setTextSize(2);
+  display.setCursor(0, 0);
+  display.print(formatLufs(momentary));
+  display.setTextSize(1);
+  display.setCursor(SCREEN_WIDTH - 4 * 6, 7);
+  display.print("LUFS");
+
+  display.setCursor(0, topLine);
+  display.println("Short-term " + formatLufs(tMeter.shortTerm()));
+  display.println("Integrated " + formatLufs(tMeter.integrated()));
+  float gain = audioPathNormalizeDb();
+  display.println("Normalize  " + (audioPathNormalize() ? String(gain > 0 ? "+" : "") + String(gain, 1) + " dB" : String("Off")));
+
+  const int barLength = SCREEN_WIDTH - 2;
+  int bar = (momentary - meterBarFloor) * barLength / -meterBarFloor;
+  bar = constrain(bar, 0, barLength);
+  int target = (audioPathNormalizeTarget() - meterBarFloor) * barLength / -meterBarFloor;
+  display.drawRect(0, nowPlayingBarY, SCREEN_WIDTH, 7, WHITE);
+  if (bar) display.fillRect(1, nowPlayingBarY + 2, bar, 3, WHITE);
+  display.drawFastVLine(1 + constrain(target, 0, barLength - 1), nowPlayingBarY - 2, 3, WHITE);
+  display.display();
+}
+
+//                -----------------------------------------------
+
+// AVRCP callbacks, on the bluetooth task
+
+// copy text from the phone, replacing each UTF-8 character the oled font does not have with '?'
+void copyMetadata(char *_dest, size_t _size, const uint8_t *_text) {
+  size_t n = 0;
+  for (; *_text && n < _size - 1; _text++) {
+    if (*_text < 0x80) _dest[n++] = *_text;
+    else if (*_text >= 0xC0) _dest[n++] = '?';          // lead byte; continuation bytes are skipped
+  }
+  _dest[n] = 0;
+}
+
+void avrcMetadata(uint8_t _id, const uint8_t *_text) {
+  char tText[sizeof(nowPlaying.title)];
+  copyMetadata(tText, sizeof(tText), _text);
+  uint32_t tNow = millis();
+
+  portENTER_CRITICAL(&nowPlayingLock);
+  char *field = NULL;
+  if (_id == ESP_AVRC_MD_ATTR_TITLE) field = nowPlaying.title;
+  if (_id == ESP_AVRC_MD_ATTR_ARTIST) field = nowPlaying.artist;
+  if (_id == ESP_AVRC_MD_ATTR_ALBUM) field = nowPlaying.album;
+  if (field && strcmp(field, tText) != 0) {
+    strcpy(field, tText);
+    if (_id == ESP_AVRC_MD_ATTR_TITLE) {                  // new track: start the position again
+      nowPlaying.positionMs = 0;
+      nowPlaying.positionTime = tNow;
     }
-    if (oledMenu.selectedMenuItem == 5) {
-      resetMenu();
-      displayMessage("IP Address", WiFi.localIP().toString());
+    nowPlaying.version++;
+    nowPlaying.changed = tNow;
+  }
+  if (_id == ESP_AVRC_MD_ATTR_PLAYING_TIME) {
+    uint32_t tDuration = strtoul(tText, NULL, 10);
+    if (tDuration != nowPlaying.durationMs) {
+      nowPlaying.durationMs = tDuration;
+      nowPlaying.version++;
+      nowPlaying.changed = tNow;
     }
-    oledMenu.selectedMenuItem = 0;
   }
+  portEXIT_CRITICAL(&nowPlayingLock);
+  uiPost(uiTrackEvent);
+}
 
-}  // menuActions
+// position now, from the last report; call with nowPlayingLock held
+uint32_t nowPlayingPosition() {
+  uint32_t tPos = nowPlaying.positionMs;
+  if (nowPlaying.playing) tPos += (unsigned long)(millis() - nowPlaying.positionTime);
+  if (nowPlaying.durationMs && tPos > nowPlaying.durationMs) tPos = nowPlaying.durationMs;
+  return tPos;
+}
+
+void avrcPlayStatus(esp_avrc_playback_stat_t _status) {
+  portENTER_CRITICAL(&nowPlayingLock);
+  nowPlaying.positionMs = nowPlayingPosition();           // freeze or restart the estimate from here
+  nowPlaying.positionTime = millis();
+  nowPlaying.playing = (_status == ESP_AVRC_PLAYBACK_PLAYING);
+  portEXIT_CRITICAL(&nowPlayingLock);
+  uiPost(uiTrackEvent);
+}
+
+void avrcPlayPosition(uint32_t _posMs) {
+  portENTER_CRITICAL(&nowPlayingLock);
+  nowPlaying.positionMs = _posMs;
+  nowPlaying.positionTime = millis();
+  portEXIT_CRITICAL(&nowPlayingLock);
+  uiPost(uiTrackEvent);
+}
+
+// the phone's volume (AVRCP absolute volume): the stream reader gets the pcm before the library would apply it,
+// so it goes to the audio path here, and phoneVolumeUpdate() takes it into the menu and eeprom
+void avrcVolume(int _volume) {
+  audioPathSetVolume(_volume);
+  phoneVolume = _volume;
+  phoneVolumeChanges++;
+  uiPost(uiStateEvent);
+}
+
+// called from loop(): the menu's copy follows the phone at once, eeprom once the phone has settled
+void phoneVolumeUpdate() {
+  static uint32_t tSeen = 0;
+  static uint32_t tChanged = 0;
+  static bool tUnsaved = false;
+  uint32_t tChanges = phoneVolumeChanges;
+  if (tChanges != tSeen) {
+    tSeen = tChanges;
+    volume = phoneVolume;
+    tChanged = millis();
+    tUnsaved = true;
+  }
+  if (tUnsaved && (unsigned long)(millis() - tChanged) >= phoneVolumeSaveMs) {
+    EEPROM.put(volumeAddr, volume);
+    EEPROM.commit();
+    tUnsaved = false;
+  }
+}
 
 //                -----------------------------------------------
 
-void volumeControl() {
-	resetMenu();							          // clear any previous menu
-	menuMode = value;						        // enable value entry
-	oledMenu.menuTitle = "Volume";		  // title (used to identify which number was entered)
-	oledMenu.mValueLow = 0;				      // minimum value allowed
-	oledMenu.mValueHigh = 100;			    // maximum value allowed
-	oledMenu.mValueStep = 1;				    // step size
-	oledMenu.mValueEntered = volume;		// starting value
-}
-
-void menuVolume() {
-	if (oledMenu.menuTitle == "Volume") {
-		volume = oledMenu.mValueEntered;
-		EEPROM.put(volumeAddr, volume);
-		EEPROM.commit();
-    a2dp_sink.set_volume(volume);
-		String tString = String(volume);
-		displayMessage("Entered", "\n\nVolume : " + tString);
-	}
+// now playing screen, runs until the button is pressed
+void nowPlayingDisplay() {
+  resetMenu();
+  menuMode = playing;
+  nowPlayingLayout.valid = false;             // lay out and draw everything on the next update
+}
+
+// shorten _text with "..." until it fits _width at the current text size
+String fitText(String _text, int _width) {
+  int16_t x1, y1;
+  uint16_t w, h;
+  display.getTextBounds(_text, 0, 0, &x1, &y1, &w, &h);
+  if ((int)w <= _width) return _text;
+  while (_text.length()) {
+    _text.remove(_text.length() - 1);
+    display.getTextBounds(_text + "...", 0, 0, &x1, &y1, &w, &h);
+    if ((int)w <= _width) break;
+  }
+  _text.trim();
+  return _text + "...";
+}
+
+void nowPlayingAddLine(String _text, int _y, int _size) {
+  if (nowPlayingLayout.lines >= nowPlayingMaxLines) return;
+  int i = nowPlayingLayout.lines++;
+  nowPlayingLayout.text[i] = _text;
+  nowPlayingLayout.x[i] = 0;
+  nowPlayingLayout.y[i] = _y;
+  nowPlayingLayout.size[i] = _size;
+}
+
+// line breaks and truncation for the current track; only runs when the metadata changes
+void nowPlayingLayoutText() {
+  char tTitle[sizeof(nowPlaying.title)], tArtist[sizeof(nowPlaying.artist)], tAlbum[sizeof(nowPlaying.album)];
+  portENTER_CRITICAL(&nowPlayingLock);
+  nowPlayingLayout.version = nowPlaying.version;
+  memcpy(tTitle, nowPlaying.title, sizeof(tTitle));
+  memcpy(tArtist, nowPlaying.artist, sizeof(tArtist));
+  memcpy(tAlbum, nowPlaying.album, sizeof(tAlbum));
+  portEXIT_CRITICAL(&nowPlayingLock);
+
+  nowPlayingLayout.lines = 0;
+  String title = tTitle;
+  if (title.length() == 0) title = a2dp_sink.is_connected() ? "Playing" : "Not connected";
+  int16_t x1, y1;
+  uint16_t w, h;
+  display.setTextWrap(false);                 // measure whole lines
+
+  // title: large if it fits on one line, otherwise two small lines broken at a space
+  display.setTextSize(2);
+  display.getTextBounds(title, 0, 0, &x1, &y1, &w, &h);
+  if (w <= SCREEN_WIDTH) {
+    nowPlayingAddLine(title, 0, 2);
+  } else {
+    display.setTextSize(1);
+    int split = title.length();
+    do {
+      display.getTextBounds(title.substring(0, split), 0, 0, &x1, &y1, &w, &h);
+      if (w <= SCREEN_WIDTH) break;
+      split--;
+    } while (split > 0);
+    int space = title.lastIndexOf(' ', split);
+    if (space > 0 && split < (int)title.length()) split = space;
+    nowPlayingAddLine(title.substring(0, split), 0, 1);
+    String rest = title.substring(split);
+    rest.trim();
+    nowPlayingAddLine(fitText(rest, SCREEN_WIDTH), lineSpace1, 1);
+  }
+
+  display.setTextSize(1);
+  if (tArtist[0]) nowPlayingAddLine(fitText(tArtist, SCREEN_WIDTH), topLine + 2, 1);
+  if (tAlbum[0]) nowPlayingAddLine(fitText(tAlbum, SCREEN_WIDTH), topLine + 2 + lineSpace1 + 2, 1);
+  display.setTextWrap(true);
+  nowPlayingLayout.valid = true;
+}
+
+String formatTime(uint32_t _seconds) {
+  String tSec = String(_seconds % 60);
+  return String(_seconds / 60) + ":" + (tSec.length() < 2 ? "0" : "") + tSec;
+}
+
+// progress bar and elapsed time; unless _full only what changed is redrawn
+void nowPlayingProgress(uint32_t _posMs, uint32_t _durationMs, bool _full) {
+  const int barLength = SCREEN_WIDTH - 2;     // inside the outline
+  int bar = _durationMs ? (uint64_t)_posMs * barLength / _durationMs : 0;
+  uint32_t second = _posMs / 1000;
+
+  if (_full || bar != nowPlayingLayout.barShown) {
+    int from = _full ? 0 : min(bar, nowPlayingLayout.barShown);
+    int to = _full ? barLength : max(bar, nowPlayingLayout.barShown);
+    display.fillRect(1 + from, nowPlayingBarY + 2, to - from, 3, BLACK);
+    if (bar > from) display.fillRect(1 + from, nowPlayingBarY + 2, bar - from, 3, WHITE);
+    nowPlayingLayout.barShown = bar;
+  }
+
+  if (_full || second != nowPlayingLayout.secondShown) {
+    String tTime = formatTime(second);
+    if (_durationMs) tTime += " / " + formatTime(_durationMs / 1000);
+    int16_t x1, y1;
+    uint16_t w, h;
+    display.setTextSize(1);
+    display.setTextColor(WHITE);
+    display.getTextBounds(tTime, 0, nowPlayingTimeY, &x1, &y1, &w, &h);
+    display.fillRect(0, nowPlayingTimeY, max((int)w, nowPlayingLayout.timeWidth), 8, BLACK);
+    display.setCursor(0, nowPlayingTimeY);
+    display.print(tTime);
+    nowPlayingLayout.secondShown = second;
+    nowPlayingLayout.timeWidth = w;
+  }
+}
+
+void nowPlayingUpdate() {
+  if (rotaryEncoder.reButtonPressed) {
+    defaultMenu();
+    return;
+  }
+  oledMenu.lastMenuActivity = millis();       // no timeout while the screen is showing
+  if (!uiFrameDue()) return;
+
+  portENTER_CRITICAL(&nowPlayingLock);
+  uint32_t tVersion = nowPlaying.version;
+  uint32_t tChanged = nowPlaying.changed;
+  uint32_t tDuration = nowPlaying.durationMs;
+  uint32_t tPos = nowPlayingPosition();
+  portEXIT_CRITICAL(&nowPlayingLock);
+
+  // a track change arrives as several attributes in a row, so wait for them to settle before laying out
+  bool relayout = !nowPlayingLayout.valid ||
+                  (tVersion != nowPlayingLayout.version && (unsigned long)(millis() - tChanged) >= nowPlayingSettleMs);
+  if (!relayout) {
+    nowPlayingProgress(tPos, tDuration, false);
+    display.display();                        // sends only the bytes that changed, usually none
+    return;
+  }
+
+  nowPlayingLayoutText();
+  display.clearDisplay();
+  display.setTextColor(WHITE);
+  for (int i = 0; i < nowPlayingLayout.lines; i++) {
+    display.setTextSize(nowPlayingLayout.size[i]);
+    display.setCursor(nowPlayingLayout.x[i], nowPlayingLayout.y[i]);
+    display.print(nowPlayingLayout.text[i]);
+  }
+  display.drawLine(0, topLine - 1, display.width(), topLine - 1, WHITE);
+  display.drawRect(0, nowPlayingBarY, SCREEN_WIDTH, 7, WHITE);
+  nowPlayingProgress(tPos, tDuration, true);
+  display.display();
 }
 
 
@@ -245,7 +880,10 @@ void reUpdateButton() {
 
 void menuUpdate() {
 
-  if (menuMode == off) return;    // if menu system is turned off do nothing more
+  if (menuMode == off) {          // if menu system is turned off do nothing more
+    if (nowPlaying.version != nowPlayingLayout.version) nowPlayingDisplay();    // unless a new track has started
+    return;
+  }
 
   // if no recent activity then turn oled off
     if ( (unsigned long)(millis() - oledMenu.lastMenuActivity) > (menuTimeout * 1000) ) {
@@ -265,7 +903,7 @@ void menuUpdate() {
       case value:
         serviceValue(0);
         if (rotaryEncoder.reButtonPressed) {                        // if the button has been pressed
-          menuVolume();                                             // a value has been entered so action it
+          menuValueEntered();                                       // a value has been entered so action it
           break;
         }
 
@@ -273,6 +911,21 @@ void menuUpdate() {
       case message:
         if (rotaryEncoder.reButtonPressed == 1) defaultMenu();    // if button has been pressed return to default menu
         break;
+
+      // if the spectrum analyser is showing
+      case spectrum:
+        spectrumUpdate();
+        break;
+
+      // if the now playing screen is showing
+      case playing:
+        nowPlayingUpdate();
+        break;
+
+      // if the loudness meter is showing
+      case meter:
+        meterUpdate();
+        break;
     }
 }
 
@@ -283,40 +936,48 @@ void menuUpdate() {
 
 void serviceMenu() {
 
-    // rotary encoder
-      if (rotaryEncoder.encoder0Pos >= itemTrigger) {
+    // rotary encoder: every step since the last pass, a burst of them wakes loop() only once
+      while (rotaryEncoder.encoder0Pos >= itemTrigger) {
         rotaryEncoder.encoder0Pos -= itemTrigger;
         oledMenu.highlightedMenuItem++;
         oledMenu.lastMenuActivity = millis();   // log time
+        uiDirty = true;
       }
-      if (rotaryEncoder.encoder0Pos <= -itemTrigger) {
+      while (rotaryEncoder.encoder0Pos <= -itemTrigger) {
         rotaryEncoder.encoder0Pos += itemTrigger;
         oledMenu.highlightedMenuItem--;
         oledMenu.lastMenuActivity = millis();   // log time
+        uiDirty = true;
       }
+    const menuDefs &tMenu = *oledMenu.activeMenu;
+    char tText[menuTextLength];
+
+    // verify valid highlighted item
+      if (oledMenu.highlightedMenuItem > tMenu.count) oledMenu.highlightedMenuItem = tMenu.count;
+      if (oledMenu.highlightedMenuItem < 1) oledMenu.highlightedMenuItem = 1;
+
       if (rotaryEncoder.reButtonPressed == 1) {
         oledMenu.selectedMenuItem = oledMenu.highlightedMenuItem;     // flag that the item has been selected
         oledMenu.lastMenuActivity = millis();   // log time
-        if (serialDebug) Serial.println("menu '" + oledMenu.menuTitle + "' item '" + oledMenu.menuItems[oledMenu.highlightedMenuItem] + "' selected");
+        if (serialDebug) Serial.printf("menu '%s' item '%s' selected\n", tMenu.title, tMenu.items[oledMenu.selectedMenuItem - 1].label);
       }
+    if (!uiFrameDue()) return;                  // nothing new to show, or drawn too recently
 
     const int _centreLine = displayMaxLines / 2 + 1;    // mid list point
     display.clearDisplay();
     display.setTextColor(WHITE);
 
-    // verify valid highlighted item
-      if (oledMenu.highlightedMenuItem > oledMenu.noOfmenuItems) oledMenu.highlightedMenuItem = oledMenu.noOfmenuItems;
-      if (oledMenu.highlightedMenuItem < 1) oledMenu.highlightedMenuItem = 1;
-
     // title
       display.setCursor(0, 0);
       if (menuLargeText) {
         display.setTextSize(2);
-        display.println(oledMenu.menuItems[oledMenu.highlightedMenuItem].substring(0, MaxmenuTitleLength));
+        menuItemText(tMenu.items[oledMenu.highlightedMenuItem - 1], tText, sizeof(tText));
+        tText[MaxmenuTitleLength] = 0;
+        display.println(tText);
       } else {
-        if (oledMenu.menuTitle.length() > MaxmenuTitleLength) display.setTextSize(1);
+        if (strlen(tMenu.title) > MaxmenuTitleLength) display.setTextSize(1);
         else display.setTextSize(2);
-        display.println(oledMenu.menuTitle);
+        display.println(tMenu.title);
       }
       display.drawLine(0, topLine-1, display.width(), topLine-1, WHITE);       // draw horizontal line under title
 
@@ -327,7 +988,10 @@ void serviceMenu() {
         int item = oledMenu.highlightedMenuItem - _centreLine + i;
         if (item == oledMenu.highlightedMenuItem) display.setTextColor(BLACK, WHITE);
         else display.setTextColor(WHITE);
-        if (item > 0 && item <= oledMenu.noOfmenuItems) display.println(oledMenu.menuItems[item]);
+        if (item > 0 && item <= tMenu.count) {
+          menuItemText(tMenu.items[item - 1], tText, sizeof(tText));
+          display.println(tText);
+        }
         else display.println(" ");
       }
 
@@ -356,16 +1020,18 @@ int serviceValue(bool _blocking) {
   uint32_t tTime;
 
   do {
-    // rotary encoder
-      if (rotaryEncoder.encoder0Pos >= itemTrigger) {
+    // rotary encoder: every step since the last pass, as in serviceMenu()
+      while (rotaryEncoder.encoder0Pos >= itemTrigger) {
         rotaryEncoder.encoder0Pos -= itemTrigger;
         oledMenu.mValueEntered-= oledMenu.mValueStep;
         oledMenu.lastMenuActivity = millis();   // log time
+        uiDirty = true;
       }
-      if (rotaryEncoder.encoder0Pos <= -itemTrigger) {
+      while (rotaryEncoder.encoder0Pos <= -itemTrigger) {
         rotaryEncoder.encoder0Pos += itemTrigger;
         oledMenu.mValueEntered+= oledMenu.mValueStep;
         oledMenu.lastMenuActivity = millis();   // log time
+        uiDirty = true;
       }
       if (oledMenu.mValueEntered < oledMenu.mValueLow) {
         oledMenu.mValueEntered = oledMenu.mValueLow;
@@ -375,15 +1041,16 @@ int serviceValue(bool _blocking) {
         oledMenu.mValueEntered = oledMenu.mValueHigh;
         oledMenu.lastMenuActivity = millis();   // log time
       }
+      if (!_blocking && !uiFrameDue()) break;   // nothing new to show, or drawn too recently
 
       display.clearDisplay();
       display.setTextColor(WHITE);
 
       // title
         display.setCursor(0, 0);
-        if (oledMenu.menuTitle.length() > MaxmenuTitleLength) display.setTextSize(1);
+        if (strlen(oledMenu.valueTitle) > MaxmenuTitleLength) display.setTextSize(1);
         else display.setTextSize(2);
-        display.println(oledMenu.menuTitle);
+        display.println(oledMenu.valueTitle);
         display.drawLine(0, topLine-1, display.width(), topLine-1, WHITE);       // draw horizontal line under title
 
       // value selected
@@ -455,11 +1122,13 @@ void resetMenu() {
     menuMode = off;
     oledMenu.selectedMenuItem = 0;
     rotaryEncoder.encoder0Pos = 0;
-    oledMenu.noOfmenuItems = 0;
-    oledMenu.menuTitle = "";
+    oledMenu.activeMenu = NULL;
+    oledMenu.editor = NULL;
+    oledMenu.valueTitle[0] = 0;
     oledMenu.highlightedMenuItem = 0;
     oledMenu.mValueEntered = 0;
     rotaryEncoder.reButtonPressed = 0;
+    uiDirty = true;
 
   oledMenu.lastMenuActivity = millis();   // log time
 
@@ -500,6 +1169,133 @@ void doEncoder() {
   // update previous readings
     rotaryEncoder.encoderPrevA = pinA;
     rotaryEncoder.encoderPrevB = pinB;
+
+  uiPostFromISR(uiEncoderEvent);
+}
+
+// button interrupt, wakes loop() so the press is debounced and acted on without polling
+void IRAM_ATTR doButton() {
+  uiPostFromISR(uiButtonEvent);
+}
+
+// ----------------------------------------------------------------
+//                        -web handlers
+// ----------------------------------------------------------------
+
+String equalizerJson() {
+  String json = "{\"sampleRate\":" + String(audioPathStats().sampleRate) + ",\"bands\":[";
+  for (int i = 0; i < EQ_MAX_BANDS; i++) {
+    EqBand band = audioPathEqualizer().band(i);
+    if (i) json += ",";
+    json += "{\"name\":\"" + String(eqBandNames[i]) + "\",\"type\":\"" + ParametricEQ::typeName(band.type) +
+            "\",\"enabled\":" + (band.enabled ? "true" : "false") +
+            ",\"freq\":" + String(band.freq, 1) + ",\"gain\":" + String(band.gainDb, 1) +
+            ",\"q\":" + String(band.q, 3) + "}";
+  }
+  return json + "]}";
+}
+
+// POST /eq  band=<0..4> and any of type, enabled, freq, gain, q;  or  flat=1
+void webEqualizer(AsyncWebServerRequest *request) {
+  if (request->hasParam("flat", true)) {
+    audioPathEqualizer().setFlat();
+    uiPost(uiStateEvent);                   // the eq menu may be showing the bands
+    request->send(200, "application/json", equalizerJson());
+    return;
+  }
+  if (!request->hasParam("band", true)) {
+    request->send(400, "text/plain", "band required");
+    return;
+  }
+  int index = request->getParam("band", true)->value().toInt();
+  if (index < 0 || index >= EQ_MAX_BANDS) {
+    request->send(400, "text/plain", "band out of range");
+    return;
+  }
+  EqBand band = audioPathEqualizer().band(index);
+  if (request->hasParam("type", true) &&
+      !ParametricEQ::typeFromName(request->getParam("type", true)->value().c_str(), band.type)) {
+    request->send(400, "text/plain", "type must be peak, lowshelf, highshelf, lowpass or highpass");
+    return;
+  }
+  if (request->hasParam("enabled", true)) band.enabled = request->getParam("enabled", true)->value().toInt() != 0;
+  if (request->hasParam("freq", true)) band.freq = request->getParam("freq", true)->value().toFloat();
+  if (request->hasParam("gain", true)) band.gainDb = request->getParam("gain", true)->value().toFloat();
+  if (request->hasParam("q", true)) band.q = request->getParam("q", true)->value().toFloat();
+  audioPathEqualizer().setBand(index, band);        // out of range values are clamped
+  uiPost(uiStateEvent);
+  request->send(200, "application/json", equalizerJson());
+}
+
+// browser side of /monitor: schedules each frame on a web audio clock, a little behind to ride out wifi jitter
+const char listenPage[] PROGMEM = R"rawliteral(<!DOCTYPE html><html><head><title>ESP32-Music monitor</title></head><body>
+<button id="go">Listen</button>
+<select id="dec"><option>1</option><option>2</option><option selected>4</option><option>8</option></select> decimation
+<label><input type="checkbox" id="mono"> mono</label>
+<p id="info"></p>
+<script>
+let ctx, ws, next = 0, last = -1, lost = 0;
+go.onclick = () => {
+  if (ws) return;
+  ctx = new AudioContext();
+  ws = new WebSocket('ws://' + location.host + '/monitor');
+  ws.binaryType = 'arraybuffer';
+  ws.onopen = () => { ws.send('decimation=' + dec.value); ws.send('mono=' + (mono.checked ? 1 : 0)); };
+  ws.onclose = () => { ws = null; info.textContent = 'closed'; };
+  ws.onmessage = (e) => {
+    const v = new DataView(e.data), seq = v.getUint32(0, true), rate = v.getUint32(4, true);
+    const frames = v.getUint16(8, true), ch = v.getUint8(10);
+    if (last >= 0 && seq != last + 1) lost += seq - last - 1;
+    last = seq;
+    const buf = ctx.createBuffer(ch, frames, rate);
+    for (let c = 0; c < ch; c++) {
+      const d = buf.getChannelData(c);
+      for (let i = 0; i < frames; i++) d[i] = v.getInt16(12 + 2 * (i * ch + c), true) / 32768;
+    }
+    const src = ctx.createBufferSource();
+    src.buffer = buf;
+    src.connect(ctx.destination);
+    if (next < ctx.currentTime) next = ctx.currentTime + 0.15;
+    src.start(next);
+    next += frames / rate;
+    info.textContent = rate + ' Hz, ' + ch + ' ch, ' + lost + ' frames lost';
+  };
+};
+dec.onchange = () => { if (ws) ws.send('decimation=' + dec.value); };
+mono.onchange = () => { if (ws) ws.send('mono=' + (mono.checked ? 1 : 0)); };
+</script></body></html>)rawliteral";
+
+// /monitor text messages  decimation=<1..8>  mono=<0|1>;  they apply to every listener, who all share the frames
+void monitorEvent(AsyncWebSocket *, AsyncWebSocketClient *, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  if (type != WS_EVT_DATA) return;
+  AwsFrameInfo *info = (AwsFrameInfo *)arg;
+  if (info->opcode != WS_TEXT || !info->final || info->index || info->len != len) return;
+  char command[24];
+  if (len >= sizeof(command)) return;
+  memcpy(command, data, len);
+  command[len] = 0;
+  if (!strncmp(command, "decimation=", 11)) audioPathMonitor().setDecimation(atoi(command + 11));
+  else if (!strncmp(command, "mono=", 5)) audioPathMonitor().setMono(atoi(command + 5) != 0);
+}
+
+// forward the frames the monitor tap has collected; one reference counted buffer per frame is
+// queued to every client, except those still behind with older frames, which miss this one
+void monitorUpdate() {
+  PcmMonitor &tap = audioPathMonitor();
+  const size_t listeners = monitorSocket.count();
+  if (tap.bypassed() != (listeners == 0)) tap.setBypass(listeners == 0);
+  size_t bytes;
+  while (const uint8_t *frame = tap.peek(bytes)) {
+    if (listeners) {
+      AsyncWebSocketMessageBuffer *buffer = monitorSocket.makeBuffer(bytes);
+      if (buffer && buffer->get()) {
+        memcpy(buffer->get(), frame, bytes);
+        monitorSkipped += listeners - monitorSocket.binaryAll(buffer, monitorMaxQueued);
+      }
+    }
+    tap.release();
+  }
+  monitorSocket.cleanupClients();
 }
 
 void connectToWifi() {
@@ -520,13 +1316,109 @@ void setup() {
 
   Serial.begin(115200); while (!Serial); delay(50);       // start serial comms
   Serial.println("\n\n\nStarting menu demo\n");
-	EEPROM.begin(1);
+	EEPROM.begin(3);
 	EEPROM.get(volumeAddr, volume);
+	EEPROM.get(loudnessAddr, loudnessOn);
+	EEPROM.get(normalizeAddr, normalizeOn);
   connectToWifi();
   server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
     	request->send(200, "text/plain", "Hi! I am ESP32. ESP32-Music\nVersion: " + String(version));
 	});
 
+  server.on("/audio", HTTP_GET, [](AsyncWebServerRequest *request) {
+      AudioPathStats stats = audioPathStats();
+      String json = "{\"capacity\":" + String(stats.ring.capacity) +
+                    ",\"fill\":" + String(stats.ring.fill) +
+                    ",\"highWater\":" + String(stats.ring.highWater) +
+                    ",\"underruns\":" + String(stats.ring.underruns) +
+                    ",\"overruns\":" + String(stats.ring.overruns) +
+                    ",\"droppedFrames\":" + String(stats.ring.droppedFrames) +
+                    ",\"psram\":" + String(stats.ring.psram ? "true" : "false") +
+                    ",\"sampleRate\":" + String(stats.sampleRate) +
+                    ",\"outputRate\":" + String(stats.outputRate) +
+                    ",\"outputBits\":" + String(audioPathOutput().bits()) +
+                    ",\"dither\":\"" + OutputFormat::ditherName(audioPathOutput().dither()) + "\"" +
+                    ",\"blocks\":" + String(stats.blocksWritten) +
+                    ",\"drift\":{\"ppm\":" + String(stats.driftPpm, 1) +
+                    ",\"correction\":" + String(stats.correctionPpm, 1) +
+                    ",\"latency\":" + String(stats.latencyMs, 1) +
+                    ",\"targetLatency\":" + String(stats.targetLatencyMs, 1) + "}" +
+                    ",\"power\":{\"state\":\"" + (stats.idle ? "idle" : "active") + "\"" +
+                    ",\"active\":" + String(stats.activeSeconds, 1) +
+                    ",\"idle\":" + String(stats.idleSeconds, 1) +
+                    ",\"idles\":" + String(stats.idleCount) + "}" +
+                    ",\"concealment\":{\"gaps\":" + String(stats.concealedGaps) +
+                    ",\"frames\":" + String(stats.concealedFrames) + "}" +
+                    ",\"meter\":{\"momentary\":" + String(audioPathMeter().momentary(), 1) +
+                    ",\"shortTerm\":" + String(audioPathMeter().shortTerm(), 1) +
+                    ",\"integrated\":" + String(audioPathMeter().integrated(), 1) +
+                    ",\"seconds\":" + String(audioPathMeter().integratedSeconds(), 1) +
+                    ",\"normalize\":" + String(audioPathNormalize() ? "true" : "false") +
+                    ",\"target\":" + String(audioPathNormalizeTarget(), 1) +
+                    ",\"gain\":" + String(audioPathNormalizeDb(), 2) + "}" +
+                    ",\"mix\":\"" + MixMatrix::presetName(audioPathMixer().preset()) + "\"" +
+                    ",\"room\":{\"enabled\":" + String(audioPathRoom().active() ? "true" : "false") +
+                    ",\"taps\":" + String(audioPathRoom().taps()) +
+                    ",\"activeTaps\":" + String(audioPathRoom().activeTaps()) +
+                    ",\"rate\":" + String(audioPathRoom().filterRate()) +
+                    ",\"load\":" + String(audioPathRoom().load(), 1) +
+                    ",\"late\":" + String(audioPathRoom().lateBlocks()) +
+                    ",\"fallbacks\":" + String(audioPathRoom().fallbacks()) + "}" +
+                    ",\"limiter\":{\"reduction\":" + String(audioPathLimiter().gainReductionDb(), 2) +
+                    ",\"peakReduction\":" + String(audioPathLimiter().peakReductionDb(), 2) +
+                    ",\"clamped\":" + String(audioPathLimiter().clampedSamples()) + "}" +
+                    ",\"display\":{\"frames\":" + String(display.displayFrames()) +
+                    ",\"bytes\":" + String(display.displayBytes()) +
+                    ",\"lastBytes\":" + String(display.lastDisplayBytes()) + "}" +
+                    ",\"monitor\":{\"listeners\":" + String(monitorSocket.count()) +
+                    ",\"dropped\":" + String(audioPathMonitor().droppedFrames()) +
+                    ",\"skipped\":" + String(monitorSkipped) + "}}";
+      request->send(200, "application/json", json);
+  });
+  server.on("/eq", HTTP_GET, [](AsyncWebServerRequest *request) {
+      request->send(200, "application/json", equalizerJson());
+  });
+  server.on("/eq", HTTP_POST, webEqualizer);
+  server.on("/meter", HTTP_POST, [](AsyncWebServerRequest *request) {
+      if (request->hasParam("target", true)) audioPathSetNormalizeTarget(request->getParam("target", true)->value().toFloat());
+      if (request->hasParam("normalize", true)) audioPathSetNormalize(request->getParam("normalize", true)->value().toInt() != 0);
+      if (request->hasParam("restart", true)) audioPathMeter().restart();
+      uiPost(uiStateEvent);
+      request->send(200, "text/plain", "OK");
+  });
+  server.on("/mix", HTTP_POST, [](AsyncWebServerRequest *request) {
+      MixPreset preset;
+      float g[4];
+      bool ok = false;
+      if (request->hasParam("preset", true)) {
+        ok = MixMatrix::presetFromName(request->getParam("preset", true)->value().c_str(), preset) &&
+             audioPathMixer().setPreset(preset);
+      } else if (request->hasParam("matrix", true)) {
+        ok = sscanf(request->getParam("matrix", true)->value().c_str(), "%f,%f,%f,%f", &g[0], &g[1], &g[2], &g[3]) == 4 &&
+             audioPathMixer().setMatrix(2, 2, g);
+      }
+      if (ok) request->send(200, "text/plain", "OK");
+      else request->send(400, "text/plain", "preset=stereo|mono|swap|crossfeed or matrix=LL,LR,RL,RR");
+  });
+  server.on("/room", HTTP_POST, [](AsyncWebServerRequest *request) {
+      if (request->hasParam("reload", true) && !audioPathLoadRoom(SPIFFS, roomFile)) {
+        request->send(400, "text/plain", "no usable impulse response in " + String(roomFile));
+        return;
+      }
+      if (request->hasParam("enabled", true)) audioPathSetRoom(request->getParam("enabled", true)->value().toInt() != 0);
+      request->send(200, "text/plain", "OK");
+  });
+  server.on("/listen", HTTP_GET, [](AsyncWebServerRequest *request) {
+      request->send_P(200, "text/html", listenPage);
+  });
+  monitorSocket.onEvent(monitorEvent);
+  server.addHandler(&monitorSocket);
+  server.on("/audio/reset", HTTP_POST, [](AsyncWebServerRequest *request) {
+      audioPathResetStats();
+      monitorSkipped = 0;
+      request->send(200, "text/plain", "OK");
+  });
+
 	AsyncElegantOTA.begin(&server);    // Start ElegantOTA
 	server.begin();
 	Serial.println("HTTP server started");
@@ -538,8 +1430,20 @@ void setup() {
         .data_in_num = I2S_PIN_NO_CHANGE
     };
     a2dp_sink.set_pin_config(pin_config);
+    a2dp_sink.set_avrc_metadata_attribute_mask(ESP_AVRC_MD_ATTR_TITLE | ESP_AVRC_MD_ATTR_ARTIST | ESP_AVRC_MD_ATTR_ALBUM | ESP_AVRC_MD_ATTR_PLAYING_TIME);
+    a2dp_sink.set_avrc_metadata_callback(avrcMetadata);
+    a2dp_sink.set_avrc_rn_playstatus_callback(avrcPlayStatus);
+    a2dp_sink.set_avrc_rn_play_pos_callback(avrcPlayPosition, nowPlayingPosInterval);
+    a2dp_sink.set_on_volumechange(avrcVolume);
+    if (!audioPathBegin(a2dp_sink, pin_config)) {     // decoded audio goes through the DSP chain to I2S
+      if (serialDebug) Serial.println("Error starting the audio output path");
+    }
     a2dp_sink.start("ESP-Music");
     a2dp_sink.set_volume(volume);
+    audioPathSetVolume(volume);
+    audioPathSetLoudness(loudnessOn == 1);      // erased flash reads 0xFF: off
+    audioPathSetNormalize(normalizeOn == 1);
+    if (SPIFFS.begin() && SPIFFS.exists(roomFile)) audioPathLoadRoom(SPIFFS, roomFile);     // uploaded with uploadfs
 
   pinMode(iLED, OUTPUT);     // onboard indicator led
 
@@ -560,7 +1464,9 @@ void setup() {
 
   // Interrupt for reading the rotary encoder position
     rotaryEncoder.encoder0Pos = 0;
+    uiEvents = xQueueCreate(uiQueueLength, sizeof(uint8_t));
     attachInterrupt(digitalPinToInterrupt(encoder0PinA), doEncoder, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(encoder0Press), doButton, CHANGE);
 
   //defaultMenu();       // start the default menu
 
@@ -577,8 +1483,12 @@ void setup() {
 
 void loop() {
 
+  uiWait();              // sleep until an event arrives or something is due
   reUpdateButton();      // update rotary encoder button status (if pressed activate default menu)
   menuUpdate();          // update or action the oled menu
+  phoneVolumeUpdate();   // keep the menu and eeprom volume in step with the phone
+  audioPathUpdate();     // apply equalizer changes from the menu or web page
+  monitorUpdate();       // send post-DSP pcm to /monitor listeners
 
  
 